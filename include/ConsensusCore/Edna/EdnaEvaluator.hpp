@@ -40,6 +40,8 @@
 #include <xmmintrin.h>
 #include <pmmintrin.h>
 
+#include <boost/shared_ptr.hpp>
+
 #include <algorithm>
 #include <cassert>
 #include <cfloat>
@@ -53,9 +55,11 @@
 #include <ConsensusCore/Features.hpp>
 #include <ConsensusCore/Read.hpp>
 #include <ConsensusCore/LFloat.hpp>
+#include <ConsensusCore/Mutation.hpp>
 #include <ConsensusCore/Types.hpp>
 #include <ConsensusCore/Utils.hpp>
 #include <ConsensusCore/Edna/EdnaConfig.hpp>
+#include <ConsensusCore/Quiver/detail/TemplateView.hpp>
 
 #ifndef SWIG
 using std::min;
@@ -78,14 +82,29 @@ namespace ConsensusCore
                       const std::string& tpl,
                       const std::vector<int> channelTpl,
                       const EdnaModelParams& params)
-            : features_(features),
-              params_(params),
+            : features_(new ChannelSequenceFeatures(features)),
+              params_(new EdnaModelParams(params)),
               tpl_(tpl),
-              channelTpl_(&(channelTpl[0]), tpl_.length()),
+              channelTpl_(new Feature<int>(&(channelTpl[0]), tpl.length())),
               pinStart_(true),
               pinEnd_(true)
         {}
 
+#ifndef SWIG
+        /// \brief An evaluator for base's template with the mutation
+        ///        m applied.  No storage is copied; m must outlive
+        ///        the new evaluator.  As with Template(tpl), the
+        ///        channel template is not remapped.
+        EdnaEvaluator(const EdnaEvaluator& base, const Mutation& m)
+            : features_(base.features_),
+              params_(base.params_),
+              tpl_(base.tpl_, m),
+              channelTpl_(base.channelTpl_),
+              pinStart_(base.pinStart_),
+              pinEnd_(base.pinEnd_)
+        {}
+#endif  // SWIG
+
         ~EdnaEvaluator()
         {}
 
@@ -96,27 +115,27 @@ namespace ConsensusCore
 
         std::string Basecalls() const
         {
-            return features_.Sequence();
+            return features_->Sequence();
         }
 
         std::string Template() const
         {
-            return tpl_;
+            return tpl_.ToString();
         }
 
         void Template(std::string tpl)
         {
-            tpl_ = tpl;
+            tpl_ = detail::TemplateView(tpl);
         }
 
         int ReadLength() const
         {
-            return features_.Length();
+            return features_->Length();
         }
 
         int TemplateLength() const
         {
-            return tpl_.length();
+            return tpl_.Length();
         }
 
         bool PinEnd() const
@@ -133,12 +152,12 @@ namespace ConsensusCore
         {
             assert(0 <= i && i < ReadLength());
             assert (0 <= j && j < TemplateLength());
-            return (features_.Channel[i] == channelTpl_[j]);
+            return (features_->Channel[i] == (*channelTpl_)[j]);
         }
 
         bool mergeable(int j) const
         {
-            if (j < TemplateLength() - 1 && channelTpl_[j] == channelTpl_[j+1])
+            if (j < TemplateLength() - 1 && (*channelTpl_)[j] == (*channelTpl_)[j+1])
                 return true;
 
             return false;
@@ -149,18 +168,18 @@ namespace ConsensusCore
             if ( j >= TemplateLength() )
                 return 1;
 
-            return channelTpl_[j];
+            return (*channelTpl_)[j];
         }
 
         float pStay(int j) const
         {
-            return params_.pStay_[templateBase(j)-1];
+            return params_->pStay_[templateBase(j)-1];
         }
 
         float pMerge(int j) const
         {
             if (mergeable(j))
-                return params_.pMerge_[templateBase(j)-1];
+                return params_->pMerge_[templateBase(j)-1];
 
             return 0.0;
         }
@@ -168,13 +187,13 @@ namespace ConsensusCore
         float moveDist(int obs, int j) const
         {
             int tplBase = templateBase(j) - 1;
-            return params_.moveDists_[tplBase*5 + obs];
+            return params_->moveDists_[tplBase*5 + obs];
         }
 
         float stayDist(int obs, int j) const
         {
             int tplBase = templateBase(j)  - 1;
-            return params_.stayDists_[tplBase*5 + obs];
+            return params_->stayDists_[tplBase*5 + obs];
         }
 
         float Inc(int i, int j) const
@@ -186,7 +205,7 @@ namespace ConsensusCore
             float pm = (1.0f - ps) * pMerge(j);
             float trans = 1.0f - ps - pm;
 
-            float em = moveDist(features_.Channel[i], j);
+            float em = moveDist(features_->Channel[i], j);
             return log(trans * em);
         }
 
@@ -215,7 +234,7 @@ namespace ConsensusCore
                    0 <= i && i < ReadLength() );
 
            float trans = pStay(j);
-           float em = stayDist(features_.Channel[i], j);
+           float em = stayDist(features_->Channel[i], j);
            return log(trans * em);
         }
 
@@ -223,8 +242,8 @@ namespace ConsensusCore
         {
             assert(0 <= j && j < TemplateLength() - 1 &&
                    0 <= i && i < ReadLength() );
-            if (!(features_.Channel[i] == channelTpl_[j] &&
-                  features_.Channel[i] == channelTpl_[j + 1]) )
+            if (!(features_->Channel[i] == (*channelTpl_)[j] &&
+                  features_->Channel[i] == (*channelTpl_)[j + 1]) )
             {
                 return -FLT_MAX;
             }
@@ -321,10 +340,10 @@ namespace ConsensusCore
         }
 
     protected:
-        ChannelSequenceFeatures features_;
-        EdnaModelParams params_;
-        std::string tpl_;
-        Feature<int> channelTpl_;
+        boost::shared_ptr<const ChannelSequenceFeatures> features_;
+        boost::shared_ptr<const EdnaModelParams> params_;
+        detail::TemplateView tpl_;
+        boost::shared_ptr<const Feature<int> > channelTpl_;
         bool pinStart_;
         bool pinEnd_;
     };
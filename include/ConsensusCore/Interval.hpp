@@ -99,7 +99,7 @@ namespace ConsensusCore {
     }
 
     inline Interval
-    RangeUnion(const std::vector<Interval> ranges)
+    RangeUnion(const std::vector<Interval>& ranges)
     {
         Interval result = Interval(INT_MAX/2, -INT_MAX/2);
         foreach (const Interval& r, ranges)
@@ -0,0 +1,97 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+#ifdef SWIG
+#error "IntervalIndex.hpp is not an API-facing header!"
+#endif  // SWIG
+
+#include <vector>
+
+#include <ConsensusCore/Interval.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+    /// \brief A static index over a set of half-open intervals,
+    ///        answering overlap queries in O(log n + k) time.
+    ///
+    /// The intervals are stored sorted by start, in an array that
+    /// doubles as an implicit balanced binary search tree: the node
+    /// at level k sits at an index whose low k bits are all ones, and
+    /// each node records the maximum end in its subtree.  (This is
+    /// the layout of Heng Li's cgranges.)
+    ///
+    /// The index does not track changes to the intervals it was
+    /// built from; call Build again after they move.
+    class IntervalIndex
+    {
+    public:
+        IntervalIndex();
+
+        /// Index intervals[i] under the id i, replacing the contents.
+        void Build(const std::vector<Interval>& intervals);
+
+        /// Append to *ids, in increasing order, the ids of the
+        /// intervals overlapping [begin, end).
+        void FindOverlapping(int begin, int end, std::vector<int>* ids) const;
+
+        int Size() const;
+
+    private:
+        struct Node
+        {
+            int Begin;
+            int End;
+            int MaxEnd;  // over the subtree rooted here
+            int Id;
+        };
+
+        struct NodeOrder
+        {
+            bool operator()(const Node& a, const Node& b) const
+            {
+                return a.Begin < b.Begin || (a.Begin == b.Begin && a.Id < b.Id);
+            }
+        };
+
+        std::vector<Node> nodes_;
+        int rootLevel_;
+    };
+}
+}
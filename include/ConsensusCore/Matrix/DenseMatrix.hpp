@@ -67,6 +67,10 @@ namespace ConsensusCore {
         DenseMatrix(int rows, int cols);
         ~DenseMatrix();
 
+    public:  // Storage reuse
+        // Reshape to rows x cols and clear every entry
+        void Reset(int rows, int cols);
+
     public:  // Nullability
         static const DenseMatrix& Null();
         bool IsNull() const;
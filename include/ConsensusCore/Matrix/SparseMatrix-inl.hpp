@@ -80,6 +80,27 @@ namespace ConsensusCore {
         return nCols_;
     }
 
+    //
+    // Band geometry
+    //
+    inline int
+    SparseMatrix::AlignedBegin(int beginRow) const
+    {
+        return max(beginRow - BAND_PADDING, 0) & ~3;
+    }
+
+    inline int
+    SparseMatrix::AlignedEnd(int endRow) const
+    {
+        return min((endRow + BAND_PADDING + 3) & ~3, nRows_);
+    }
+
+    inline int
+    SparseMatrix::BandEntries(int beginRow, int endRow)
+    {
+        return (endRow - beginRow + 3) & ~3;
+    }
+
     //
     // Entry range queries per column
     //
@@ -87,13 +108,9 @@ namespace ConsensusCore {
     SparseMatrix::StartEditingColumn(int j, int hintBegin, int hintEnd)
     {
         assert(columnBeingEdited_ == -1);
+        assert(0 <= hintBegin && hintBegin <= hintEnd && hintEnd <= nRows_);
         columnBeingEdited_ = j;
-        if (columns_[j] != NULL)
-        {
-            columns_[j]->ResetForRange(hintBegin, hintEnd);
-        } else {
-            columns_[j] = new SparseVector(Rows(), hintBegin, hintEnd);
-        }
+        AllocateColumn(j, hintBegin, hintEnd);
     }
 
     inline void
@@ -126,20 +143,21 @@ namespace ConsensusCore {
     SparseMatrix::operator() (int i, int j) const
     {
         static const float emptyCell = Zero<lfloat>();
-        if (columns_[j] == NULL)
+        const ColumnBand& band = bands_[j];
+        if (band.Begin <= i && i < band.End)
         {
-            return emptyCell;
+            return arena_[band.Offset + (i - band.Begin)];
         }
         else
         {
-            return (*columns_[j])(i);
+            return emptyCell;
         }
     }
 
     inline bool
     SparseMatrix::IsAllocated(int i, int j) const
     {
-        return columns_[j] != NULL && columns_[j]->IsAllocated(i);
+        return bands_[j].Begin <= i && i < bands_[j].End;
     }
 
     inline float
@@ -152,14 +170,23 @@ namespace ConsensusCore {
     SparseMatrix::Set(int i, int j, float v)
     {
         assert(columnBeingEdited_ == j);
-        columns_[j]->Set(i, v);
+        assert(0 <= i && i < nRows_);
+        if (!IsAllocated(i, j))
+        {
+            ExpandColumn(j, i, i + 1);
+        }
+        const ColumnBand& band = bands_[j];
+        arena_[band.Offset + (i - band.Begin)] = v;
     }
 
     inline void
     SparseMatrix::ClearColumn(int j)
     {
+        const ColumnBand& band = bands_[j];
         usedRanges_[j] = Interval(0, 0);
-        columns_[j]->Clear();
+        std::fill(arena_ + band.Offset,
+                  arena_ + band.Offset + (band.End - band.Begin),
+                  Zero<lfloat>());
         DEBUG_ONLY(CheckInvariants(j);)
     }
 
@@ -169,13 +196,20 @@ namespace ConsensusCore {
     inline __m128
     SparseMatrix::Get4(int i, int j) const
     {
-        if (columns_[j] == NULL)
+        assert(0 <= i && i + 4 <= nRows_);
+        const ColumnBand& band = bands_[j];
+        if (band.Begin <= i && i + 4 <= band.End)
+        {
+            // Aligned whenever i is a multiple of four
+            return _mm_loadu_ps(arena_ + band.Offset + (i - band.Begin));
+        }
+        else if (i >= band.End || i + 4 <= band.Begin)
         {
             return Zero4<lfloat>();
         }
         else
         {
-            return columns_[j]->Get4(i);
+            return _mm_set_ps(Get(i + 3, j), Get(i + 2, j), Get(i + 1, j), Get(i, j));
         }
     }
 
@@ -183,6 +217,12 @@ namespace ConsensusCore {
     SparseMatrix::Set4(int i, int j, __m128 v4)
     {
         assert(columnBeingEdited_ == j);
-        columns_[j]->Set4(i, v4);
+        assert(0 <= i && i + 4 <= nRows_);
+        if (!(bands_[j].Begin <= i && i + 4 <= bands_[j].End))
+        {
+            ExpandColumn(j, i, i + 4);
+        }
+        const ColumnBand& band = bands_[j];
+        _mm_storeu_ps(arena_ + band.Offset + (i - band.Begin), v4);
     }
 }
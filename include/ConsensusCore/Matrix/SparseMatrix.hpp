@@ -43,12 +43,25 @@
 
 #include <ConsensusCore/Interval.hpp>
 #include <ConsensusCore/Matrix/AbstractMatrix.hpp>
-#include <ConsensusCore/Matrix/SparseVector.hpp>
 #include <ConsensusCore/Types.hpp>
 #include <ConsensusCore/Utils.hpp>
 
 namespace ConsensusCore {
 
+    //
+    // Banded matrix, stored by column.  The allocated band of every
+    // column lives in a single contiguous arena, addressed by a
+    // per-column offset and row range (CSC-like, with dense bands).
+    // Bands begin on a row that is a multiple of four, at a 16-byte
+    // aligned arena offset, so that Get4/Set4 at such rows touch
+    // aligned storage.
+    //
+    // Columns are bump-allocated from the arena.  A column that
+    // outgrows its slot moves to the end of the arena; the slots left
+    // behind are reclaimed when the arena is next compacted.  Reset
+    // reshapes the matrix while keeping the arena, so a matrix can be
+    // refilled repeatedly without allocating.
+    //
     class SparseMatrix : public AbstractMatrix
     {
     public:  // Constructor, destructor
@@ -56,6 +69,14 @@ namespace ConsensusCore {
         SparseMatrix(const SparseMatrix& other);
         ~SparseMatrix();
 
+    public:  // Storage reuse
+        // Reshape to rows x cols and clear every entry, keeping the
+        // arena for reuse rather than freeing it.
+        void Reset(int rows, int cols);
+
+        // Ensure the arena can hold at least this many entries.
+        void Reserve(int entries);
+
     public:  // Nullability
         static const SparseMatrix& Null();
         bool IsNull() const;
@@ -89,10 +110,51 @@ namespace ConsensusCore {
         void ToHostMatrix(float** mat, int* rows, int* cols) const;
 
     private:
+        SparseMatrix& operator=(const SparseMatrix& other);  // not implemented
+
         void CheckInvariants(int column) const;
 
     private:
-        std::vector<SparseVector*> columns_;
+        // rows of padding allocated around the requested range
+        static const int BAND_PADDING = 8;
+
+        // The allocated rows [Begin, End) of a column, stored at
+        // arena_[Offset, Offset + Capacity).
+        struct ColumnBand
+        {
+            int Offset;
+            int Capacity;
+            int Begin;
+            int End;
+
+            ColumnBand() : Offset(0), Capacity(0), Begin(0), End(0) {}
+        };
+
+        // Give column j a fresh band covering [beginRow, endRow)
+        // plus padding.  Destructive.
+        void AllocateColumn(int j, int beginRow, int endRow);
+
+        // Widen the band of column j to cover [beginRow, endRow),
+        // preserving its contents.
+        void ExpandColumn(int j, int beginRow, int endRow);
+
+        // Bump-allocate n entries from the arena, compacting or
+        // growing it when it is full; returns the offset.
+        int AllocateEntries(int n);
+
+        // Move the live bands, compacted, into a new arena
+        void Rebuild(int capacity);
+
+        int AlignedBegin(int beginRow) const;
+        int AlignedEnd(int endRow) const;
+        static int BandEntries(int beginRow, int endRow);
+
+    private:
+        std::vector<ColumnBand> bands_;
+        float* arena_;
+        int arenaCapacity_;
+        int arenaUsed_;
+        int liveEntries_;
         int nCols_;
         int nRows_;
         int columnBeingEdited_;
@@ -130,7 +130,7 @@ namespace ConsensusCore {
         return end_;
     }
 
-    inline std::string
+    inline const std::string&
     Mutation::NewBases() const
     {
         return newBases_;
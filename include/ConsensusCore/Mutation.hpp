@@ -88,7 +88,7 @@ namespace ConsensusCore
         int Start() const;
         int End() const;
 
-        std::string NewBases() const;
+        const std::string& NewBases() const;
         int LengthDiff() const;
         std::string ToString() const;
 
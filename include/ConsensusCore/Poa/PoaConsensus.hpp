@@ -68,7 +68,7 @@ namespace ConsensusCore
                      const std::vector<PoaGraph::Vertex>& ConsensusPath);
 
         // NB: this constructor exists to provide a means to avoid an unnecessary copy of the
-        // boost graph.  If we had move semantics (C++11) we would be able to get by without
+        // POA graph.  If we had move semantics (C++11) we would be able to get by without
         // this.
         PoaConsensus(const std::string& css,
                      const detail::PoaGraphImpl& g,
@@ -78,13 +78,18 @@ namespace ConsensusCore
 
         static const PoaConsensus* FindConsensus(const std::vector<std::string>& reads);
 
+        // With useKmerRangeFinder, each read is banded about the
+        // k-mer anchors it shares with the consensus so far (see
+        // KmerRangeFinder); otherwise AddRead's default banding is used.
         static const PoaConsensus* FindConsensus(const std::vector<std::string>& reads,
                                                  const AlignConfig& config,
-                                                 int minCoverage=-INT_MAX);
+                                                 int minCoverage=-INT_MAX,
+                                                 bool useKmerRangeFinder=false);
 
         static const PoaConsensus* FindConsensus(const std::vector<std::string>& reads,
                                                  AlignMode mode,
-                                                 int minCoverage=-INT_MAX);
+                                                 int minCoverage=-INT_MAX,
+                                                 bool useKmerRangeFinder=false);
 
     public:
         // Additional accessors, which do things on the graph/graphImpl
@@ -84,6 +84,10 @@ namespace ConsensusCore
         //
         // Easy API
         //
+
+        // AddRead keeps the storage of its alignment for the next read
+        // to reuse, so the graph holds enough for the largest alignment
+        // so far until FindConsensus releases it.
         void AddRead(const std::string& sequence,
                      const AlignConfig& config,
                      detail::SdpRangeFinder* rangeFinder=NULL,
@@ -105,6 +109,12 @@ namespace ConsensusCore
 
         size_t NumReads() const;
 
+        // Reads are aligned to the graph by an SSE2 kernel wherever
+        // the scores fit in its 16-bit lanes, unless this is turned
+        // off; the results are identical either way.
+        bool VectorizedAlignment() const;
+        void VectorizedAlignment(bool enable);
+
         std::string ToGraphViz(int flags = 0,
                                const PoaConsensus* pc = NULL) const;
 
@@ -4,7 +4,6 @@
 #include <ConsensusCore/Interval.hpp>
 
 #include <cstddef>
-#include <map>
 #include <string>
 #include <vector>
 #include <utility>
@@ -36,7 +35,7 @@ namespace detail {
     class SdpRangeFinder
     {
     private:
-        std::map<PoaGraph::Vertex, Interval> alignableReadIntervalByVertex_;
+        std::vector<Interval> alignableReadIntervalByVertex_;  // by vertex id
 
     public:
         virtual ~SdpRangeFinder();
@@ -51,6 +50,46 @@ namespace detail {
     protected:
         virtual SdpAnchorVector FindAnchors(const std::string& consensusSequence,
                                             const std::string& readSequence) = 0;
+
+        // How far either side of an anchor's read position the range
+        // of the anchored vertex extends
+        virtual int AnchorRangeWidth(int readLength) const;
+    };
+
+    //
+    // The range finder PoaGraph uses for GLOBAL alignment when the
+    // client supplies none: every consensus position is anchored on
+    // the diagonal (scaled to the read length), with a range wide
+    // enough to absorb the indel drift of a noisy read.
+    //
+    class DiagonalRangeFinder : public SdpRangeFinder
+    {
+    protected:
+        virtual SdpAnchorVector FindAnchors(const std::string& consensusSequence,
+                                            const std::string& readSequence);
+
+        virtual int AnchorRangeWidth(int readLength) const;
+    };
+
+    //
+    // A self-contained range finder: exact k-mer matches between the
+    // consensus and the read (ignoring k-mers repeated many times in
+    // the consensus) are chained by sparse dynamic programming, and
+    // the seeds of the best colinear chain are the anchors.  A read
+    // with no convincing chain gets no anchors, so it is aligned
+    // without bands.
+    //
+    class KmerRangeFinder : public SdpRangeFinder
+    {
+    public:
+        explicit KmerRangeFinder(int kmerSize = 12);
+
+    protected:
+        virtual SdpAnchorVector FindAnchors(const std::string& consensusSequence,
+                                            const std::string& readSequence);
+
+    private:
+        int kmerSize_;
     };
 
 }}
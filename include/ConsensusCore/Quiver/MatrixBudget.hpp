@@ -0,0 +1,97 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ConsensusCore
+{
+    // What an eviction policy is told about a read holding matrices
+    struct ReadMatrixUsage
+    {
+        int ReadIndex;
+        int AllocatedEntries;  // alpha plus beta
+        int TemplateSpan;      // template positions the read is mapped to
+        float Score;           // the read's baseline score
+        int LastUse;           // larger is more recent
+    };
+
+    // Chooses which reads give up their alpha/beta matrices when a
+    // MultiReadMutationScorer goes over its matrix memory budget, and
+    // what becomes of them.
+    class AbstractEvictionPolicy
+    {
+    public:
+        virtual ~AbstractEvictionPolicy() {}
+
+        // Do evicted reads keep taking part, their matrices recomputed
+        // when next needed, or are they deactivated for good?
+        virtual bool RecomputesMatrices() const = 0;
+
+        // Order the candidates for eviction, first to go first.
+        virtual void Rank(std::vector<ReadMatrixUsage>* candidates) const = 0;
+    };
+
+    // Deactivates the reads mapped to the fewest template positions,
+    // which inform the fewest mutations; the larger matrices go
+    // first among reads of equal span.  The default policy.
+    class DeactivateLeastInformativeReads : public AbstractEvictionPolicy
+    {
+    public:
+        bool RecomputesMatrices() const;
+        void Rank(std::vector<ReadMatrixUsage>* candidates) const;
+    };
+
+    // Drops the matrices of the reads least recently used, to be
+    // recomputed when a mutation next needs them.  Memory for time:
+    // each recomputation costs as much as adding the read.
+    class RecomputeLeastRecentlyUsed : public AbstractEvictionPolicy
+    {
+    public:
+        bool RecomputesMatrices() const;
+        void Rank(std::vector<ReadMatrixUsage>* candidates) const;
+    };
+
+    // The matrix memory budget, in bytes, of each
+    // MultiReadMutationScorer constructed afterwards; 0, the initial
+    // setting, means no budget.  Set it before starting any threads
+    // that construct scorers.
+    void DefaultMatrixMemoryBudget(size_t bytes);
+    size_t DefaultMatrixMemoryBudget();
+}
@@ -37,9 +37,12 @@
 
 #pragma once
 
+#include <ConsensusCore/IntervalIndex.hpp>
 #include <ConsensusCore/Types.hpp>
 #include <ConsensusCore/Read.hpp>
 #include <ConsensusCore/Matrix/AbstractMatrix.hpp>
+#include <ConsensusCore/Quiver/MatrixBudget.hpp>
+#include <ConsensusCore/Quiver/MutationScoreCache.hpp>
 #include <ConsensusCore/Quiver/MutationScorer.hpp>
 #include <ConsensusCore/Quiver/QuiverConfig.hpp>
 #include <ConsensusCore/Quiver/SseRecursor.hpp>
@@ -75,6 +78,9 @@ namespace ConsensusCore {
         // must be provided with (0-based) template start/end coordinates.
         virtual bool AddRead(const MappedRead& mappedRead, float threshold) = 0;
         virtual bool AddRead(const MappedRead& mappedRead) = 0;
+        // Add reads as AddRead would, one after the other, returning
+        // the number of them that are active
+        virtual int AddReads(const std::vector<MappedRead>& mappedReads) = 0;
 
         virtual float Score(const Mutation& m) const = 0;
         virtual float FastScore(const Mutation& m) const = 0;
@@ -91,13 +97,69 @@ namespace ConsensusCore {
         virtual bool IsFavorable(const Mutation& m) const = 0;
         virtual bool FastIsFavorable(const Mutation& m) const = 0;
 
+        // The candidates accepted by FastIsFavorable, each with its
+        // Score, in candidate order.  With numThreads > 1 the
+        // candidates are screened concurrently by that many workers,
+        // with the same result as screening serially.  Given a cache,
+        // candidates are screened by their FastScore, which is the
+        // Score of a favorable one; cached scores are used, and the
+        // rest are computed and cached.
+        virtual std::vector<ScoredMutation>
+        FavorableMutations(const std::vector<Mutation>& candidates,
+                           int numThreads = 1,
+                           MutationScoreCache* cache = NULL) const = 0;
+
+        // FastScore of each mutation, identical to calling FastScore
+        // on each, but computed read by read over blocks of adjacent
+        // mutations, numThreads blocks at a time.  Mutations sorted by
+        // position make for compact blocks; this is how the consensus
+        // QVs are computed.  Given a cache, only the mutations missing
+        // from it are scored, and their scores are added to it.
+        virtual std::vector<float>
+        FastScoreMutations(const std::vector<Mutation>& mutations,
+                           int numThreads = 1,
+                           MutationScoreCache* cache = NULL) const = 0;
+
+        // Score a batch of mutations in a single pass over the reads.
+        // Returns the per-mutation totals, identical to calling
+        // Score(m) on each mutation.
+        virtual std::vector<float>
+        ScoreMutations(const std::vector<Mutation>& mutations) const = 0;
+
+        // As above, additionally returning the dense, row-major
+        // (NumReads x mutations.size()) matrix of per-read score
+        // differences in *readScores, with unscoredValue where a read
+        // does not score a mutation.  The matrix is allocated with
+        // malloc and owned by the caller.
+        virtual std::vector<float>
+        ScoreMutations(const std::vector<Mutation>& mutations,
+                       float unscoredValue,
+                       float** readScores, int* numReads, int* numMutations) const = 0;
+
         // Rough estimate of memory consumption of scoring machinery
         virtual std::vector<int> AllocatedMatrixEntries() const = 0;
         virtual std::vector<int> UsedMatrixEntries() const = 0;
+        virtual std::vector<int> AllocatedMoveTableEntries() const = 0;
         virtual const AbstractMatrix* AlphaMatrix(int i) const = 0;
         virtual const AbstractMatrix* BetaMatrix(int i) const = 0;
+
+        // Passes beyond the first two each read's latest alpha/beta
+        // fill took; -1 for a read dropped because its alpha and beta
+        // could not be mated, when it was added or after a template
+        // change, and 0 for other reads without matrices.
         virtual std::vector<int> NumFlipFlops() const = 0;
 
+        // Number of threads used to fan out per-read scoring and
+        // refilling work.  1 (the default) means everything runs
+        // serially on the calling thread.
+        virtual int NumThreads() const = 0;
+        virtual void NumThreads(int numThreads) = 0;
+
+        // Whether reads subsequently added get precomputed move-score
+        // tables (see QvEvaluator).  Off by default.
+        virtual bool MoveTables() const = 0;
+        virtual void MoveTables(bool moveTables) = 0;
+
 #if !defined(SWIG) || defined(SWIGCSHARP)
         // Alternate entry points for C# code, not requiring zillions of object
         // allocations.
@@ -125,12 +187,37 @@ namespace ConsensusCore {
 
 
     namespace detail {
+        template<typename MMS>
+        class ScreenMutationsTask;
+
+        template<typename MMS>
+        class FastScoreMutationsTask;
+
+        template<typename MMS, typename ReadStateType>
+        class BuildScorersTask;
+
         template<typename ScorerType>
         struct ReadState
         {
             MappedRead* Read;
             ScorerType* Scorer;
             bool IsActive;
+            // Wall-clock seconds spent constructing Scorer (or finding
+            // the read unusable)
+            float ConstructionTime;
+            // A pending read is to have its Scorer built, with
+            // AddThreshold, when next used: it was added lazily, or
+            // its matrices were evicted.  Pending reads count as
+            // active.  An evicted read keeps its baseline score in
+            // CachedScore until the template under it changes.
+            bool IsPending;
+            float AddThreshold;
+            // The latest attempt to build Scorer found that alpha and
+            // beta could not be mated
+            bool AlphaBetaMismatch;
+            bool HasCachedScore;
+            float CachedScore;
+            int LastUse;
 
             ReadState(MappedRead* read,
                       ScorerType* scorer,
@@ -149,6 +236,7 @@ namespace ConsensusCore {
     public:
         typedef R                                         RecursorType;
         typedef typename R::EvaluatorType                 EvaluatorType;
+        typedef typename R::MatrixType                    MatrixType;
         typedef typename ConsensusCore::MutationScorer<R> ScorerType;
         typedef typename detail::ReadState<ScorerType>    ReadStateType;
 
@@ -171,6 +259,11 @@ namespace ConsensusCore {
         bool AddRead(const MappedRead& mappedRead, float threshold);
         bool AddRead(const MappedRead& mappedRead);
 
+        // Bulk AddRead, each read taking its chemistry's AddThreshold.
+        // The scorers are constructed concurrently, in contiguous
+        // blocks of reads, when NumThreads() > 1.
+        int AddReads(const std::vector<MappedRead>& mappedReads);
+
         float Score(const Mutation& m) const;
         float FastScore(const Mutation& m) const;
 
@@ -189,13 +282,98 @@ namespace ConsensusCore {
         bool IsFavorable(const Mutation& m) const;
         bool FastIsFavorable(const Mutation& m) const;
 
-        // Rough estimate of memory consumption of scoring machinery
+        // Candidate screening.  With numThreads > 1, contiguous blocks
+        // of candidates go to a pool of that many threads, each
+        // scoring against the unchanging template with its own
+        // scratch extend buffer; the reads' own thread pool is not
+        // used.  Otherwise this is FastIsFavorable then Score on each
+        // candidate.
+        std::vector<ScoredMutation> FavorableMutations(const std::vector<Mutation>& candidates,
+                                                       int numThreads = 1,
+                                                       MutationScoreCache* cache = NULL) const;
+
+        // Block-wise FastScore.  The reads overlapping a block are
+        // found once, and each scores all of the block's mutations
+        // whose sums are not yet cut short before the next read is
+        // taken, keeping its alpha/beta matrices in cache.  As in
+        // FavorableMutations, blocks go to a pool of numThreads
+        // threads if numThreads > 1.
+        std::vector<float> FastScoreMutations(const std::vector<Mutation>& mutations,
+                                              int numThreads = 1,
+                                              MutationScoreCache* cache = NULL) const;
+
+        // Batch scoring.  The loop is read-major: each read scores all
+        // of the mutations before moving on to the next read, keeping
+        // its alpha/beta matrices in cache.
+        std::vector<float> ScoreMutations(const std::vector<Mutation>& mutations) const;
+        std::vector<float> ScoreMutations(const std::vector<Mutation>& mutations,
+                                          float unscoredValue,
+                                          float** readScores,
+                                          int* numReads,
+                                          int* numMutations) const;
+
+        // Rough estimate of memory consumption of scoring machinery.
+        // Reads holding no matrices---rejected by the AddThreshold,
+        // evicted, or not yet built---have no entries.  AlphaMatrix
+        // and BetaMatrix build a pending read's matrices; the pointers
+        // last until the next call that could evict them.
         std::vector<int> AllocatedMatrixEntries() const;
         std::vector<int> UsedMatrixEntries() const;
+        std::vector<int> AllocatedMoveTableEntries() const;
         const AbstractMatrix* AlphaMatrix(int i) const;
         const AbstractMatrix* BetaMatrix(int i) const;
         std::vector<int> NumFlipFlops() const;
 
+        // The most matrix entries held at once, as sampled whenever
+        // scorers are built or refilled
+        size_t PeakAllocatedMatrixEntries() const;
+
+        // Opt-in bound on the memory, in bytes, of the alpha/beta
+        // matrices (DefaultMatrixMemoryBudget() initially; 0 for no
+        // bound).  Whenever building or refilling scorers takes the
+        // matrices over budget, reads are evicted as the policy
+        // (which must outlive the scorer) chooses until they fit.
+        // When the policy recomputes matrices, mutations are screened
+        // a few blocks at a time, so that only the reads near each
+        // block need their matrices, and the reads in use are never
+        // evicted; a call needing more reads than the budget holds
+        // goes over it until the next eviction.  Such a policy makes
+        // the const scoring methods (Score, FastScore, Scores, ...)
+        // evict and rebuild scorers, so they are then no longer safe
+        // to call concurrently on one scorer.
+        size_t MatrixMemoryBudget() const;
+        void MatrixMemoryBudget(size_t bytes);
+        void MatrixMemoryBudget(size_t bytes, const AbstractEvictionPolicy& policy);
+
+        // Opt-in multithreading.  When NumThreads() > 1, reads are
+        // partitioned into contiguous blocks that are scored (or
+        // refilled, in ApplyMutations) concurrently; per-read results
+        // are then reduced in read order on the calling thread, so
+        // scores are bit-identical to the serial computation.
+        int NumThreads() const;
+        void NumThreads(int numThreads);
+
+        // Opt-in precomputed move scores: trades 16 floats per read
+        // base (reported by AllocatedMoveTableEntries) for cheaper
+        // fills.  Applies to reads added after the call.
+        bool MoveTables() const;
+        void MoveTables(bool moveTables);
+
+        // Opt-in lazy construction: the scorers (and so the alpha/beta
+        // matrices) of reads added after the call are not built until
+        // a mutation near the reads is next scored, and then all
+        // together, as in AddReads.  Until then AddRead(s) and Read
+        // count every read as active.  Applies to reads added after
+        // the call.  While any read is unbuilt, the const scoring
+        // methods build scorers, so they are not safe to call
+        // concurrently on one scorer.
+        bool LazyAlphaBeta() const;
+        void LazyAlphaBeta(bool lazyAlphaBeta);
+
+        // Seconds spent constructing each read's scorer; 0 for reads
+        // not yet built
+        std::vector<float> ConstructionTimes() const;
+
 #if !defined(SWIG) || defined(SWIGCSHARP)
         // Alternate entry points for C# code, not requiring zillions of object
         // allocations.
@@ -221,14 +399,109 @@ namespace ConsensusCore {
         std::string ToString() const;
 
     private:
+        friend class detail::ScreenMutationsTask<MultiReadMutationScorer<R> >;
+        friend class detail::FastScoreMutationsTask<MultiReadMutationScorer<R> >;
+        friend class detail::BuildScorersTask<MultiReadMutationScorer<R>, ReadStateType>;
+
         void CheckInvariants() const;
 
+        // Rebuild readIndex_ if reads were added or moved since it
+        // was last built.
+        void UpdateReadIndex() const;
+
+        // A scorer for the read against the current template, or NULL
+        // if alpha and beta disagree (*alphaBetaMismatch is then set)
+        // or if either matrix needs threshold or more of its full
+        // size; the time taken goes in *seconds.  Safe to call
+        // concurrently.
+        ScorerType* MakeScorer(const MappedRead& mr, float threshold, float* seconds,
+                               bool* alphaBetaMismatch) const;
+
+        // Construct the scorers of the pending reads_[readIds], using
+        // the thread pool if there is one.
+        void BuildScorers(const std::vector<int>& readIds);
+
+        // Build the pending reads among readIds (in increasing order),
+        // then keep to the budget, sparing readIds if the policy
+        // recomputes matrices.  Every public method using scorers
+        // first calls this on the reads it will use.
+        void EnsureScorers(const std::vector<int>& readIds) const;
+        void EnsureScorers(const Mutation& m) const;
+        void EnsureScorers(const std::vector<Mutation>& mutations, int begin, int end) const;
+        void EnsureAllScorers() const;
+
+        // True if EnsureScorers has nothing to do: no read is pending
+        // and no use need be recorded.
+        bool ScorersAreEnsured() const;
+
+        // Make sure every active read has a scorer or a cached score,
+        // building pending reads a few at a time under a budget.
+        void EnsureBaselineScores() const;
+
+        // Record the peak usage, and evict reads, other than those in
+        // spared (in increasing order), until the matrices fit the
+        // budget.
+        void KeepToMatrixBudget(const std::vector<int>& spared);
+
+        // Mutations to screen at a time: all of them, unless matrices
+        // are recomputed under a budget.
+        int ScreeningChunkSize(int numMutations, int numThreads) const;
+
+        // Indices, in increasing order, of the reads whose template
+        // span overlaps the mutation: a superset of the reads for
+        // which ReadScoresMutation holds, found using readIndex_.
+        void CandidateReads(const Mutation& m, std::vector<int>* readIds) const;
+
+        // Compute the score delta of every candidate read that scores
+        // the mutation, using the thread pool.  deltas and isScored are
+        // parallel to *readIds; entries for reads that do not score
+        // the mutation are flagged as zero in isScored.
+        void ParallelScores(const Mutation& m,
+                            std::vector<int>* readIds,
+                            std::vector<float>* deltas,
+                            std::vector<unsigned char>* isScored) const;
+
+        // FastIsFavorable(m), serially, extending into the given
+        // scratch matrix; a favorable mutation's Score is returned in
+        // *score.  Safe to call concurrently once the read index is
+        // up to date.
+        bool ScreenMutation(const Mutation& m,
+                            std::vector<int>* readIds,
+                            MatrixType& extendBuffer,
+                            float* score) const;
+
+        // FastScore of mutations[begin, end) into sums[begin, end),
+        // reading the read index but writing nothing else, so blocks
+        // can be scored concurrently once the index is up to date.
+        void FastScoreBlock(const std::vector<Mutation>& mutations,
+                            int begin, int end,
+                            MatrixType& extendBuffer,
+                            float* sums) const;
+
+        // Fill the row-major (read x mutation) arrays deltas and
+        // isScored, using the thread pool if there is one.
+        void ScoreMutationsByRead(const std::vector<Mutation>& mutations,
+                                  float* deltas,
+                                  unsigned char* isScored) const;
+
     private:
         QuiverConfigTable quiverConfigByChemistry_;
         float fastScoreThreshold_;
         std::string fwdTemplate_;
         std::string revTemplate_;
         std::vector<ReadStateType> reads_;
+        // Template spans of reads_, rebuilt on demand after reads are
+        // added or remapped
+        mutable detail::IntervalIndex readIndex_;
+        mutable bool readIndexIsStale_;
+        detail::ThreadPool* threadPool_;  // NULL when running serially
+        bool moveTables_;
+        bool lazyAlphaBeta_;
+        size_t matrixBudget_;  // bytes; 0 when unbounded
+        const AbstractEvictionPolicy* evictionPolicy_;
+        size_t peakMatrixEntries_;
+        int useClock_;  // stamps ReadState::LastUse
+        int numPendingReads_;
     };
 
     typedef MultiReadMutationScorer<SparseSseQvRecursor> \
@@ -0,0 +1,93 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+#include <ConsensusCore/Mutation.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ConsensusCore
+{
+    // Remembers the FastScore of each mutation scored against a
+    // template, across the iterations of RefineConsensus and on into
+    // ConsensusQVs, so that mutations far from any applied change are
+    // not rescored.
+    //
+    // Applying mutations to the template forgets the cached scores of
+    // mutations within InvalidationDistance template positions of any
+    // of them, and moves the rest to their positions in the new
+    // template.  This is an approximation: a change alters every
+    // read's alpha/beta matrices, so a retained score can differ a
+    // little from what rescoring would give---less so the larger the
+    // distance.  Scores are only meaningful for the reads and
+    // configuration they were computed with; Clear the cache when
+    // those change.
+    class MutationScoreCache
+    {
+    public:
+        explicit MutationScoreCache(int invalidationDistance);
+
+        int InvalidationDistance() const;
+
+#ifndef SWIG
+        // Look up the cached score of m, counting a hit or a miss
+        bool Find(const Mutation& m, float* score);
+#endif  // !SWIG
+        void Insert(const Mutation& m, float score);
+
+        // Follow the template from tpl to ApplyMutations(mutations, tpl)
+        void ApplyMutations(const std::vector<Mutation>& mutations,
+                            const std::string& tpl);
+
+        void Clear();
+
+        int Size() const;
+        int Hits() const;
+        int Misses() const;
+
+    private:
+        typedef std::map<Mutation, float> ScoreMap;
+
+        int invalidationDistance_;
+        ScoreMap scores_;
+        int hits_;
+        int misses_;
+    };
+}
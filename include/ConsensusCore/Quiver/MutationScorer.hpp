@@ -39,6 +39,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <string>
+#include <vector>
 
 // TODO(dalexander): how can we remove this include??
 //  We should move all template instantiations out to another
@@ -62,6 +63,14 @@ namespace ConsensusCore
         MutationScorer(const EvaluatorType& evaluator, const R& recursor)
             throw(AlphaBetaMismatchException);
 
+#ifndef SWIG
+        /// \brief Construct, banding the first fill around guidePath
+        ///        (see RecursorBase::FillAlphaBeta).
+        MutationScorer(const EvaluatorType& evaluator, const R& recursor,
+                       const std::vector<int>& guidePath)
+            throw(AlphaBetaMismatchException);
+#endif  // !SWIG
+
         MutationScorer(const MutationScorer& other);
         virtual ~MutationScorer();
 
@@ -73,14 +82,33 @@ namespace ConsensusCore
         float Score() const;
         float ScoreMutation(const Mutation& m) const;
 
+#ifndef SWIG
+        /// \brief ScoreMutation, extending into the caller's scratch
+        ///        matrix rather than this scorer's own buffer.
+        /// Nothing else is written while scoring, so threads can score
+        /// against one scorer concurrently given a scratch matrix each.
+        /// The scratch matrix may have any shape; it is reshaped as
+        /// needed.
+        float ScoreMutation(const Mutation& m, MatrixType& extendBuffer) const;
+#endif  // !SWIG
+
     public:
         // Accessors that are handy for debugging.
         const MatrixType* Alpha() const;
         const MatrixType* Beta() const;
         const PairwiseAlignment* Alignment() const;
         const EvaluatorType* Evaluator() const;
+        /// \brief Passes beyond the first two taken by the latest fill
+        ///        of alpha and beta (including any band widening), or
+        ///        -1 if they could not be mated.
         const int NumFlipFlops() const { return numFlipFlops_; }
 
+    private:
+        // Allocate the matrices and fill alpha and beta, guided by
+        // guidePath if it is not NULL
+        void Init(const std::vector<int>* guidePath)
+            throw(AlphaBetaMismatchException);
+
     private:
         EvaluatorType* evaluator_;
         R* recursor_;
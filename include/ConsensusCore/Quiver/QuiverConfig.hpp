@@ -59,17 +59,41 @@ namespace ConsensusCore
     };
 
     /// \brief The banding optimizations to be used by a recursor
+    ///
+    /// ScoreDiff bounds each column's band to the rows scoring within
+    /// ScoreDiff of the column maximum.  A positive DiagonalCross
+    /// further confines the unguided alpha fill (the first pass of
+    /// FillAlphaBeta, before any guide exists) to DiagonalCross *
+    /// sqrt(max(I, J)) rows either side of the read/template diagonal,
+    /// so the first pass cannot wander far off it; later, guided
+    /// passes recover any mass the diagonal band missed.  With dynamic
+    /// adjustment, the score difference used for a column becomes
+    /// DynamicAdjustOffset + DynamicAdjustFactor * (the score spread,
+    /// maximum less minimum, of the previously filled column), capped
+    /// at ScoreDiff.
     struct BandingOptions
     {
+        int DiagonalCross;
         float ScoreDiff;
+        bool DynamicAdjustment;
+        float DynamicAdjustFactor;
+        float DynamicAdjustOffset;
 
         BandingOptions(int diagonalCross, float scoreDiff)
-            : ScoreDiff(scoreDiff)
+            : DiagonalCross(diagonalCross)
+            , ScoreDiff(scoreDiff)
+            , DynamicAdjustment(false)
+            , DynamicAdjustFactor(0)
+            , DynamicAdjustOffset(0)
         {}
 
         BandingOptions(int diagonalCross, float scoreDiff,
                        float dynamicAdjustFactor, float dynamicAdjustOffset)
-            : ScoreDiff(scoreDiff)
+            : DiagonalCross(diagonalCross)
+            , ScoreDiff(scoreDiff)
+            , DynamicAdjustment(true)
+            , DynamicAdjustFactor(dynamicAdjustFactor)
+            , DynamicAdjustOffset(dynamicAdjustOffset)
         {}
     };
 
@@ -38,6 +38,7 @@
 #pragma once
 
 #include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
+#include <ConsensusCore/Quiver/MutationScoreCache.hpp>
 #include <ConsensusCore/Mutation.hpp>
 
 #include <vector>
@@ -49,23 +50,39 @@ namespace ConsensusCore
         int MaximumIterations;
         int MutationSeparation;
         int MutationNeighborhood;
+        // Threads screening candidate mutations; values below 2 mean
+        // screening runs on the calling thread (see
+        // MultiReadMutationScorer::FavorableMutations)
+        int NumThreads;
     };
 
     static const RefineOptions DefaultRefineOptions =
     {
         40,  // MaximumIterations
         10,  // MutationSeparation
-        20   // MutationNeighborhood
+        20,  // MutationNeighborhood
+        1    // NumThreads
     };
 
 
+    // Given a cache, candidates are screened through it (see
+    // MultiReadMutationScorer::FavorableMutations), and it follows
+    // the template as mutations are applied, so it can be handed on
+    // to ConsensusQVs.  It is cleared if applying mutations
+    // deactivates reads.
     bool RefineConsensus(AbstractMultiReadMutationScorer& mms,
-                         const RefineOptions& = DefaultRefineOptions);
+                         const RefineOptions& = DefaultRefineOptions,
+                         MutationScoreCache* cache = NULL);
 
     void RefineDinucleotideRepeats(AbstractMultiReadMutationScorer& mms,
                                    int minDinucleotideRepeatElements = 3);
 
-    std::vector<int> ConsensusQVs(AbstractMultiReadMutationScorer& mms);
+    // The QV of each template position, from the FastScores of the
+    // single-base mutations there (see FastScoreMutations for
+    // numThreads and cache)
+    std::vector<int> ConsensusQVs(AbstractMultiReadMutationScorer& mms,
+                                  int numThreads = 1,
+                                  MutationScoreCache* cache = NULL);
 
     //
     // Lower priority:
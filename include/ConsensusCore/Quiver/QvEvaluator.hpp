@@ -41,6 +41,8 @@
 #include <xmmintrin.h>
 #include <pmmintrin.h>
 
+#include <boost/shared_ptr.hpp>
+
 #include <algorithm>
 #include <cassert>
 #include <cfloat>
@@ -50,9 +52,12 @@
 #include <string>
 #include <utility>
 
+#include <ConsensusCore/Quiver/detail/QvMoveTables.hpp>
 #include <ConsensusCore/Quiver/detail/SseMath.hpp>
+#include <ConsensusCore/Quiver/detail/TemplateView.hpp>
 #include <ConsensusCore/Quiver/QuiverConfig.hpp>
 #include <ConsensusCore/Features.hpp>
+#include <ConsensusCore/Mutation.hpp>
 #include <ConsensusCore/Types.hpp>
 #include <ConsensusCore/Utils.hpp>
 #include <ConsensusCore/Read.hpp>
@@ -66,6 +71,10 @@ using std::max;
 
 namespace ConsensusCore
 {
+    namespace detail {
+        template<typename V> struct WideQvMoves;
+    }
+
     //
     // Utility functions
     //
@@ -87,6 +96,11 @@ namespace ConsensusCore
     //
 
     /// \brief An Evaluator that can compute move scores using a QvSequenceFeatures
+    ///
+    /// With moveTables set, the move scores are computed once, at
+    /// construction, into per-read tables (detail::QvMoveTables), which
+    /// every move lookup then reads; the scores are identical either
+    /// way.  The tables cost 16 floats per read base.
     class QvEvaluator
     {
     public:
@@ -98,20 +112,45 @@ namespace ConsensusCore
                     const std::string& tpl,
                     const QvModelParams& params,
                     bool pinStart = true,
-                    bool pinEnd = true)
-            : read_(read),
-              params_(params),
+                    bool pinEnd = true,
+                    bool moveTables = false)
+            : ownedRead_(new Read(read)),
+              read_(ownedRead_.get()),
+              ownedParams_(new QvModelParams(params)),
+              params_(ownedParams_.get()),
               tpl_(tpl),
               pinStart_(pinStart),
-              pinEnd_(pinEnd)
+              pinEnd_(pinEnd),
+              ownedMoveTables_(moveTables ?
+                               new detail::QvMoveTables(read_->Features, params, pinStart, pinEnd) :
+                               NULL),
+              moveTables_(ownedMoveTables_.get())
         {}
 
+#ifndef SWIG
+        /// \brief An evaluator for base's template with the mutation
+        ///        m applied.  No storage is copied, or shared: base and
+        ///        m must outlive the new evaluator, which is then cheap
+        ///        enough to make for every mutation scored.
+        QvEvaluator(const QvEvaluator& base, const Mutation& m)
+            : ownedRead_(),
+              read_(base.read_),
+              ownedParams_(),
+              params_(base.params_),
+              tpl_(base.tpl_, m),
+              pinStart_(base.pinStart_),
+              pinEnd_(base.pinEnd_),
+              ownedMoveTables_(),
+              moveTables_(base.moveTables_)
+        {}
+#endif  // SWIG
+
         ~QvEvaluator()
         {}
 
         std::string ReadName() const
         {
-            return read_.Name;
+            return read_->Name;
         }
 
         std::string Basecalls() const
@@ -121,12 +160,12 @@ namespace ConsensusCore
 
         std::string Template() const
         {
-            return tpl_;
+            return tpl_.ToString();
         }
 
         void Template(std::string tpl)
         {
-            tpl_ = tpl;
+            tpl_ = detail::TemplateView(tpl);
         }
 
 
@@ -137,7 +176,7 @@ namespace ConsensusCore
 
         int TemplateLength() const
         {
-            return tpl_.length();
+            return tpl_.Length();
         }
 
         bool PinEnd() const
@@ -150,6 +189,16 @@ namespace ConsensusCore
             return pinStart_;
         }
 
+        bool HasMoveTables() const
+        {
+            return moveTables_ != NULL;
+        }
+
+        int AllocatedMoveTableEntries() const
+        {
+            return HasMoveTables() ? moveTables_->AllocatedEntries() : 0;
+        }
+
         bool IsMatch(int i, int j) const
         {
             assert(0 <= i && i < ReadLength());
@@ -161,15 +210,25 @@ namespace ConsensusCore
         {
             assert(0 <= j && j < TemplateLength() &&
                    0 <= i && i < ReadLength() );
+            const float* table = MoveTable(detail::QvMoveTables::INC, j);
+            if (table != NULL)
+            {
+                return table[i];
+            }
             return (IsMatch(i, j)) ?
-                    params_.Match :
-                    params_.Mismatch + params_.MismatchS * Features().SubsQv[i];
+                    params_->Match :
+                    params_->Mismatch + params_->MismatchS * Features().SubsQv[i];
         }
 
         float Del(int i, int j) const
         {
             assert(0 <= j && j < TemplateLength() &&
                    0 <= i && i <= ReadLength() );
+            const float* table = MoveTable(detail::QvMoveTables::DEL, j);
+            if (table != NULL)
+            {
+                return table[i];
+            }
             if ( (!PinStart() && i == 0) || (!PinEnd() && i == ReadLength()) )
             {
                 return 0.0f;
@@ -178,8 +237,8 @@ namespace ConsensusCore
             {
                 float tplBase = tpl_[j];
                 return (i < ReadLength() && tplBase == Features().DelTag[i]) ?
-                        params_.DeletionWithTag + params_.DeletionWithTagS * Features().DelQv[i] :
-                        params_.DeletionN;
+                        params_->DeletionWithTag + params_->DeletionWithTagS * Features().DelQv[i] :
+                        params_->DeletionN;
             }
         }
 
@@ -187,22 +246,32 @@ namespace ConsensusCore
         {
             assert(0 <= j && j <= TemplateLength() &&
                    0 <= i && i < ReadLength() );
+            const float* table = MoveTable(detail::QvMoveTables::EXTRA, j);
+            if (table != NULL)
+            {
+                return table[i];
+            }
             return (j < TemplateLength() && IsMatch(i, j)) ?
-                    params_.Branch + params_.BranchS * Features().InsQv[i] :
-                    params_.Nce + params_.NceS * Features().InsQv[i];
+                    params_->Branch + params_->BranchS * Features().InsQv[i] :
+                    params_->Nce + params_->NceS * Features().InsQv[i];
         }
 
         float Merge(int i, int j) const
         {
             assert(0 <= j && j < TemplateLength() - 1 &&
                    0 <= i && i < ReadLength() );
+            const float* table = MoveTable(detail::QvMoveTables::MERGE, j);
+            if (table != NULL)
+            {
+                return (tpl_[j] == tpl_[j + 1]) ? table[i] : -FLT_MAX;
+            }
             if (!(Features()[i] == tpl_[j] && Features()[i] == tpl_[j + 1]) )
             {
                 return -FLT_MAX;
             }
             else
             {   int tplBase = encodeTplBase(tpl_[j]);
-                return params_.Merge[tplBase] + params_.MergeS[tplBase] * Features().MergeQv[i];
+                return params_->Merge[tplBase] + params_->MergeS[tplBase] * Features().MergeQv[i];
             }
         }
 
@@ -214,9 +283,14 @@ namespace ConsensusCore
         {
             assert (0 <= i && i <= ReadLength() - 4);
             assert (0 <= j && j < TemplateLength());
+            const float* table = MoveTable(detail::QvMoveTables::INC, j);
+            if (table != NULL)
+            {
+                return _mm_loadu_ps(&table[i]);
+            }
             float tplBase = tpl_[j];
-            __m128 match = _mm_set_ps1(params_.Match);
-            __m128 mismatch = AFFINE4(params_.Mismatch, params_.MismatchS, &Features().SubsQv[i]);
+            __m128 match = _mm_set_ps1(params_->Match);
+            __m128 mismatch = AFFINE4(params_->Mismatch, params_->MismatchS, &Features().SubsQv[i]);
             // Mask to see it the base is equal to the template
             __m128 mask = _mm_cmpeq_ps(_mm_loadu_ps(&Features().SequenceAsFloat[i]),
                                        _mm_set_ps1(tplBase));
@@ -227,13 +301,18 @@ namespace ConsensusCore
         {
             assert (0 <= i && i <= ReadLength());
             assert (0 <= j && j < TemplateLength());
+            const float* table = MoveTable(detail::QvMoveTables::DEL, j);
+            if (table != NULL)
+            {
+                return _mm_loadu_ps(&table[i]);
+            }
             if (i != 0 && i + 3 != ReadLength())
             {
                 float tplBase = tpl_[j];
-                __m128 delWTag = AFFINE4(params_.DeletionWithTag,
-                                         params_.DeletionWithTagS,
+                __m128 delWTag = AFFINE4(params_->DeletionWithTag,
+                                         params_->DeletionWithTagS,
                                          &Features().DelQv[i]);
-                __m128 delNoTag = _mm_set_ps1(params_.DeletionN);
+                __m128 delNoTag = _mm_set_ps1(params_->DeletionN);
                 __m128 mask = _mm_cmpeq_ps(_mm_loadu_ps(&Features().DelTag[i]),
                                            _mm_set_ps1(tplBase));
                 return MUX4(mask, delWTag, delNoTag);
@@ -254,24 +333,20 @@ namespace ConsensusCore
         {
             assert (0 <= i && i <= ReadLength() - 4);
             assert (0 <= j && j <= TemplateLength());
-            if (i != 0 && i + 3 != ReadLength())
+            const float* table = MoveTable(detail::QvMoveTables::EXTRA, j);
+            if (table != NULL)
             {
-                float tplBase = tpl_[j];
-                __m128 branch = AFFINE4(params_.Branch, params_.BranchS, &Features().InsQv[i]);
-                __m128 nce    = AFFINE4(params_.Nce,    params_.NceS,    &Features().InsQv[i]);
-
-                __m128 mask = _mm_cmpeq_ps(_mm_loadu_ps(&Features().SequenceAsFloat[i]),
-                                           _mm_set_ps1(tplBase));
-                return MUX4(mask, branch, nce);
-            }
-            else
-            {
-                __m128 res = _mm_setr_ps(Extra(i + 0, j),
-                                         Extra(i + 1, j),
-                                         Extra(i + 2, j),
-                                         Extra(i + 3, j));
-                return res;
+                return _mm_loadu_ps(&table[i]);
             }
+            // Unlike Del, Extra has no boundary-row cases (and at
+            // j == TemplateLength() the template's '\0' matches no base)
+            float tplBase = tpl_[j];
+            __m128 branch = AFFINE4(params_->Branch, params_->BranchS, &Features().InsQv[i]);
+            __m128 nce    = AFFINE4(params_->Nce,    params_->NceS,    &Features().InsQv[i]);
+
+            __m128 mask = _mm_cmpeq_ps(_mm_loadu_ps(&Features().SequenceAsFloat[i]),
+                                       _mm_set_ps1(tplBase));
+            return MUX4(mask, branch, nce);
         }
 
 
@@ -282,10 +357,17 @@ namespace ConsensusCore
 
             float tplBase     = tpl_[j];
             float tplBaseNext = tpl_[j + 1];
+            const float* table = MoveTable(detail::QvMoveTables::MERGE, j);
+            if (table != NULL)
+            {
+                return (tplBase == tplBaseNext) ?
+                    _mm_loadu_ps(&table[i]) :
+                    _mm_set_ps1(-FLT_MAX);
+            }
             int tplBase_ = encodeTplBase(tpl_[j]);
 
-            __m128 merge =  AFFINE4(params_.Merge[tplBase_],
-                                    params_.MergeS[tplBase_],
+            __m128 merge =  AFFINE4(params_->Merge[tplBase_],
+                                    params_->MergeS[tplBase_],
                                     &Features().MergeQv[i]);
             __m128 noMerge = _mm_set_ps1(-FLT_MAX);
 
@@ -304,15 +386,33 @@ namespace ConsensusCore
     protected:
         inline const QvSequenceFeatures& Features() const
         {
-            return read_.Features;
+            return read_->Features;
+        }
+
+        // The table of move m's scores at template position j, or NULL
+        // if there is none (no tables, or a base other than A, C, G, T)
+        const float* MoveTable(detail::QvMoveTables::Move m, int j) const
+        {
+            if (!moveTables_) return NULL;
+            int slot = detail::QvMoveTables::Slot(tpl_[j]);
+            return (slot == detail::QvMoveTables::NO_SLOT) ? NULL : moveTables_->Scores(slot, m);
         }
 
+        // AVX2/AVX-512 counterparts of Inc4 etc., for the wide kernels
+        template<typename V> friend struct detail::WideQvMoves;
 
     protected:
-        Read read_;
-        QvModelParams params_;
-        std::string tpl_;
+        // The read, parameters and move tables are owned by evaluators
+        // made from a Read, and shared by their copies; mutation views
+        // only borrow them, through the plain pointers.
+        boost::shared_ptr<const Read> ownedRead_;
+        const Read* read_;
+        boost::shared_ptr<const QvModelParams> ownedParams_;
+        const QvModelParams* params_;
+        detail::TemplateView tpl_;
         bool pinStart_;
         bool pinEnd_;
+        boost::shared_ptr<const detail::QvMoveTables> ownedMoveTables_;
+        const detail::QvMoveTables* moveTables_;
     };
 }
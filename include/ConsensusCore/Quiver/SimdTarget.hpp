@@ -0,0 +1,72 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+//
+// Wide (AVX2 / AVX-512) recursion kernels are compiled into their own
+// translation units under target-specific pragmas, so the rest of the
+// library---and the binary as a whole---still only requires SSE3.
+// Which kernels a recursor uses is decided at run time from cpuid.
+//
+#if (defined(__x86_64__) || defined(__i386__)) &&                      \
+    ((defined(__clang__) && __clang_major__ >= 9) ||                    \
+     (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 5))
+#  define CONSENSUSCORE_WIDE_KERNELS 1
+#else
+#  define CONSENSUSCORE_WIDE_KERNELS 0
+#endif
+
+namespace ConsensusCore
+{
+    /// \brief Instruction set a recursor's vector kernels target.
+    enum SimdTarget
+    {
+        SSE3_TARGET   = 0,   // 128-bit, always available
+        AVX2_TARGET   = 1,   // 256-bit
+        AVX512_TARGET = 2    // 512-bit
+    };
+
+    /// \brief Can this build, on this processor, run kernels for target?
+    bool IsSimdTargetSupported(SimdTarget target);
+
+    /// \brief The fastest target supported; determined once, via cpuid.
+    ///        This is AVX2 where available: AVX-512 must be requested.
+    SimdTarget BestSimdTarget();
+
+    const char* SimdTargetName(SimdTarget target);
+}
@@ -51,6 +51,11 @@ namespace ConsensusCore {
         void FillAlpha(const E& e, const M& guide, M& alpha) const;
         void FillBeta(const E& e, const M& guide, M& beta) const;
 
+        void FillAlpha(const E& e, const M& guide, M& alpha,
+                       int beginColumn, int endColumn) const;
+        void FillBeta(const E& e, const M& guide, M& beta,
+                      int beginColumn, int endColumn) const;
+
         float LinkAlphaBeta(const E& e,
                             const M& alpha, int alphaColumn,
                             const M& beta, int betaColumn,
@@ -43,6 +43,7 @@
 #include <ConsensusCore/Edna/EdnaEvaluator.hpp>
 #include <ConsensusCore/Quiver/detail/Combiner.hpp>
 #include <ConsensusCore/Quiver/detail/RecursorBase.hpp>
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
 #include <ConsensusCore/Quiver/SimpleRecursor.hpp>
 
 namespace ConsensusCore {
@@ -54,6 +55,11 @@ namespace ConsensusCore {
         void FillAlpha(const E& e, const M& guide, M& alpha) const;
         void FillBeta(const E& e, const M& guide, M& beta) const;
 
+        void FillAlpha(const E& e, const M& guide, M& alpha,
+                       int beginColumn, int endColumn) const;
+        void FillBeta(const E& e, const M& guide, M& beta,
+                      int beginColumn, int endColumn) const;
+
         float LinkAlphaBeta(const E& e,
                             const M& alpha, int alphaColumn,
                             const M& beta, int betaColumn,
@@ -74,9 +80,44 @@ namespace ConsensusCore {
         //
         SseRecursor(int movesAvailable, const BandingOptions& banding);
 
+        /// \brief The instruction set FillAlpha/FillBeta use; defaults
+        ///        to BestSimdTarget().
+        /// Only QV recursors have AVX2/AVX-512 kernels; others use
+        /// SSE3 whatever the target.  ExtendAlpha, ExtendBeta and
+        /// LinkAlphaBeta, which mutation scoring runs, are SSE3 for
+        /// every target: they cover a column or two of a band typically
+        /// 8-20 rows tall, too little for wider vectors to pay.  For
+        /// the same reason AVX-512 fills run slower than SSE3 under
+        /// default banding, and are used only on request.
+        SimdTarget Target() const;
+        void Target(SimdTarget target);
+
+    private:
+        //
+        // The kernels, instantiated with and without merge moves so
+        // that the MERGE test is resolved at compile time; the public
+        // entry points pick the instantiation matching movesAvailable.
+        //
+        template<bool MergeMoves>
+        void FillAlphaImpl(const E& e, const M& guide, M& alpha,
+                           int beginColumn, int endColumn) const;
+        template<bool MergeMoves>
+        void FillBetaImpl(const E& e, const M& guide, M& beta,
+                          int beginColumn, int endColumn) const;
+        template<bool MergeMoves>
+        float LinkAlphaBetaImpl(const E& e,
+                                const M& alpha, int alphaColumn,
+                                const M& beta, int betaColumn,
+                                int absoluteColumn) const;
+        template<bool MergeMoves>
+        void ExtendAlphaImpl(const E& e,
+                             const M& alpha, int beginColumn,
+                             M& ext, int numExtColumns) const;
+
     private:
         // Used during bringup
         SimpleRecursor<M, E, C> simpleRecursor_;
+        SimdTarget target_;
     };
 
     typedef SseRecursor<DenseMatrix,
@@ -39,6 +39,8 @@
 /// \brief Logic for how scores are combined when two alignment paths merge.
 
 #include <algorithm>
+#include <cfloat>
+#include <emmintrin.h>
 
 #include <ConsensusCore/Quiver/detail/SseMath.hpp>
 #include <ConsensusCore/Utils.hpp>
@@ -53,6 +55,10 @@ namespace detail {
     class ViterbiCombiner
     {
     public:
+        /// Whether the SSE recursors run the insertion cascade as an
+        /// in-register scan (see CascadeDown4), or a row at a time.
+        static const bool VECTOR_CASCADE = true;
+
         static float Combine(float x, float y)
         {
             return std::max(x, y);
@@ -69,6 +75,8 @@ namespace detail {
     class SumProductCombiner
     {
     public:
+        static const bool VECTOR_CASCADE = true;
+
         static float Combine(float x, float y)
         {
             return logAdd(x, y);
@@ -79,4 +87,103 @@ namespace detail {
             return logAdd4(x4, y4);
         }
     };
+
+    //
+    // The insertion ("Extra") cascade through a block of four rows of a
+    // column: down an alpha column,
+    //
+    //     result[k] = Combine(x4[k], result[k-1] + ins4[k]),
+    //
+    // result[-1] being the cell above the block; up a beta column,
+    //
+    //     result[k] = Combine(x4[k], result[k+1] + ins4[k]),
+    //
+    // result[4] being the cell below.  Row by row, this is a chain of
+    // four dependent Combines through memory.  Since + distributes over
+    // Combine (in both the max-plus and log-sum-exp semirings), it is
+    // also a prefix scan, done here in two shift-and-Combine steps plus
+    // one for the boundary cell.  The scan's sums associate differently,
+    // so results can differ from the row-by-row cascade in the last bit.
+    //
+
+    // Lane k <- lane k - n (up) or k + n (down); vacated lanes zero
+    inline __m128 ShiftUpLanes1(__m128 x4)
+    { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x4), 4)); }
+    inline __m128 ShiftUpLanes2(__m128 x4)
+    { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x4), 8)); }
+    inline __m128 ShiftDownLanes1(__m128 x4)
+    { return _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(x4), 4)); }
+    inline __m128 ShiftDownLanes2(__m128 x4)
+    { return _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(x4), 8)); }
+
+    template<typename C>
+    inline __m128 ScalarCascadeDown4(__m128 x4, __m128 ins4, float above)
+    {
+        float ins[4], scores[5];
+        _mm_storeu_ps(ins, ins4);
+        scores[0] = above;
+        _mm_storeu_ps(&scores[1], x4);
+        for (int k = 1; k < 5; k++)
+        {
+            scores[k] = C::Combine(scores[k], scores[k - 1] + ins[k - 1]);
+        }
+        return _mm_loadu_ps(&scores[1]);
+    }
+
+    template<typename C>
+    inline __m128 ScalarCascadeUp4(__m128 x4, __m128 ins4, float below)
+    {
+        float ins[4], scores[5];
+        _mm_storeu_ps(ins, ins4);
+        scores[4] = below;
+        _mm_storeu_ps(scores, x4);
+        for (int k = 3; k >= 0; k--)
+        {
+            scores[k] = C::Combine(scores[k], scores[k + 1] + ins[k]);
+        }
+        return _mm_loadu_ps(scores);
+    }
+
+    template<typename C>
+    inline __m128 ScanCascadeDown4(__m128 x4, __m128 ins4, float above)
+    {
+        // Vacated lanes of the shifted scores must be -inf, not zero
+        const __m128 lowOne = _mm_setr_ps(-FLT_MAX, 0.0f, 0.0f, 0.0f);
+        const __m128 lowTwo = _mm_setr_ps(-FLT_MAX, -FLT_MAX, 0.0f, 0.0f);
+        __m128 y4 = x4, cost4 = ins4;
+        y4 = C::Combine4(y4, _mm_add_ps(_mm_or_ps(ShiftUpLanes1(y4), lowOne), cost4));
+        cost4 = _mm_add_ps(cost4, ShiftUpLanes1(cost4));
+        y4 = C::Combine4(y4, _mm_add_ps(_mm_or_ps(ShiftUpLanes2(y4), lowTwo), cost4));
+        cost4 = _mm_add_ps(cost4, ShiftUpLanes2(cost4));
+        return C::Combine4(y4, _mm_add_ps(_mm_set_ps1(above), cost4));
+    }
+
+    template<typename C>
+    inline __m128 ScanCascadeUp4(__m128 x4, __m128 ins4, float below)
+    {
+        const __m128 highOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, -FLT_MAX);
+        const __m128 highTwo = _mm_setr_ps(0.0f, 0.0f, -FLT_MAX, -FLT_MAX);
+        __m128 y4 = x4, cost4 = ins4;
+        y4 = C::Combine4(y4, _mm_add_ps(_mm_or_ps(ShiftDownLanes1(y4), highOne), cost4));
+        cost4 = _mm_add_ps(cost4, ShiftDownLanes1(cost4));
+        y4 = C::Combine4(y4, _mm_add_ps(_mm_or_ps(ShiftDownLanes2(y4), highTwo), cost4));
+        cost4 = _mm_add_ps(cost4, ShiftDownLanes2(cost4));
+        return C::Combine4(y4, _mm_add_ps(_mm_set_ps1(below), cost4));
+    }
+
+    template<typename C>
+    inline __m128 CascadeDown4(__m128 x4, __m128 ins4, float above)
+    {
+        return C::VECTOR_CASCADE ?
+            ScanCascadeDown4<C>(x4, ins4, above) :
+            ScalarCascadeDown4<C>(x4, ins4, above);
+    }
+
+    template<typename C>
+    inline __m128 CascadeUp4(__m128 x4, __m128 ins4, float below)
+    {
+        return C::VECTOR_CASCADE ?
+            ScanCascadeUp4<C>(x4, ins4, below) :
+            ScalarCascadeUp4<C>(x4, ins4, below);
+    }
 }}
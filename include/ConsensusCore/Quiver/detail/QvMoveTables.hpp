@@ -0,0 +1,108 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+/// \file  QvMoveTables.hpp
+/// \brief Per-read tables of QvEvaluator move scores.
+
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+#include <ConsensusCore/Features.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+    /// \brief The QvEvaluator move scores of every read row, for each
+    ///        template base.
+    ///
+    /// A move score depends on the template only through the base at
+    /// the template position, so for a read of length I there are just
+    /// 4 x I distinct scores per move; these tables hold them all, so
+    /// that the recursors' Inc4 etc. are single loads.  Each move's
+    /// scores for one template base are contiguous, and padded to a
+    /// whole number of SSE vectors past their last row.  Template
+    /// bases other than A, C, G, T have no slot; evaluators compute
+    /// those scores directly.
+    ///
+    /// The tables are immutable once built, so evaluators share them.
+    class QvMoveTables
+    {
+    public:
+        enum Move { INC, DEL, EXTRA, MERGE, NUM_MOVES };
+
+        static const int NUM_SLOTS = 4;
+        static const int NO_SLOT = -1;
+
+    public:
+        QvMoveTables(const QvSequenceFeatures& features,
+                     const QvModelParams& params,
+                     bool pinStart,
+                     bool pinEnd);
+
+        static int Slot(char tplBase)
+        {
+            switch (tplBase)
+            {
+                case 'A': return 0;
+                case 'C': return 1;
+                case 'G': return 2;
+                case 'T': return 3;
+                default:  return NO_SLOT;
+            }
+        }
+
+        // Scores of move m, at template base slot, for rows 0..I (Del),
+        // or 0..I-1 (the others).
+        const float* Scores(int slot, Move m) const
+        {
+            assert(0 <= slot && slot < NUM_SLOTS);
+            return &scores_[(slot * NUM_MOVES + m) * stride_];
+        }
+
+        int AllocatedEntries() const
+        {
+            return static_cast<int>(scores_.size());
+        }
+
+    private:
+        int stride_;
+        std::vector<float> scores_;
+    };
+}}
@@ -39,6 +39,8 @@
 
 #include <algorithm>
 #include <boost/tuple/tuple.hpp>
+#include <cfloat>
+#include <cmath>
 #include <utility>
 
 #include <ConsensusCore/Interval.hpp>
@@ -82,6 +84,85 @@ namespace detail {
         return Interval(beginRow, endRow);
     }
 
+    //
+    // Banding hints to resume a fill after column j, matching the
+    // hints FillAlpha/FillBeta carry from one column to the next: the
+    // used row range, trimmed on the side the fill proceeds from to
+    // rows within scoreDiff of the column maximum.
+    //
+    template<typename M>
+    inline void AlphaResumeHints(int j, const M& alpha, float scoreDiff,
+                                 int* beginRow, int* endRow)
+    {
+        int usedBegin, usedEnd;
+        boost::tie(usedBegin, usedEnd) = alpha.UsedRowRange(j);
+        float maxScore = -FLT_MAX;
+        for (int i = usedBegin; i < usedEnd; i++)
+        {
+            maxScore = std::max(maxScore, alpha(i, j));
+        }
+        float thresholdScore = maxScore - scoreDiff;
+        int i;
+        for (i = usedBegin; i < usedEnd && alpha(i, j) < thresholdScore; ++i);
+        *beginRow = i;
+        *endRow = usedEnd;
+    }
+
+    template<typename M>
+    inline void BetaResumeHints(int j, const M& beta, float scoreDiff,
+                                int* beginRow, int* endRow)
+    {
+        int usedBegin, usedEnd;
+        boost::tie(usedBegin, usedEnd) = beta.UsedRowRange(j);
+        float maxScore = -FLT_MAX;
+        for (int i = usedBegin; i < usedEnd; i++)
+        {
+            maxScore = std::max(maxScore, beta(i, j));
+        }
+        float thresholdScore = maxScore - scoreDiff;
+        int i;
+        for (i = usedEnd; i > usedBegin && beta(i - 1, j) < thresholdScore; --i);
+        *beginRow = usedBegin;
+        *endRow = i;
+    }
+
+    // Copy a column, adding a constant (log-space scale) offset
+    template<typename M>
+    inline void CopyColumn(const M& src, int srcColumn, M& dest, int destColumn,
+                           float offset = 0.0f)
+    {
+        int usedBegin, usedEnd;
+        boost::tie(usedBegin, usedEnd) = src.UsedRowRange(srcColumn);
+        dest.StartEditingColumn(destColumn, usedBegin, usedEnd);
+        for (int i = usedBegin; i < usedEnd; i++)
+        {
+            dest.Set(i, destColumn, src(i, srcColumn) + offset);
+        }
+        dest.FinishEditingColumn(destColumn, usedBegin, usedEnd);
+    }
+
+    //
+    // Do the columns span the same rows, with entries differing by
+    // the same constant (within tolerance)?  Columns related this way
+    // yield successor columns related the same way, since the
+    // recursions and the banding heuristics are invariant to a
+    // log-space offset.  The offset is returned in *offset.
+    //
+    template<typename M>
+    inline bool ColumnsAgree(const M& a, int aColumn, const M& b, int bColumn,
+                             float tolerance, float* offset)
+    {
+        Interval aRange = a.UsedRowRange(aColumn);
+        if (!(aRange == b.UsedRowRange(bColumn))) return false;
+        if (aRange.Begin == aRange.End) return false;
+        *offset = a(aRange.Begin, aColumn) - b(aRange.Begin, bColumn);
+        for (int i = aRange.Begin + 1; i < aRange.End; i++)
+        {
+            if (fabs(a(i, aColumn) - b(i, bColumn) - *offset) > tolerance) return false;
+        }
+        return true;
+    }
+
     template<typename M, typename E, typename C>
     inline bool
     RecursorBase<M, E, C>::RangeGuide(int j, const M& guide, const M& matrix,
@@ -112,4 +193,57 @@ namespace detail {
 
         return true;
     }
+
+    template<typename M, typename E, typename C>
+    inline void
+    RecursorBase<M, E, C>::DiagonalBand(int j, int I, int J,
+                                        int* beginRow, int* endRow, int* bandEndRow) const
+    {
+        if (bandingOptions_.DiagonalCross <= 0)
+        {
+            return;
+        }
+
+        int halfWidth = bandingOptions_.DiagonalCross *
+            static_cast<int>(ceil(sqrt(static_cast<float>(std::max(I, J)))));
+        int diagonalRow = (J == 0) ? 0 : static_cast<int>(static_cast<double>(j) * I / J);
+        int bandBeginRow = std::max(0, diagonalRow - halfWidth);
+        int bandEndRowJ  = std::min(I + 1, diagonalRow + halfWidth + 1);
+
+        *beginRow = std::max(*beginRow, std::min(bandBeginRow, *endRow - 1));
+        *bandEndRow = std::max(bandEndRowJ, *beginRow + 1);
+        *endRow = std::min(*endRow, *bandEndRow);
+    }
+
+    template<typename M, typename E, typename C>
+    inline float
+    RecursorBase<M, E, C>::NextScoreDiff(const M& matrix, int j) const
+    {
+        if (!bandingOptions_.DynamicAdjustment)
+        {
+            return bandingOptions_.ScoreDiff;
+        }
+
+        int usedBegin, usedEnd;
+        boost::tie(usedBegin, usedEnd) = matrix.UsedRowRange(j);
+        float minScore = FLT_MAX, maxScore = -FLT_MAX;
+        for (int i = usedBegin; i < usedEnd; i++)
+        {
+            float score = matrix(i, j);
+            // Unreachable cells (-inf) carry no information on the spread
+            if (score > -FLT_MAX)
+            {
+                minScore = std::min(minScore, score);
+                maxScore = std::max(maxScore, score);
+            }
+        }
+        if (minScore > maxScore)
+        {
+            return bandingOptions_.ScoreDiff;
+        }
+
+        float scoreDiff = bandingOptions_.DynamicAdjustOffset +
+                          bandingOptions_.DynamicAdjustFactor * (maxScore - minScore);
+        return std::min(bandingOptions_.ScoreDiff, scoreDiff);
+    }
 }}
@@ -40,6 +40,7 @@
 #include <algorithm>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include <ConsensusCore/Types.hpp>
 #include <ConsensusCore/Quiver/QuiverConfig.hpp>
@@ -78,6 +79,35 @@ namespace ConsensusCore {
         FillAlphaBeta(const E& e, M& alpha, M& beta) const
             throw(AlphaBetaMismatchException);
 
+#ifndef SWIG
+        /// \brief Fill the alpha and beta matrices, banding the first
+        ///        alpha pass around an approximate alignment path.
+        /// guidePath[j] is the read position aligned to template
+        /// position j, for j in [0, J], as TargetToQueryPositions
+        /// gives; any cheap aligner (a POA read path, a k-mer chain)
+        /// will do.  A good path lets alpha and beta mate without
+        /// flip-flops; a poor one costs no more than an unguided pass.
+        virtual int
+        FillAlphaBeta(const E& e, const std::vector<int>& guidePath,
+                      M& alpha, M& beta) const
+            throw(AlphaBetaMismatchException);
+#endif  // !SWIG
+
+        /// \brief Refill alpha and beta after an edit to the template.
+        /// oldAlpha and oldBeta must have been filled for a template
+        /// that differs from e's only in the span [editBegin, editEnd)
+        /// (in the old template's coordinates).  Columns unaffected by
+        /// the edit are copied over, shifted by the change in template
+        /// length; only the columns in between are recomputed, stopping
+        /// early once they agree with the old ones.  Falls back to
+        /// FillAlphaBeta if the result does not mate.
+        virtual int
+        RefillAlphaBeta(const E& e,
+                        const M& oldAlpha, const M& oldBeta,
+                        int editBegin, int editEnd,
+                        M& alpha, M& beta) const
+            throw(AlphaBetaMismatchException);
+
         /// \brief Reband alpha and beta matrices.
         /// This routine will reband alpha and beta to the convex hull
         /// of the maximum path through each and the inputs for column j.
@@ -85,6 +115,21 @@ namespace ConsensusCore {
         RangeGuide(int j, const M& guide, const M& matrix,
                    int* beginRow, int* endRow) const;
 
+        /// \brief Confine the unguided fill of alpha column j to the
+        ///        diagonal band (see BandingOptions::DiagonalCross).
+        /// Narrows the hints to the band, and sets *bandEndRow to the
+        /// row past which the fill must not extend; both are left
+        /// alone when the diagonal band is disabled.  The hints always
+        /// keep a row adjoining the previous column's, so the band
+        /// cannot disconnect the fill.
+        void DiagonalBand(int j, int I, int J,
+                          int* beginRow, int* endRow, int* bandEndRow) const;
+
+        /// \brief The score difference to band the next column with,
+        ///        having filled column j of matrix.
+        /// ScoreDiff, unless dynamic adjustment is enabled.
+        float NextScoreDiff(const M& matrix, int j) const;
+
         /// \brief Raw FillAlpha, provided primarily for testing purposes.
         ///        Client code should use FillAlphaBeta.
         virtual void FillAlpha(const E& e, const M& guide, M& alpha) const = 0;
@@ -93,6 +138,17 @@ namespace ConsensusCore {
         ///        Client code should use FillAlphaBeta.
         virtual void FillBeta(const E& e, const M& guide, M& beta) const = 0;
 
+        /// \brief Fill alpha columns [beginColumn, endColumn), resuming
+        ///        from the (already filled) column beginColumn - 1.
+        virtual void FillAlpha(const E& e, const M& guide, M& alpha,
+                               int beginColumn, int endColumn) const = 0;
+
+        /// \brief Fill beta columns [beginColumn, endColumn), right to
+        ///        left, resuming from the (already filled) column
+        ///        endColumn.
+        virtual void FillBeta(const E& e, const M& guide, M& beta,
+                              int beginColumn, int endColumn) const = 0;
+
         /// \brief Compute two columns of the alpha matrix starting at columnBegin,
         ///        storing the output in ext.
         virtual void ExtendAlpha(const E& e,
@@ -107,6 +163,19 @@ namespace ConsensusCore {
         RecursorBase(int movesAvailable, const BandingOptions& banding);
         virtual ~RecursorBase();
 
+        int MovesAvailable() const { return movesAvailable_; }
+        const BandingOptions& Banding() const { return bandingOptions_; }
+
+    protected:
+        /// \brief The part of FillAlphaBeta following the initial
+        ///        alpha fill and alpha-guided beta fill: rebanding and
+        ///        flip-flopping until the two mate, then, failing that,
+        ///        refilling both in successively wider bands.  Returns
+        ///        the number of passes beyond the first two; throws if
+        ///        even the widest band does not mate them.
+        int FinishFillAlphaBeta(const E& e, M& alpha, M& beta) const
+            throw(AlphaBetaMismatchException);
+
     protected:
         int movesAvailable_;
         BandingOptions bandingOptions_;
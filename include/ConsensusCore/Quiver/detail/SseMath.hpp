@@ -37,6 +37,7 @@
 
 #pragma once
 
+#include <emmintrin.h>
 #include <xmmintrin.h>
 #include <limits>
 
@@ -61,29 +62,100 @@ namespace detail {
     //
     // Log-space arithmetic
     //
+    // logAdd(a, b) = max + f(d), f(d) = log(1 + exp(-d)), d = |a - b|.
+    // d is rounded to the nearest k/16 and f is evaluated by its cubic
+    // Taylor expansion about that point, the coefficients coming from
+    // LOG_ADD_TABLE (SseMath.cpp); the truncation error is below 1e-8,
+    // leaving float rounding (~6e-8) as the error.  This is one short
+    // polynomial on the critical path, where exp and log each needed a
+    // long one and log a division as well.
+    //
+    // Beyond d = LOG_ADD_CUTOFF the correction, below 1.2e-7, is dropped,
+    // so a block whose lanes are all that far apart costs a compare.
+    // logAdd4 and logAdd perform the same float operations in the same
+    // order, so they agree exactly.
+    //
     static const __m128 ones    = _mm_set_ps1(1.0f);
 
+    static const float LOG_ADD_CUTOFF = 16.0f;
+    static const float LOG_ADD_STEPS_PER_UNIT = 16.0f;
+    static const int LOG_ADD_TABLE_SIZE = 257;
+
+    extern const float LOG_ADD_TABLE[LOG_ADD_TABLE_SIZE][4];
+
+    // log(1 + exp(-d)), for 0 <= d <= LOG_ADD_CUTOFF
+    inline __m128 log1pExpNeg4(__m128 d)
+    {
+        __m128i k = _mm_cvtps_epi32(_mm_mul_ps(d, _mm_set_ps1(LOG_ADD_STEPS_PER_UNIT)));
+        __m128 x = _mm_sub_ps(d, _mm_mul_ps(_mm_cvtepi32_ps(k),
+                                            _mm_set_ps1(1.0f / LOG_ADD_STEPS_PER_UNIT)));
+
+        ALIGN16_BEG int kk[4] ALIGN16_END;
+        _mm_store_si128(reinterpret_cast<__m128i*>(kk), k);
+        __m128 c0 = _mm_load_ps(LOG_ADD_TABLE[kk[0]]);
+        __m128 c1 = _mm_load_ps(LOG_ADD_TABLE[kk[1]]);
+        __m128 c2 = _mm_load_ps(LOG_ADD_TABLE[kk[2]]);
+        __m128 c3 = _mm_load_ps(LOG_ADD_TABLE[kk[3]]);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        __m128 p = c3;
+        p = _mm_add_ps(_mm_mul_ps(p, x), c2);
+        p = _mm_add_ps(_mm_mul_ps(p, x), c1);
+        return _mm_add_ps(_mm_mul_ps(p, x), c0);
+    }
+
     inline __m128 logAdd4(__m128 aa, __m128 bb)
     {
         __m128 max = _mm_max_ps(aa, bb);
         __m128 min = _mm_min_ps(aa, bb);
-        __m128 diff = _mm_sub_ps(min, max);
-        return _mm_add_ps(max, log_ps(_mm_add_ps(ones, exp_ps(diff))));
+        __m128 d = _mm_sub_ps(max, min);
+        __m128 near = _mm_cmplt_ps(d, _mm_set_ps1(LOG_ADD_CUTOFF));
+        if (_mm_movemask_ps(near) == 0)
+        {
+            return max;
+        }
+        d = _mm_and_ps(near, d);
+        return _mm_add_ps(max, _mm_and_ps(near, log1pExpNeg4(d)));
+    }
 
-        // Precision of this is currently too low -- causes problems w/ Edna
-        // need a more accurate impl.
-        // return logAddApprox_ps(aa, bb);
+    // Scalar counterpart of log1pExpNeg4
+    inline float log1pExpNeg(float d)
+    {
+        int k = _mm_cvtss_si32(_mm_set_ss(d * LOG_ADD_STEPS_PER_UNIT));
+        float x = d - static_cast<float>(k) * (1.0f / LOG_ADD_STEPS_PER_UNIT);
+        const float* c = LOG_ADD_TABLE[k];
+        float p = c[3];
+        p = p * x + c[2];
+        p = p * x + c[1];
+        return p * x + c[0];
+    }
+
+    //
+    // Horizontal reductions
+    //
+    inline float horizontalMax4(__m128 x4)
+    {
+        x4 = _mm_max_ps(x4, _mm_shuffle_ps(x4, x4, _MM_SHUFFLE(2, 3, 0, 1)));
+        x4 = _mm_max_ps(x4, _mm_shuffle_ps(x4, x4, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(x4);
+    }
+
+    inline float horizontalMin4(__m128 x4)
+    {
+        x4 = _mm_min_ps(x4, _mm_shuffle_ps(x4, x4, _MM_SHUFFLE(2, 3, 0, 1)));
+        x4 = _mm_min_ps(x4, _mm_shuffle_ps(x4, x4, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(x4);
     }
 
     inline float logAdd(float a, float b)
     {
-        __m128 aa = _mm_set_ps1(a);
-        __m128 bb = _mm_set_ps1(b);
-        __m128 acc = logAdd4(aa, bb);
-
-        // Use an aligned buf to extract
-        ALIGN16_BEG float buf[4] ALIGN16_END;
-        _mm_store_ps(&buf[0], acc);
-        return buf[0];
+        float max = (a > b) ? a : b;
+        float min = (a < b) ? a : b;
+        float d = max - min;
+        if (!(d < LOG_ADD_CUTOFF))
+        {
+            return max;
+        }
+        return max + log1pExpNeg(d);
     }
 }}
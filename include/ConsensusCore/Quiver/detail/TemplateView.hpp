@@ -0,0 +1,151 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+/// \file  TemplateView.hpp
+/// \brief Cheaply-copyable template storage, with an optional
+///        overlaid mutation, used by the evaluators.
+
+#pragma once
+
+#include <boost/shared_ptr.hpp>
+#include <cassert>
+#include <climits>
+#include <string>
+
+#include <ConsensusCore/Mutation.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+    /// \brief A template sequence, possibly seen through a single
+    ///        mutation.
+    ///
+    /// The bases are held in shared, immutable storage, so copying a
+    /// view---or overlaying a mutation on one---never copies the
+    /// template or touches the heap.  An overlaid view refers to the
+    /// mutation's new bases, so the Mutation must outlive it; it
+    /// borrows the bases from the view it overlays, without
+    /// reference counting, so that view must outlive it too.
+    class TemplateView
+    {
+    public:
+        TemplateView()
+            : tpl_(new std::string()),
+              bases_(tpl_->c_str()),
+              length_(0),
+              mutStart_(INT_MAX),
+              mutNewEnd_(INT_MAX),
+              newBases_(NULL),
+              lengthDiff_(0)
+        {}
+
+        explicit TemplateView(const std::string& tpl)
+            : tpl_(new std::string(tpl)),
+              bases_(tpl_->c_str()),
+              length_(tpl_->length()),
+              mutStart_(INT_MAX),
+              mutNewEnd_(INT_MAX),
+              newBases_(NULL),
+              lengthDiff_(0)
+        {}
+
+        TemplateView(const TemplateView& base, const Mutation& m)
+            : tpl_(),
+              bases_(base.bases_),
+              length_(base.length_ + m.LengthDiff()),
+              mutStart_(m.Start()),
+              mutNewEnd_(m.Start() + m.NewBases().length()),
+              newBases_(m.NewBases().data()),
+              lengthDiff_(m.LengthDiff())
+        {
+            assert(!base.IsMutated());
+            assert(0 <= m.Start() && m.End() <= base.length_);
+        }
+
+        // As with std::string, position Length() holds a '\0'.
+        char operator[](int j) const
+        {
+            assert(0 <= j && j <= length_);
+            if (j < mutStart_)
+            {
+                return bases_[j];
+            }
+            else if (j < mutNewEnd_)
+            {
+                return newBases_[j - mutStart_];
+            }
+            else
+            {
+                return bases_[j - lengthDiff_];
+            }
+        }
+
+        int Length() const
+        {
+            return length_;
+        }
+
+        bool IsMutated() const
+        {
+            return mutStart_ != INT_MAX;
+        }
+
+        std::string ToString() const
+        {
+            if (!IsMutated()) return *tpl_;
+            std::string tpl;
+            tpl.reserve(length_);
+            for (int j = 0; j < length_; j++)
+            {
+                tpl.push_back((*this)[j]);
+            }
+            return tpl;
+        }
+
+    private:
+        boost::shared_ptr<const std::string> tpl_;
+        const char* bases_;
+        int length_;
+
+        // Overlaid mutation; mutStart_ is INT_MAX when there is none,
+        // so the common path is a single comparison.
+        int mutStart_;
+        int mutNewEnd_;
+        const char* newBases_;
+        int lengthDiff_;
+    };
+}}
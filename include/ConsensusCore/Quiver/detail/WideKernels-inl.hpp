@@ -0,0 +1,577 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Width-generic recursion kernels, parameterized by a vector traits
+// class V (Vec, W, and the arithmetic below).  This file must only be
+// included by the per-target kernel translation units, after their
+// target pragma, so that every function in it is compiled for that
+// target; everything here is a template on V, so the AVX2 and AVX-512
+// instantiations never collide.  Nothing here instantiates library
+// templates (std::max_element etc.), whose out-of-line copies could
+// otherwise be compiled for the wide target and picked by the linker
+// for the SSE code as well.
+//
+// V provides:
+//    Vec, W                         vector type and its width in floats
+//    Set1, LoadU, StoreU            broadcast, unaligned load/store
+//    Add, Sub, Mul, Max, Min
+//    Round                          to nearest integer, ties to even
+//    SelectEq(a, b, t, f)           a == b ? t : f, per lane
+//    SelectLt(a, b, t, f)           a <  b ? t : f, per lane
+//    Gather(base, n)                base[n], per lane, for integral n
+//    Get(m, i, j)                   W successive rows of a column
+//
+
+#pragma once
+
+#include <cfloat>
+
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/detail/Combiner.hpp>
+#include <ConsensusCore/Quiver/detail/RecursorBase.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+    //
+    // Log-space arithmetic: logAdd4 (SseMath.hpp) at width W, performing
+    // the same float operations, so that the two agree exactly.
+    //
+    template<typename V>
+    inline typename V::Vec WideLog1pExpNeg(typename V::Vec d)
+    {
+        typedef typename V::Vec Vec;
+        Vec k = V::Round(V::Mul(d, V::Set1(LOG_ADD_STEPS_PER_UNIT)));
+        Vec x = V::Sub(d, V::Mul(k, V::Set1(1.0f / LOG_ADD_STEPS_PER_UNIT)));
+        Vec row = V::Mul(k, V::Set1(4.0f));
+
+        Vec p = V::Gather(&LOG_ADD_TABLE[0][3], row);
+        p = V::Add(V::Mul(p, x), V::Gather(&LOG_ADD_TABLE[0][2], row));
+        p = V::Add(V::Mul(p, x), V::Gather(&LOG_ADD_TABLE[0][1], row));
+        return V::Add(V::Mul(p, x), V::Gather(&LOG_ADD_TABLE[0][0], row));
+    }
+
+    template<typename V>
+    inline typename V::Vec WideLogAdd(typename V::Vec a, typename V::Vec b)
+    {
+        typedef typename V::Vec Vec;
+        Vec max = V::Max(a, b);
+        Vec min = V::Min(a, b);
+        Vec d = V::Sub(max, min);
+        Vec zero = V::Set1(0.0f);
+        Vec cutoff = V::Set1(LOG_ADD_CUTOFF);
+        Vec f = WideLog1pExpNeg<V>(V::SelectLt(d, cutoff, d, zero));
+        return V::Add(max, V::SelectLt(d, cutoff, f, zero));
+    }
+
+    //
+    // Combiners
+    //
+    template<typename C, typename V>
+    struct WideCombiner;
+
+    template<typename V>
+    struct WideCombiner<ViterbiCombiner, V>
+    {
+        static typename V::Vec Combine(typename V::Vec x, typename V::Vec y)
+        {
+            return V::Max(x, y);
+        }
+    };
+
+    template<typename V>
+    struct WideCombiner<SumProductCombiner, V>
+    {
+        static typename V::Vec Combine(typename V::Vec x, typename V::Vec y)
+        {
+            return WideLogAdd<V>(x, y);
+        }
+    };
+
+    //
+    // QvEvaluator move scores for W successive rows: the
+    // counterparts of QvEvaluator::Inc4 etc.
+    //
+    template<typename V>
+    struct WideQvMoves
+    {
+        typedef typename V::Vec Vec;
+
+        static Vec Affine(float offset, float slope, const float* data)
+        {
+            return V::Add(V::Set1(offset), V::Mul(V::Set1(slope), V::LoadU(data)));
+        }
+
+        static Vec Inc(const QvEvaluator& e, int i, int j)
+        {
+            assert(0 <= i && i <= e.ReadLength() - V::W);
+            assert(0 <= j && j < e.TemplateLength());
+            const float* table = e.MoveTable(QvMoveTables::INC, j);
+            if (table != NULL)
+            {
+                return V::LoadU(&table[i]);
+            }
+            const QvModelParams& p = *e.params_;
+            float tplBase = e.tpl_[j];
+            return V::SelectEq(V::LoadU(&e.Features().SequenceAsFloat[i]), V::Set1(tplBase),
+                               V::Set1(p.Match),
+                               Affine(p.Mismatch, p.MismatchS, &e.Features().SubsQv[i]));
+        }
+
+        static Vec Del(const QvEvaluator& e, int i, int j)
+        {
+            assert(0 <= i && i <= e.ReadLength());
+            assert(0 <= j && j < e.TemplateLength());
+            const float* table = e.MoveTable(QvMoveTables::DEL, j);
+            if (table != NULL)
+            {
+                return V::LoadU(&table[i]);
+            }
+            if (i != 0 && i + V::W - 1 != e.ReadLength())
+            {
+                const QvModelParams& p = *e.params_;
+                float tplBase = e.tpl_[j];
+                return V::SelectEq(V::LoadU(&e.Features().DelTag[i]), V::Set1(tplBase),
+                                   Affine(p.DeletionWithTag, p.DeletionWithTagS,
+                                          &e.Features().DelQv[i]),
+                                   V::Set1(p.DeletionN));
+            }
+            else
+            {
+                // PinStart/PinEnd and last-row logic: punt, as Del4 does
+                float buf[V::W];
+                for (int k = 0; k < V::W; k++) buf[k] = e.Del(i + k, j);
+                return V::LoadU(buf);
+            }
+        }
+
+        static Vec Extra(const QvEvaluator& e, int i, int j)
+        {
+            assert(0 <= i && i <= e.ReadLength() - V::W);
+            assert(0 <= j && j <= e.TemplateLength());
+            const float* table = e.MoveTable(QvMoveTables::EXTRA, j);
+            if (table != NULL)
+            {
+                return V::LoadU(&table[i]);
+            }
+            const QvModelParams& p = *e.params_;
+            float tplBase = e.tpl_[j];
+            return V::SelectEq(V::LoadU(&e.Features().SequenceAsFloat[i]), V::Set1(tplBase),
+                               Affine(p.Branch, p.BranchS, &e.Features().InsQv[i]),
+                               Affine(p.Nce, p.NceS, &e.Features().InsQv[i]));
+        }
+
+        static Vec Merge(const QvEvaluator& e, int i, int j)
+        {
+            assert(0 <= i && i <= e.ReadLength() - V::W);
+            assert(0 <= j && j < e.TemplateLength() - 1);
+            float tplBase = e.tpl_[j];
+            float tplBaseNext = e.tpl_[j + 1];
+            Vec noMerge = V::Set1(-FLT_MAX);
+            if (tplBase == tplBaseNext)
+            {
+                const float* table = e.MoveTable(QvMoveTables::MERGE, j);
+                if (table != NULL)
+                {
+                    return V::LoadU(&table[i]);
+                }
+                const QvModelParams& p = *e.params_;
+                int b = encodeTplBase(e.tpl_[j]);
+                return V::SelectEq(V::LoadU(&e.Features().SequenceAsFloat[i]), V::Set1(tplBase),
+                                   Affine(p.Merge[b], p.MergeS[b], &e.Features().MergeQv[i]),
+                                   noMerge);
+            }
+            else
+            {
+                return noMerge;
+            }
+        }
+    };
+
+    //
+    // The insertion cascade down (alpha) or up (beta) a block of n rows,
+    // four at a time exactly as SseRecursor does it: scores[1..n] (alpha)
+    // or scores[0..n-1] (beta) hold the other moves' contributions,
+    // scores[0] (scores[n]) the cell the cascade enters from.  Returns
+    // the least of the last four rows the cascade reaches, and the
+    // greatest of all n.
+    //
+    template<typename V, typename C>
+    inline void CascadeDown(float* scores, const float* insScores, int n,
+                            float* lastFourMin, float* max)
+    {
+        __m128 max4 = _mm_set_ps1(-FLT_MAX), score4 = max4;
+        for (int k = 0; k < n; k += 4)
+        {
+            score4 = CascadeDown4<C>(_mm_loadu_ps(&scores[k + 1]),
+                                     _mm_loadu_ps(&insScores[k]), scores[k]);
+            _mm_storeu_ps(&scores[k + 1], score4);
+            max4 = _mm_max_ps(max4, score4);
+        }
+        *lastFourMin = horizontalMin4(score4);
+        *max = horizontalMax4(max4);
+    }
+
+    template<typename V, typename C>
+    inline void CascadeUp(float* scores, const float* insScores, int n,
+                          float* lastFourMin, float* max)
+    {
+        __m128 max4 = _mm_set_ps1(-FLT_MAX), score4 = max4;
+        for (int k = n - 4; k >= 0; k -= 4)
+        {
+            score4 = CascadeUp4<C>(_mm_loadu_ps(&scores[k]),
+                                   _mm_loadu_ps(&insScores[k]), scores[k + 4]);
+            _mm_storeu_ps(&scores[k], score4);
+            max4 = _mm_max_ps(max4, score4);
+        }
+        *lastFourMin = horizontalMin4(score4);
+        *max = horizontalMax4(max4);
+    }
+
+    //
+    // SseRecursor::FillAlpha and FillBeta, striding W rows at a time
+    // through the rows the band already requires of each column.  The
+    // scalar preamble, and the speculative blocks past the required rows
+    // (which stop at the banding cutoff), remain four rows, as in
+    // SseRecursor: a band is often only a few blocks tall, and wider
+    // blocks there would fill---and so change---cells SseRecursor leaves
+    // empty.  The cells filled are exactly SseRecursor's.  As there,
+    // MergeMoves resolves the MERGE test at compile time.
+    //
+    template<typename V, bool MergeMoves, typename M, typename C>
+    INLINE_CALLEES void WideFillAlpha(const RecursorBase<M, QvEvaluator, C>& recursor,
+                       const QvEvaluator& e, const M& guide, M& alpha,
+                       int beginColumn, int endColumn)
+    {
+        typedef typename V::Vec Vec;
+        typedef WideCombiner<C, V> WC;
+        typedef WideQvMoves<V> Moves;
+        const int W = V::W;
+        float scoreDiff = recursor.Banding().ScoreDiff;
+
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+
+        int hintBeginRow = 0, hintEndRow = 0;
+        if (beginColumn > 0)
+        {
+            AlphaResumeHints(beginColumn - 1, alpha, scoreDiff, &hintBeginRow, &hintEndRow);
+            scoreDiff = recursor.NextScoreDiff(alpha, beginColumn - 1);
+        }
+
+        for (int j = beginColumn; j < endColumn; ++j)
+        {
+            int bandEndRow = I + 1;
+            if (!recursor.RangeGuide(j, guide, alpha, &hintBeginRow, &hintEndRow))
+            {
+                recursor.DiagonalBand(j, I, J, &hintBeginRow, &hintEndRow, &bandEndRow);
+            }
+
+            int requiredEndRow = (hintEndRow < I + 1) ? hintEndRow : I + 1;
+
+            float score = -FLT_MAX;
+            float thresholdScore = -FLT_MAX;
+            float maxScore = -FLT_MAX;
+
+            alpha.StartEditingColumn(j, hintBeginRow, hintEndRow);
+
+            int i;
+            int beginRow = hintBeginRow, endRow;
+            for (i = beginRow;
+                 (i == 0 || (I - i + 1) % 4 != 0) && i <= I;
+                 i++)
+            {
+                score = -FLT_MAX;
+                if (i == 0 && j == 0)
+                {
+                    score = 0.0f;
+                }
+                if (i > 0 && j > 0)
+                {
+                    score = C::Combine(score, alpha(i - 1, j - 1) + e.Inc(i - 1, j - 1));
+                }
+                if (MergeMoves && (i > 0 && j > 1))
+                {
+                    score = C::Combine(score, alpha(i - 1, j - 2) + e.Merge(i - 1, j - 2));
+                }
+                if (j > 0)
+                {
+                    score = C::Combine(score, alpha(i, j - 1) + e.Del(i, j - 1));
+                }
+                if (i > 0)
+                {
+                    score = C::Combine(score, alpha(i - 1, j) + e.Extra(i - 1, j));
+                }
+                alpha.Set(i, j, score);
+
+                if (score > maxScore)
+                {
+                    maxScore = score;
+                    thresholdScore = maxScore - scoreDiff;
+                }
+            }
+
+            assert(i > 0);
+            while (i < bandEndRow && (score >= thresholdScore || i < requiredEndRow))
+            {
+                float insScores[W], scores[W + 1];
+                int n;
+                if (i + W <= requiredEndRow)
+                {
+                    Vec scoreW = V::Set1(-FLT_MAX);
+                    if (j > 0)
+                    {
+                        scoreW = WC::Combine(scoreW, V::Add(V::Get(alpha, i - 1, j - 1),
+                                                            Moves::Inc(e, i - 1, j - 1)));
+                    }
+                    if (MergeMoves && j >= 2)
+                    {
+                        scoreW = WC::Combine(scoreW, V::Add(V::Get(alpha, i - 1, j - 2),
+                                                            Moves::Merge(e, i - 1, j - 2)));
+                    }
+                    if (j > 0)
+                    {
+                        scoreW = WC::Combine(scoreW, V::Add(V::Get(alpha, i, j - 1),
+                                                            Moves::Del(e, i, j - 1)));
+                    }
+                    V::StoreU(insScores, Moves::Extra(e, i - 1, j));
+                    V::StoreU(&scores[1], scoreW);
+                    n = W;
+                }
+                else
+                {
+                    __m128 score4 = _mm_set_ps1(-FLT_MAX);
+                    if (j > 0)
+                    {
+                        score4 = C::Combine4(score4, _mm_add_ps(alpha.Get4(i - 1, j - 1),
+                                                                e.Inc4(i - 1, j - 1)));
+                    }
+                    if (MergeMoves && j >= 2)
+                    {
+                        score4 = C::Combine4(score4, _mm_add_ps(alpha.Get4(i - 1, j - 2),
+                                                                e.Merge4(i - 1, j - 2)));
+                    }
+                    if (j > 0)
+                    {
+                        score4 = C::Combine4(score4, _mm_add_ps(alpha.Get4(i, j - 1),
+                                                                e.Del4(i, j - 1)));
+                    }
+                    _mm_storeu_ps(insScores, e.Extra4(i - 1, j));
+                    _mm_storeu_ps(&scores[1], score4);
+                    n = 4;
+                }
+
+                // Extra
+                float potentialNewMax;
+                scores[0] = alpha.Get(i - 1, j);
+                CascadeDown<V, C>(scores, insScores, n, &score, &potentialNewMax);
+                for (int k = 0; k < n; k += 4)
+                {
+                    alpha.Set4(i + k, j, _mm_loadu_ps(&scores[1 + k]));
+                }
+                if (potentialNewMax > maxScore)
+                {
+                    maxScore = potentialNewMax;
+                    thresholdScore = maxScore - scoreDiff;
+                }
+                i += n;
+            }
+
+            endRow = i;
+            alpha.FinishEditingColumn(j, beginRow, endRow);
+
+            hintEndRow = endRow;
+            for (i = beginRow; i < endRow && alpha(i, j) < thresholdScore; ++i);
+            hintBeginRow = i;
+
+            scoreDiff = recursor.NextScoreDiff(alpha, j);
+        }
+    }
+
+    template<typename V, bool MergeMoves, typename M, typename C>
+    INLINE_CALLEES void WideFillBeta(const RecursorBase<M, QvEvaluator, C>& recursor,
+                      const QvEvaluator& e, const M& guide, M& beta,
+                      int beginColumn, int endColumn)
+    {
+        typedef typename V::Vec Vec;
+        typedef WideCombiner<C, V> WC;
+        typedef WideQvMoves<V> Moves;
+        const int W = V::W;
+        float scoreDiff = recursor.Banding().ScoreDiff;
+
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+
+        int hintBeginRow = I + 1, hintEndRow = I + 1;
+        if (endColumn <= J)
+        {
+            BetaResumeHints(endColumn, beta, scoreDiff, &hintBeginRow, &hintEndRow);
+            scoreDiff = recursor.NextScoreDiff(beta, endColumn);
+        }
+
+        for (int j = endColumn - 1; j >= beginColumn; --j)
+        {
+            recursor.RangeGuide(j, guide, beta, &hintBeginRow, &hintEndRow);
+
+            int requiredBeginRow = (hintBeginRow > 0) ? hintBeginRow : 0;
+
+            float score = -FLT_MAX;
+            float thresholdScore = -FLT_MAX;
+            float maxScore = -FLT_MAX;
+
+            beta.StartEditingColumn(j, hintBeginRow, hintEndRow);
+
+            int i, beginRow, endRow = hintEndRow;
+            for (i = endRow - 1;
+                 (i == I || (i + 1) % 4 != 0) && i >= 0;
+                 i--)
+            {
+                score = -FLT_MAX;
+                if (i == I && j == J)
+                {
+                    score = 0.0f;
+                }
+                if (i < I && j < J)
+                {
+                    score = C::Combine(score, beta(i + 1, j + 1) + e.Inc(i, j));
+                }
+                if (MergeMoves && j < J - 1 && i < I)
+                {
+                    score = C::Combine(score, beta(i + 1, j + 2) + e.Merge(i, j));
+                }
+                if (j < J)
+                {
+                    score = C::Combine(score, beta(i, j + 1) + e.Del(i, j));
+                }
+                if (i < I)
+                {
+                    score = C::Combine(score, beta(i + 1, j) + e.Extra(i, j));
+                }
+                beta.Set(i, j, score);
+
+                if (score > maxScore)
+                {
+                    maxScore = score;
+                    thresholdScore = maxScore - scoreDiff;
+                }
+            }
+
+            // i is the top row of the next four-row block; a W-row
+            // block ends where it would.
+            i = i - 3;
+            while (i >= 0 && (score >= thresholdScore || i >= requiredBeginRow))
+            {
+                float insScores[W], scores[W + 1];
+                int n;
+                int top = i + 4 - W;
+                if (top >= requiredBeginRow)
+                {
+                    Vec scoreW = V::Set1(-FLT_MAX);
+                    if (top < I && j < J)
+                    {
+                        scoreW = WC::Combine(scoreW, V::Add(V::Get(beta, top + 1, j + 1),
+                                                            Moves::Inc(e, top, j)));
+                    }
+                    if (MergeMoves && j < J - 1 && top < I)
+                    {
+                        scoreW = WC::Combine(scoreW, V::Add(V::Get(beta, top + 1, j + 2),
+                                                            Moves::Merge(e, top, j)));
+                    }
+                    if (j < J)
+                    {
+                        scoreW = WC::Combine(scoreW, V::Add(V::Get(beta, top, j + 1),
+                                                            Moves::Del(e, top, j)));
+                    }
+                    V::StoreU(insScores, Moves::Extra(e, top, j));
+                    V::StoreU(scores, scoreW);
+                    n = W;
+                }
+                else
+                {
+                    __m128 score4 = _mm_set_ps1(-FLT_MAX);
+                    if (i < I && j < J)
+                    {
+                        score4 = C::Combine4(score4, _mm_add_ps(beta.Get4(i + 1, j + 1),
+                                                                e.Inc4(i, j)));
+                    }
+                    if (MergeMoves && j < J - 1 && i < I)
+                    {
+                        score4 = C::Combine4(score4, _mm_add_ps(beta.Get4(i + 1, j + 2),
+                                                                e.Merge4(i, j)));
+                    }
+                    if (j < J)
+                    {
+                        score4 = C::Combine4(score4, _mm_add_ps(beta.Get4(i, j + 1),
+                                                                e.Del4(i, j)));
+                    }
+                    _mm_storeu_ps(insScores, e.Extra4(i, j));
+                    _mm_storeu_ps(scores, score4);
+                    n = 4;
+                    top = i;
+                }
+
+                // Extra
+                float potentialNewMax;
+                scores[n] = beta.Get(top + n, j);
+                CascadeUp<V, C>(scores, insScores, n, &score, &potentialNewMax);
+                for (int k = 0; k < n; k += 4)
+                {
+                    beta.Set4(top + k, j, _mm_loadu_ps(&scores[k]));
+                }
+                if (potentialNewMax > maxScore)
+                {
+                    maxScore = potentialNewMax;
+                    thresholdScore = maxScore - scoreDiff;
+                }
+                i = top - 4;
+            }
+
+            beginRow = i + 4;
+            beta.FinishEditingColumn(j, beginRow, endRow);
+
+            hintBeginRow = beginRow;
+            for (i = endRow;
+                 i > beginRow && beta(i - 1, j) < thresholdScore;
+                 i--);
+            hintEndRow = i;
+
+            scoreDiff = recursor.NextScoreDiff(beta, j);
+        }
+    }
+}}
@@ -0,0 +1,91 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+#include <ConsensusCore/Matrix/DenseMatrix.hpp>
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/detail/Combiner.hpp>
+#include <ConsensusCore/Quiver/detail/RecursorBase.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+    //
+    // AVX2 / AVX-512 counterparts of SseRecursor's FillAlpha and
+    // FillBeta over the column range [beginColumn, endColumn).  Each
+    // returns false, doing nothing, if there is no kernel for the
+    // matrix/evaluator/combiner combination (or for the target in this
+    // build); the caller then falls back to SSE.  The kernels live in
+    // SseRecursorAvx2.cpp and SseRecursorAvx512.cpp.  There are none
+    // for ExtendAlpha, ExtendBeta or LinkAlphaBeta, which stay SSE3.
+    //
+
+#define WIDE_KERNEL(Name)                                               \
+    template<typename M, typename E, typename C>                        \
+    bool Name(const RecursorBase<M, E, C>& recursor, const E& e,        \
+              const M& guide, M& matrix, int beginColumn, int endColumn) \
+    {                                                                   \
+        return false;                                                   \
+    }
+
+    WIDE_KERNEL(FillAlphaAvx2)
+    WIDE_KERNEL(FillBetaAvx2)
+    WIDE_KERNEL(FillAlphaAvx512)
+    WIDE_KERNEL(FillBetaAvx512)
+
+#undef WIDE_KERNEL
+
+#define WIDE_KERNEL_SPECIALIZATION(Name, M, C)                          \
+    template<>                                                          \
+    bool Name<M, QvEvaluator, C>(const RecursorBase<M, QvEvaluator, C>& recursor, \
+                                 const QvEvaluator& e, const M& guide,  \
+                                 M& matrix, int beginColumn, int endColumn)
+
+#define WIDE_KERNEL_SPECIALIZATIONS(M, C)                               \
+    WIDE_KERNEL_SPECIALIZATION(FillAlphaAvx2, M, C);                    \
+    WIDE_KERNEL_SPECIALIZATION(FillBetaAvx2, M, C);                     \
+    WIDE_KERNEL_SPECIALIZATION(FillAlphaAvx512, M, C);                  \
+    WIDE_KERNEL_SPECIALIZATION(FillBetaAvx512, M, C)
+
+    WIDE_KERNEL_SPECIALIZATIONS(DenseMatrix,  ViterbiCombiner);
+    WIDE_KERNEL_SPECIALIZATIONS(SparseMatrix, ViterbiCombiner);
+    WIDE_KERNEL_SPECIALIZATIONS(SparseMatrix, SumProductCombiner);
+
+#undef WIDE_KERNEL_SPECIALIZATIONS
+}}
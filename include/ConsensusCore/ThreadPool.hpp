@@ -0,0 +1,114 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+#ifdef SWIG
+#error "ThreadPool.hpp is not an API-facing header!"
+#endif  // SWIG
+
+#include <boost/noncopyable.hpp>
+#include <pthread.h>
+#include <vector>
+
+namespace ConsensusCore {
+namespace detail {
+
+    /// \brief A unit of work over the index range [0, n) that a
+    ///        ThreadPool can split into contiguous chunks.
+    ///
+    /// Run(begin, end) is called concurrently on disjoint ranges, so
+    /// implementations must only touch state owned by those indices.
+    /// Implementations must not let exceptions escape.
+    class ParallelTask
+    {
+    public:
+        virtual ~ParallelTask() {}
+        virtual void Run(int begin, int end) = 0;
+    };
+
+    /// \brief A fixed-size pool of worker threads.
+    ///
+    /// ParallelFor partitions [0, n) statically into NumThreads()
+    /// contiguous chunks of near-equal size, so the assignment of
+    /// indices to chunks depends only on n and the thread count.  The
+    /// calling thread executes chunk 0 itself and blocks until all
+    /// chunks are done.
+    ///
+    /// A pool is not reentrant: ParallelFor must not be called
+    /// concurrently, nor from within a task.
+    class ThreadPool : private boost::noncopyable
+    {
+    public:
+        explicit ThreadPool(int numThreads);
+        ~ThreadPool();
+
+        int NumThreads() const;
+
+        void ParallelFor(int n, ParallelTask& task);
+
+    private:
+        static void* WorkerEntry(void* arg);
+        void WorkerLoop(int workerIndex);
+        // Shut down and join the first numStarted workers
+        void StopWorkers(size_t numStarted);
+        void RunChunk(int chunk);
+
+    private:
+        struct WorkerArg
+        {
+            ThreadPool* Pool;
+            int Index;
+        };
+
+        int numThreads_;
+        std::vector<pthread_t> workers_;
+        std::vector<WorkerArg> workerArgs_;
+
+        pthread_mutex_t mutex_;
+        pthread_cond_t workReady_;
+        pthread_cond_t workDone_;
+
+        // State of the current ParallelFor, guarded by mutex_
+        ParallelTask* task_;
+        int n_;
+        unsigned long generation_;  // NOLINT
+        int pendingWorkers_;
+        bool failed_;
+        bool shutdown_;
+    };
+}}
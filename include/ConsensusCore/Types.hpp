@@ -71,6 +71,7 @@ namespace detail {
     class SumProductCombiner;
     class SdpRangeFinder;
     class PoaGraphImpl;
+    class ThreadPool;
 }}
 
 
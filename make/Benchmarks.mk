@@ -0,0 +1,29 @@
+include make/Config.mk
+include make/Defs.mk
+
+#
+# Each src/Benchmarks/Benchmark*.cpp is a standalone program; the
+# remaining sources there (timing, allocation counting, etc.) are
+# linked into all of them.
+#
+VPATH                   := $(PROJECT_ROOT)/src/Benchmarks
+BENCHMARK_BUILD_ROOT    := $(BUILD_ROOT)/Benchmarks
+BENCHMARK_ALL_SRCS      := $(notdir $(shell find $(PROJECT_ROOT)/src/Benchmarks -name "*.cpp" | grep -v '\#'))
+BENCHMARK_SRCS          := $(filter Benchmark%.cpp, $(BENCHMARK_ALL_SRCS))
+BENCHMARK_SUPPORT_SRCS  := $(filter-out Benchmark%.cpp, $(BENCHMARK_ALL_SRCS))
+BENCHMARK_SUPPORT_OBJS  := $(addprefix $(BENCHMARK_BUILD_ROOT)/,$(BENCHMARK_SUPPORT_SRCS:.cpp=.o))
+BENCHMARK_EXECUTABLES   := $(addprefix $(BENCHMARK_BUILD_ROOT)/,$(BENCHMARK_SRCS:.cpp=))
+
+run-benchmarks: $(BENCHMARK_EXECUTABLES)
+	@for b in $(BENCHMARK_EXECUTABLES); do echo "== $$(basename $$b)"; $$b || exit 1; done
+
+benchmarks: $(BENCHMARK_EXECUTABLES)
+
+$(BENCHMARK_BUILD_ROOT)/%.o : %.cpp $(CXX_LIB)
+	-mkdir -p $(BENCHMARK_BUILD_ROOT)
+	$(CXX) -c $< -o $@
+
+$(BENCHMARK_EXECUTABLES): % : %.o $(BENCHMARK_SUPPORT_OBJS) $(CXX_LIB)
+	$(CXX) $< $(BENCHMARK_SUPPORT_OBJS) $(CXX_LIB) -lpthread -o $@
+
+.PHONY: run-benchmarks benchmarks
@@ -0,0 +1,124 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+
+// Author: David Alexander
+
+//
+// Matrix entries used, and flip-flops needed, by FillAlphaBeta under
+// the banding options: the score-difference band alone, with the
+// diagonal band confining the unguided first pass, and with the
+// dynamically adjusted score difference as well; then with the first
+// pass guided by an alignment path (here the read's Needleman-Wunsch
+// alignment, computed outside the timing).
+//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Align/PairwiseAlignment.hpp>
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SseRecursor.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+static void BenchmarkBanding(int tplLength, float errorRate, int nReads)
+{
+    RNG rng(42);
+    QuiverConfig config = BenchmarkConfig();
+    std::string tpl = RandomSequence(rng, tplLength);
+    std::vector<QvEvaluator> evaluators;
+    std::vector<std::vector<int> > guidePaths;
+    for (int k = 0; k < nReads; k++)
+    {
+        std::string readSeq = NoisyCopy(rng, tpl, errorRate);
+        Read read(QvSequenceFeatures(readSeq), "anonymous", "unknown");
+        evaluators.push_back(QvEvaluator(read, tpl, config.QvParams));
+        PairwiseAlignment* alignment = Align(tpl, readSeq);
+        guidePaths.push_back(TargetToQueryPositions(*alignment));
+        delete alignment;
+    }
+
+    float scoreDiff = config.Banding.ScoreDiff;
+    const char* names[] = { "ScoreDiff", "+diagonal", "+dynamic", "guided" };
+    BandingOptions bandings[] = { BandingOptions(0, scoreDiff),
+                                  BandingOptions(4, scoreDiff),
+                                  BandingOptions(4, scoreDiff, 0.5, 6),
+                                  BandingOptions(4, scoreDiff) };
+    for (int b = 0; b < 4; b++)
+    {
+        SparseSseQvRecursor recursor(config.MovesAvailable, bandings[b]);
+        double usedEntries = 0, flipFlops = 0, score = 0;
+        int mismatches = 0;
+        double start = WallSeconds();
+        for (int k = 0; k < nReads; k++)
+        {
+            const QvEvaluator& ev = evaluators[k];
+            SparseMatrix alpha(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+            SparseMatrix beta(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+            try {
+                flipFlops += (b == 3) ?
+                    recursor.FillAlphaBeta(ev, guidePaths[k], alpha, beta) :
+                    recursor.FillAlphaBeta(ev, alpha, beta);
+                usedEntries += alpha.UsedEntries() + beta.UsedEntries();
+                score += beta(0, 0);
+            }
+            catch (AlphaBetaMismatchException& e)
+            {
+                mismatches++;
+            }
+        }
+        double elapsed = (WallSeconds() - start) / nReads;
+
+        printf("tpl=%6d  err=%4.2f  %-10s %8.3f ms  entries=%10.0f  flipflops=%5.2f"
+               "  mismatches=%d  (mean score %g)\n",
+               tplLength, errorRate, names[b], 1e3 * elapsed,
+               usedEntries / nReads, flipFlops / nReads, mismatches, score / nReads);
+    }
+}
+
+int main()
+{
+    BenchmarkBanding(1000, 0.05f, 100);
+    BenchmarkBanding(1000, 0.15f, 100);
+    BenchmarkBanding(5000, 0.15f, 20);
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of the consensus QVs, over a 2 kb template at 20x and 100x
+// coverage by 500 bp reads (both strands, 5% error), next to the
+// cost of the refinement that precedes them.
+//
+// "per-mutation" is the original computation, one FastScore call per
+// unique single-base mutation; "engine" is ConsensusQVs, which scores
+// blocks of mutations read by read, with 1 and 4 threads.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
+#include <ConsensusCore/Quiver/MutationEnumerator.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QuiverConsensus.hpp>
+#include <ConsensusCore/Sequence.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+static const int TEMPLATE_LENGTH = 2000;
+static const int READ_LENGTH = 500;
+
+static void AddReads(RNG& rng, const std::string& truth, int coverage,
+                     SparseSseQvMultiReadMutationScorer* mms)
+{
+    int nReads = coverage * truth.length() / READ_LENGTH;
+    for (int i = 0; i < nReads; i++)
+    {
+        int start = boost::random::uniform_int_distribution<>(
+            0, truth.length() - READ_LENGTH)(rng);
+        std::string seq = NoisyCopy(rng, truth.substr(start, READ_LENGTH), 0.05f);
+        StrandEnum strand = (i % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        mms->AddRead(Benchmarks::MappedRead(strand == FORWARD_STRAND ? seq : ReverseComplement(seq),
+                                            strand, start, start + READ_LENGTH));
+    }
+}
+
+static void Benchmark(int coverage)
+{
+    RNG rng(42);
+    std::string truth = RandomSequence(rng, TEMPLATE_LENGTH);
+    QuiverConfigTable configs;
+    configs.InsertDefault(BenchmarkConfig());
+
+    // Refinement, from a draft with 1% error, for scale
+    SparseSseQvMultiReadMutationScorer mms(configs, NoisyCopy(rng, truth, 0.01f));
+    AddReads(rng, truth, coverage, &mms);
+    double start = WallSeconds();
+    RefineConsensus(mms);
+    double refine = WallSeconds() - start;
+
+    start = WallSeconds();
+    UniqueSingleBaseMutationEnumerator enumerator(mms.Template());
+    double checksum = 0.0;
+    for (int pos = 0; pos < mms.TemplateLength(); pos++)
+    {
+        foreach (const Mutation& m, enumerator.Mutations(pos, pos + 1))
+        {
+            checksum += exp(mms.FastScore(m));
+        }
+    }
+    double perMutation = WallSeconds() - start;
+
+    start = WallSeconds();
+    std::vector<int> QVs = ConsensusQVs(mms);
+    double engine = WallSeconds() - start;
+
+    start = WallSeconds();
+    std::vector<int> threadedQVs = ConsensusQVs(mms, 4);
+    double threaded = WallSeconds() - start;
+
+    printf("coverage=%4dx  reads=%4d  refine=%8.1f ms  per-mutation=%8.1f ms  "
+           "engine=%8.1f ms (%.2fx)  engine/4 threads=%8.1f ms  (checksum %g)%s\n",
+           coverage, mms.NumReads(), 1e3 * refine, 1e3 * perMutation,
+           1e3 * engine, perMutation / engine, 1e3 * threaded, checksum,
+           QVs == threadedQVs ? "" : "  MISMATCH");
+}
+
+int main()
+{
+    Benchmark(20);
+    Benchmark(100);
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of the insertion cascade through a four-row block, row by row
+// (the original code) and as an in-register scan, for each combiner.
+// Successive blocks are chained through the boundary cell, as they
+// are down a column.
+//
+
+#include <cstdio>
+#include <vector>
+
+#include <ConsensusCore/Quiver/detail/Combiner.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;          // NOLINT
+using namespace ConsensusCore::detail;  // NOLINT
+using namespace Benchmarks;             // NOLINT
+
+typedef __m128 (*CascadeFunction)(__m128, __m128, float);
+
+static double TimeCascade(CascadeFunction cascade,
+                          const std::vector<float>& scores,
+                          const std::vector<float>& insScores,
+                          int nBlocks, float* checksum)
+{
+    int n = scores.size() / 4;
+    float above = 0.0f, sum = 0.0f;
+    double start = WallSeconds();
+    for (int b = 0; b < nBlocks; b++)
+    {
+        int k = 4 * (b % n);
+        __m128 y4 = cascade(_mm_loadu_ps(&scores[k]), _mm_loadu_ps(&insScores[k]), above);
+        above = _mm_cvtss_f32(_mm_shuffle_ps(y4, y4, _MM_SHUFFLE(3, 3, 3, 3)));
+        sum += horizontalMin4(y4);
+        above = (b % n == n - 1) ? 0.0f : above;
+    }
+    *checksum = sum;
+    return (WallSeconds() - start) / nBlocks;
+}
+
+template<typename C>
+static void BenchmarkCombiner(const char* name)
+{
+    RNG rng(42);
+    std::vector<float> scores, insScores;
+    for (int k = 0; k < 4 * 256; k++)
+    {
+        scores.push_back(-(k % 4) - static_cast<float>(rng() % 1000) / 100);
+        insScores.push_back(-static_cast<float>(rng() % 800) / 100);
+    }
+    const int nBlocks = 20000000;
+
+    float scalarSum, scanSum;
+    double scalar = TimeCascade(ScalarCascadeDown4<C>, scores, insScores, nBlocks, &scalarSum);
+    double scan = TimeCascade(ScanCascadeDown4<C>, scores, insScores, nBlocks, &scanSum);
+    printf("%-12s  row by row=%6.2f ns  scan=%6.2f ns  speedup=%5.2fx  (checksums %g, %g)\n",
+           name, 1e9 * scalar, 1e9 * scan, scalar / scan, scalarSum, scanSum);
+}
+
+int main()
+{
+    BenchmarkCombiner<ViterbiCombiner>("Viterbi");
+    BenchmarkCombiner<SumProductCombiner>("SumProduct");
+    return 0;
+}
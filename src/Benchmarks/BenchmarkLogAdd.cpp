@@ -0,0 +1,137 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost and accuracy of logAdd4 against the exp_ps/log_ps formulation
+// it replaced, and the cost of a SumProduct fill relative to Viterbi.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SseRecursor.hpp>
+#include <ConsensusCore/Quiver/detail/SseMath.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;          // NOLINT
+using namespace ConsensusCore::detail;  // NOLINT
+using namespace Benchmarks;             // NOLINT
+
+static __m128 CephesLogAdd4(__m128 aa, __m128 bb)
+{
+    __m128 max = _mm_max_ps(aa, bb);
+    __m128 min = _mm_min_ps(aa, bb);
+    __m128 diff = _mm_sub_ps(min, max);
+    return _mm_add_ps(max, log_ps(_mm_add_ps(ones, exp_ps(diff))));
+}
+
+typedef __m128 (*LogAddFunction)(__m128, __m128);
+
+static void BenchmarkLogAdd(const char* name, LogAddFunction logAdd4Fn,
+                            const std::vector<float>& xs, float maxDiff)
+{
+    const int nCalls = 20000000;
+    int n = xs.size() / 4;
+    __m128 acc = _mm_setzero_ps();
+    double start = WallSeconds();
+    for (int k = 0; k < nCalls; k++)
+    {
+        __m128 x4 = _mm_loadu_ps(&xs[4 * (k % n)]);
+        acc = _mm_add_ps(acc, logAdd4Fn(x4, _mm_set_ps1(-1.0f)));
+    }
+    double elapsed = (WallSeconds() - start) / nCalls;
+
+    double maxError = 0;
+    for (float d = 0; d <= 30; d += 1e-4f)
+    {
+        float lanes[4];
+        _mm_storeu_ps(lanes, logAdd4Fn(_mm_set_ps1(-1.0f), _mm_set_ps1(-1.0f - d)));
+        double expected = -1.0 + std::log(1.0 + std::exp(-static_cast<double>(d)));
+        maxError = std::max(maxError, std::fabs(lanes[0] - expected));
+    }
+    printf("%-8s |diff| <= %4.0f: %6.2f ns/call   max abs error %.2g   (checksum %g)\n",
+           name, maxDiff, 1e9 * elapsed, maxError, horizontalMax4(acc));
+}
+
+template<typename R>
+static double FillTime(int tplLength, int nFills)
+{
+    RNG rng(42);
+    QuiverConfig config = BenchmarkConfig();
+    std::string tpl = RandomSequence(rng, tplLength);
+    Read read(QvSequenceFeatures(NoisyCopy(rng, tpl, 0.05f)), "anonymous", "unknown");
+    QvEvaluator ev(read, tpl, config.QvParams);
+    R recursor(config.MovesAvailable, config.Banding);
+    double start = WallSeconds();
+    for (int k = 0; k < nFills; k++)
+    {
+        SparseMatrix alpha(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+        SparseMatrix beta(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+        recursor.FillAlphaBeta(ev, alpha, beta);
+    }
+    return (WallSeconds() - start) / nFills;
+}
+
+int main()
+{
+    // Operands within a few nats of each other, and far apart
+    RNG rng(42);
+    float spreads[] = { 8.0f, 40.0f };
+    for (int s = 0; s < 2; s++)
+    {
+        std::vector<float> xs;
+        for (int k = 0; k < 4 * 1024; k++)
+        {
+            xs.push_back(-1.0f - spreads[s] * (rng() % 10000) / 10000.0f);
+        }
+        BenchmarkLogAdd("cephes", CephesLogAdd4, xs, spreads[s]);
+        BenchmarkLogAdd("logAdd4", logAdd4, xs, spreads[s]);
+    }
+
+    double viterbi = FillTime<SparseSseQvRecursor>(5000, 40);
+    double sumProduct = FillTime<SparseSseQvSumProductRecursor>(5000, 40);
+    printf("FillAlphaBeta, 5kb: Viterbi %.2f ms, SumProduct %.2f ms (%.2fx)\n",
+           1e3 * viterbi, 1e3 * sumProduct, sumProduct / viterbi);
+    return 0;
+}
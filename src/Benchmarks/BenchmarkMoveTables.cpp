@@ -0,0 +1,136 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of QvEvaluator's precomputed move-score tables: FillAlphaBeta
+// and MutationScorer::ScoreMutation with and without them, under each
+// SIMD target, and the tables' size relative to the matrices'.
+//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Quiver/MutationScorer.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
+#include <ConsensusCore/Quiver/SseRecursor.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+template<typename R>
+static double FillTime(const R& recursor, const QvEvaluator& ev, int nFills, int* matrixEntries)
+{
+    double start = WallSeconds();
+    for (int k = 0; k < nFills; k++)
+    {
+        SparseMatrix alpha(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+        SparseMatrix beta(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+        recursor.FillAlphaBeta(ev, alpha, beta);
+        *matrixEntries = alpha.AllocatedEntries() + beta.AllocatedEntries();
+    }
+    return (WallSeconds() - start) / nFills;
+}
+
+template<typename R>
+static double ScoreTime(const R& recursor, const QvEvaluator& ev,
+                        const std::vector<Mutation>& mutations)
+{
+    MutationScorer<R> scorer(ev, recursor);
+    double start = WallSeconds();
+    for (size_t k = 0; k < mutations.size(); k++)
+    {
+        scorer.ScoreMutation(mutations[k]);
+    }
+    return (WallSeconds() - start) / mutations.size();
+}
+
+template<typename R>
+static void BenchmarkTemplateLength(const char* recursorName, int tplLength, int nFills)
+{
+    RNG rng(42);
+    QuiverConfig config = BenchmarkConfig();
+    std::string tpl = RandomSequence(rng, tplLength);
+    std::string readSeq = NoisyCopy(rng, tpl, 0.05f);
+    Read read(QvSequenceFeatures(readSeq), "anonymous", "unknown");
+    QvEvaluator plain(read, tpl, config.QvParams);
+    QvEvaluator tables(read, tpl, config.QvParams, true, true, true);
+
+    std::vector<Mutation> mutations;
+    for (int pos = 0; pos < tplLength; pos += 7)
+    {
+        mutations.push_back(Mutation(SUBSTITUTION, pos, tpl[pos] == 'A' ? 'C' : 'A'));
+        mutations.push_back(Mutation(INSERTION, pos, 'G'));
+        mutations.push_back(Mutation(DELETION, pos, '-'));
+    }
+
+    SimdTarget targets[] = { SSE3_TARGET, AVX2_TARGET };
+    for (int t = 0; t < 2; t++)
+    {
+        if (!IsSimdTargetSupported(targets[t])) continue;
+
+        R recursor(config.MovesAvailable, config.Banding);
+        recursor.Target(targets[t]);
+        int matrixEntries = 0;
+        double fillPlain  = FillTime(recursor, plain, nFills, &matrixEntries);
+        double fillTables = FillTime(recursor, tables, nFills, &matrixEntries);
+        double scorePlain  = ScoreTime(recursor, plain, mutations);
+        double scoreTables = ScoreTime(recursor, tables, mutations);
+
+        printf("%-10s tpl=%6d %-6s  fill %7.3f -> %7.3f ms (%4.2fx)  "
+               "score %6.2f -> %6.2f usec (%4.2fx)  tables/matrices %4.2f\n",
+               recursorName, tplLength, SimdTargetName(targets[t]),
+               1e3 * fillPlain, 1e3 * fillTables, fillPlain / fillTables,
+               1e6 * scorePlain, 1e6 * scoreTables, scorePlain / scoreTables,
+               static_cast<double>(tables.AllocatedMoveTableEntries()) / matrixEntries);
+    }
+}
+
+int main()
+{
+    BenchmarkTemplateLength<SparseSseQvRecursor>("Viterbi", 1000, 200);
+    BenchmarkTemplateLength<SparseSseQvRecursor>("Viterbi", 10000, 20);
+    BenchmarkTemplateLength<SparseSseQvSumProductRecursor>("SumProduct", 1000, 200);
+    BenchmarkTemplateLength<SparseSseQvSumProductRecursor>("SumProduct", 10000, 20);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+
+// Author: David Alexander
+
+//
+// Time and heap allocations to add each read to a POA graph, the
+// total time to build the graph and find its consensus, and the heap
+// allocations held by the finished graph (counted by copying it), for
+// a few template lengths and read counts; the last few with the SSE2
+// column kernel off.
+//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Poa/PoaConsensus.hpp>
+#include <ConsensusCore/Poa/PoaGraph.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+static void BenchmarkPoa(int tplLength, float errorRate, int nReads, AlignMode mode,
+                         bool vectorized = true)
+{
+    RNG rng(42);
+    std::string tpl = RandomSequence(rng, tplLength);
+    std::vector<std::string> reads;
+    for (int k = 0; k < nReads; k++)
+    {
+        reads.push_back(NoisyCopy(rng, tpl, errorRate));
+    }
+
+    AlignConfig config = DefaultPoaConfig(mode);
+    PoaGraph pg;
+    pg.VectorizedAlignment(vectorized);
+    long addAllocations = AllocationCount();  // NOLINT
+    double start = WallSeconds();
+    for (int k = 0; k < nReads; k++)
+    {
+        pg.AddRead(reads[k], config);
+    }
+    double addTime = (WallSeconds() - start) / nReads;
+    addAllocations = AllocationCount() - addAllocations;
+
+    double cssStart = WallSeconds();
+    const PoaConsensus* pc = pg.FindConsensus(config);
+    double cssTime = WallSeconds() - cssStart;
+    double totalTime = WallSeconds() - start;
+
+    long allocations = AllocationCount();
+    PoaGraph copy(pg);
+    allocations = AllocationCount() - allocations;
+
+    printf("tpl=%5d  err=%4.2f  reads=%4d  mode=%d  %s  add %8.3f ms/read (%7.1f allocations)"
+           "  consensus %7.3f ms  total %9.1f ms  graph allocations=%8ld  (css length %d)\n",
+           tplLength, errorRate, nReads, mode, vectorized ? "sse2  " : "scalar",
+           1e3 * addTime, static_cast<double>(addAllocations) / nReads, 1e3 * cssTime,
+           1e3 * totalTime, allocations, static_cast<int>(pc->Sequence.length()));
+    delete pc;
+}
+
+int main()
+{
+    BenchmarkPoa(500, 0.10f, 20, GLOBAL);
+    BenchmarkPoa(500, 0.10f, 100, GLOBAL);
+    BenchmarkPoa(1000, 0.15f, 30, SEMIGLOBAL);
+    BenchmarkPoa(1000, 0.15f, 30, LOCAL);
+
+    // Scaling with read count
+    int readCounts[] = { 50, 200, 1000 };
+    for (int k = 0; k < 3; k++)
+    {
+        BenchmarkPoa(200, 0.05f, readCounts[k], GLOBAL);
+    }
+    for (int k = 0; k < 3; k++)
+    {
+        BenchmarkPoa(200, 0.05f, readCounts[k], LOCAL);
+    }
+
+    // Scalar column kernel, for comparison
+    BenchmarkPoa(500, 0.10f, 100, GLOBAL, false);
+    BenchmarkPoa(1000, 0.15f, 30, SEMIGLOBAL, false);
+    BenchmarkPoa(1000, 0.15f, 30, LOCAL, false);
+    BenchmarkPoa(200, 0.05f, 1000, GLOBAL, false);
+    return 0;
+}
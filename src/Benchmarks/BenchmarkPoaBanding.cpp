@@ -0,0 +1,117 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+
+// Author: David Alexander
+
+//
+// Time and peak memory to add long (20 kb) reads to a POA graph, where
+// each read is aligned within a band: around the diagonal of the
+// current consensus (GLOBAL's default), or around the k-mer anchors a
+// KmerRangeFinder chains between the read and the consensus.  For the
+// latter the time spent finding anchors is shown separately.  (Peak RSS
+// only grows, so later rows show the high-water mark so far.)
+//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Poa/PoaConsensus.hpp>
+#include <ConsensusCore/Poa/PoaGraph.hpp>
+#include <ConsensusCore/Poa/RangeFinder.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+class TimedKmerRangeFinder : public detail::KmerRangeFinder
+{
+public:
+    TimedKmerRangeFinder() : Seconds(0) {}
+
+    double Seconds;
+
+protected:
+    detail::SdpAnchorVector FindAnchors(const std::string& consensusSequence,
+                                        const std::string& readSequence)
+    {
+        double start = WallSeconds();
+        detail::SdpAnchorVector anchors =
+            detail::KmerRangeFinder::FindAnchors(consensusSequence, readSequence);
+        Seconds += WallSeconds() - start;
+        return anchors;
+    }
+};
+
+static void BenchmarkPoaBanding(int tplLength, float errorRate, int nReads,
+                                AlignMode mode, bool useKmers)
+{
+    static const char* modeNames[] = { "GLOBAL", "SEMIGLOBAL", "LOCAL" };
+    RNG rng(42);
+    std::string tpl = RandomSequence(rng, tplLength);
+    AlignConfig config = DefaultPoaConfig(mode);
+    TimedKmerRangeFinder kmerRangeFinder;
+    detail::SdpRangeFinder* rangeFinder = useKmers ? &kmerRangeFinder : NULL;
+    PoaGraph pg;
+    pg.AddRead(NoisyCopy(rng, tpl, errorRate), config, rangeFinder);
+
+    printf("%s, %s bands\n", modeNames[mode], useKmers ? "k-mer" : "default");
+    for (int k = 1; k < nReads; k++)
+    {
+        std::string read = NoisyCopy(rng, tpl, errorRate);
+        kmerRangeFinder.Seconds = 0;
+        double start = WallSeconds();
+        pg.AddRead(read, config, rangeFinder);
+        double addTime = WallSeconds() - start;
+        printf("tpl=%6d  err=%4.2f  read %d  add %8.1f ms  (anchors %6.1f ms)"
+               "  peak RSS %7.1f MB\n",
+               tplLength, errorRate, k, 1e3 * addTime, 1e3 * kmerRangeFinder.Seconds,
+               PeakResidentMegabytes());
+    }
+
+    const PoaConsensus* pc = pg.FindConsensus(config);
+    printf("css length %d\n", static_cast<int>(pc->Sequence.length()));
+    delete pc;
+}
+
+int main()
+{
+    BenchmarkPoaBanding(20000, 0.15f, 4, GLOBAL, false);
+    BenchmarkPoaBanding(20000, 0.15f, 4, GLOBAL, true);
+    BenchmarkPoaBanding(20000, 0.15f, 4, SEMIGLOBAL, true);
+    return 0;
+}
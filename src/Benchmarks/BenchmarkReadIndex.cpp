@@ -0,0 +1,193 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of finding, and then scoring, the reads that overlap a
+// mutation, over 1 kb, 10 kb and 100 kb templates at 10x, 100x and
+// 1000x coverage by 500 bp reads.
+//
+// "select" times only the choice of reads: a scan applying
+// ReadScoresMutation to every read, against an IntervalIndex query.
+// "score" times MultiReadMutationScorer::Score end to end; it is
+// skipped where the reads' alpha/beta matrices would not fit
+// comfortably in memory.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <ConsensusCore/IntervalIndex.hpp>
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+static const int READ_LENGTH = 500;
+static const int MAX_SCORED_READS = 2000;
+
+static int RandomInt(RNG& rng, int lo, int hi)
+{
+    return boost::random::uniform_int_distribution<>(lo, hi)(rng);
+}
+
+static std::vector<Mutation> RandomMutations(RNG& rng, const std::string& tpl, int n)
+{
+    std::vector<Mutation> mutations;
+    for (int k = 0; k < n; k++)
+    {
+        int pos = RandomInt(rng, 0, tpl.length() - 1);
+        mutations.push_back(Mutation(SUBSTITUTION, pos, tpl[pos] == 'A' ? 'C' : 'A'));
+    }
+    return mutations;
+}
+
+static void BenchmarkSelect(int tplLength, int coverage)
+{
+    RNG rng(42);
+    std::string tpl = RandomSequence(rng, tplLength);
+    int nReads = coverage * tplLength / READ_LENGTH;
+    std::vector<ConsensusCore::MappedRead> reads;
+    std::vector<Interval> spans;
+    for (int i = 0; i < nReads; i++)
+    {
+        int start = RandomInt(rng, 0, tplLength - READ_LENGTH);
+        reads.push_back(Benchmarks::MappedRead("A", FORWARD_STRAND,
+                                               start, start + READ_LENGTH));
+        spans.push_back(Interval(start, start + READ_LENGTH));
+    }
+    std::vector<Mutation> mutations = RandomMutations(rng, tpl, 2000);
+
+    long scanned = 0;  // NOLINT
+    double start = WallSeconds();
+    foreach (const Mutation& m, mutations)
+    {
+        for (int i = 0; i < nReads; i++)
+        {
+            if (ReadScoresMutation(reads[i], m)) scanned++;
+        }
+    }
+    double scan = (WallSeconds() - start) / mutations.size();
+
+    start = WallSeconds();
+    detail::IntervalIndex index;
+    index.Build(spans);
+    double build = WallSeconds() - start;
+
+    long indexed = 0;  // NOLINT
+    std::vector<int> ids;
+    start = WallSeconds();
+    foreach (const Mutation& m, mutations)
+    {
+        ids.clear();
+        index.FindOverlapping(m.Start() - 1, m.End(), &ids);
+        foreach (int i, ids)
+        {
+            if (ReadScoresMutation(reads[i], m)) indexed++;
+        }
+    }
+    double query = (WallSeconds() - start) / mutations.size();
+
+    printf("select  tpl=%6d  coverage=%4dx  reads=%6d  scan=%9.3f us  index=%7.3f us  "
+           "speedup=%7.1fx  build=%7.3f ms  (reads/mutation %ld, %ld)\n",
+           tplLength, coverage, nReads, 1e6 * scan, 1e6 * query, scan / query,
+           1e3 * build, scanned / static_cast<long>(mutations.size()),  // NOLINT
+           indexed / static_cast<long>(mutations.size()));  // NOLINT
+}
+
+static void BenchmarkScore(int tplLength, int coverage)
+{
+    int nReads = coverage * tplLength / READ_LENGTH;
+    if (nReads > MAX_SCORED_READS)
+    {
+        printf("score   tpl=%6d  coverage=%4dx  reads=%6d  skipped\n",
+               tplLength, coverage, nReads);
+        return;
+    }
+
+    RNG rng(42);
+    std::string tpl = RandomSequence(rng, tplLength);
+    QuiverConfigTable configs;
+    configs.InsertDefault(BenchmarkConfig());
+    SparseSseQvMultiReadMutationScorer mms(configs, tpl);
+    for (int i = 0; i < nReads; i++)
+    {
+        int start = RandomInt(rng, 0, tplLength - READ_LENGTH);
+        std::string seq = NoisyCopy(rng, tpl.substr(start, READ_LENGTH), 0.05f);
+        mms.AddRead(Benchmarks::MappedRead(seq, FORWARD_STRAND, start, start + READ_LENGTH));
+    }
+    std::vector<Mutation> mutations = RandomMutations(rng, tpl, 1000);
+
+    float checksum = 0;
+    double start = WallSeconds();
+    foreach (const Mutation& m, mutations)
+    {
+        checksum += mms.Score(m);
+    }
+    double elapsed = (WallSeconds() - start) / mutations.size();
+
+    printf("score   tpl=%6d  coverage=%4dx  reads=%6d  usec/mutation=%8.3f  (checksum %g)\n",
+           tplLength, coverage, nReads, 1e6 * elapsed, checksum);
+}
+
+int main()
+{
+    const int tplLengths[] = { 1000, 10000, 100000 };
+    const int coverages[] = { 10, 100, 1000 };
+    for (int t = 0; t < 3; t++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            BenchmarkSelect(tplLengths[t], coverages[c]);
+        }
+    }
+    for (int t = 0; t < 3; t++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            BenchmarkScore(tplLengths[t], coverages[c]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of MutationScorer::ScoreMutation: heap allocations and wall
+// time per scored (read, mutation) pair.
+//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Quiver/MutationScorer.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SseRecursor.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+static void BenchmarkTemplateLength(int tplLength)
+{
+    RNG rng(42);
+    QuiverConfig config = BenchmarkConfig();
+    std::string tpl = RandomSequence(rng, tplLength);
+    std::string readSeq = NoisyCopy(rng, tpl, 0.05f);
+    Read read(QvSequenceFeatures(readSeq), "anonymous", "unknown");
+
+    QvEvaluator ev(read, tpl, config.QvParams);
+    SparseSseQvRecursor recursor(config.MovesAvailable, config.Banding);
+    SparseSseQvMutationScorer scorer(ev, recursor);
+
+    const char* bases = "ACGT";
+    std::vector<Mutation> mutations;
+    for (int pos = 0; pos < tplLength; pos++)
+    {
+        for (int b = 0; b < 4; b++)
+        {
+            if (bases[b] != tpl[pos])
+            {
+                mutations.push_back(Mutation(SUBSTITUTION, pos, bases[b]));
+            }
+            mutations.push_back(Mutation(INSERTION, pos, bases[b]));
+        }
+        mutations.push_back(Mutation(DELETION, pos, '-'));
+    }
+
+    float checksum = 0;
+    long allocationsBefore = AllocationCount();  // NOLINT
+    double start = WallSeconds();
+    for (size_t k = 0; k < mutations.size(); k++)
+    {
+        checksum += scorer.ScoreMutation(mutations[k]);
+    }
+    double elapsed = WallSeconds() - start;
+    long allocations = AllocationCount() - allocationsBefore;  // NOLINT
+
+    printf("tpl=%6d  mutations=%6d  allocs/mutation=%7.3f  usec/mutation=%7.3f  (checksum %g)\n",
+           tplLength, static_cast<int>(mutations.size()),
+           static_cast<double>(allocations) / mutations.size(),
+           1e6 * elapsed / mutations.size(), checksum);
+}
+
+int main()
+{
+    BenchmarkTemplateLength(1000);
+    BenchmarkTemplateLength(5000);
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of SseRecursor::FillAlphaBeta under each SIMD target the
+// processor supports.
+//
+
+#include <cstdio>
+#include <string>
+
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
+#include <ConsensusCore/Quiver/SseRecursor.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+template<typename R>
+static void BenchmarkTemplateLength(const char* recursorName, int tplLength, int nFills)
+{
+    RNG rng(42);
+    QuiverConfig config = BenchmarkConfig();
+    std::string tpl = RandomSequence(rng, tplLength);
+    std::string readSeq = NoisyCopy(rng, tpl, 0.05f);
+    Read read(QvSequenceFeatures(readSeq), "anonymous", "unknown");
+    QvEvaluator ev(read, tpl, config.QvParams);
+
+    double sseTime = 0;
+    SimdTarget targets[] = { SSE3_TARGET, AVX2_TARGET, AVX512_TARGET };
+    for (int t = 0; t < 3; t++)
+    {
+        if (!IsSimdTargetSupported(targets[t])) continue;
+
+        R recursor(config.MovesAvailable, config.Banding);
+        recursor.Target(targets[t]);
+        float score = 0;
+        double start = WallSeconds();
+        for (int k = 0; k < nFills; k++)
+        {
+            SparseMatrix alpha(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+            SparseMatrix beta(ev.ReadLength() + 1, ev.TemplateLength() + 1);
+            recursor.FillAlphaBeta(ev, alpha, beta);
+            score = beta(0, 0);
+        }
+        double elapsed = (WallSeconds() - start) / nFills;
+        if (targets[t] == SSE3_TARGET) sseTime = elapsed;
+
+        printf("%-16s tpl=%6d  %-8s %8.3f ms  speedup=%5.2fx  (score %g)\n",
+               recursorName, tplLength, SimdTargetName(targets[t]),
+               1e3 * elapsed, sseTime / elapsed, score);
+    }
+}
+
+int main()
+{
+    BenchmarkTemplateLength<SparseSseQvRecursor>("Viterbi", 1000, 200);
+    BenchmarkTemplateLength<SparseSseQvRecursor>("Viterbi", 10000, 20);
+    BenchmarkTemplateLength<SparseSseQvSumProductRecursor>("SumProduct", 1000, 200);
+    BenchmarkTemplateLength<SparseSseQvSumProductRecursor>("SumProduct", 10000, 20);
+    return 0;
+}
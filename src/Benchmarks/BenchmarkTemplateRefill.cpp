@@ -0,0 +1,103 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// Cost of MutationScorer::Template(tpl) for a local edit (incremental
+// alpha/beta refill), against filling from scratch.
+//
+
+#include <cstdio>
+#include <string>
+
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Quiver/MutationScorer.hpp>
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SseRecursor.hpp>
+
+#include "Harness.hpp"
+
+using namespace ConsensusCore;  // NOLINT
+using namespace Benchmarks;     // NOLINT
+
+static void BenchmarkTemplateLength(int tplLength, int nEdits)
+{
+    RNG rng(42);
+    QuiverConfig config = BenchmarkConfig();
+    std::string tpl = RandomSequence(rng, tplLength);
+    std::string readSeq = NoisyCopy(rng, tpl, 0.05f);
+    Read read(QvSequenceFeatures(readSeq), "anonymous", "unknown");
+    SparseSseQvRecursor recursor(config.MovesAvailable, config.Banding);
+
+    // Alternately substitute and restore a base in the middle of the
+    // template.
+    std::string mutTpl = ApplyMutation(Mutation(SUBSTITUTION, tplLength / 2,
+                                                tpl[tplLength / 2] == 'A' ? 'C' : 'A'), tpl);
+
+    QvEvaluator ev(read, tpl, config.QvParams);
+    SparseSseQvMutationScorer scorer(ev, recursor);
+    float incrementalScore = 0;
+    double start = WallSeconds();
+    for (int k = 0; k < nEdits; k++)
+    {
+        scorer.Template(k % 2 == 0 ? mutTpl : tpl);
+        incrementalScore = scorer.Score();
+    }
+    double incremental = (WallSeconds() - start) / nEdits;
+
+    float fullScore = 0;
+    start = WallSeconds();
+    for (int k = 0; k < nEdits; k++)
+    {
+        QvEvaluator fullEv(read, k % 2 == 0 ? mutTpl : tpl, config.QvParams);
+        SparseSseQvMutationScorer fullScorer(fullEv, recursor);
+        fullScore = fullScorer.Score();
+    }
+    double full = (WallSeconds() - start) / nEdits;
+
+    printf("tpl=%6d  full fill=%8.3f ms  incremental=%8.3f ms  speedup=%5.1fx  "
+           "(scores %g, %g)\n",
+           tplLength, 1e3 * full, 1e3 * incremental, full / incremental,
+           fullScore, incrementalScore);
+}
+
+int main()
+{
+    BenchmarkTemplateLength(1000, 50);
+    BenchmarkTemplateLength(5000, 20);
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include "Harness.hpp"
+
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <ConsensusCore/Features.hpp>
+#include <ConsensusCore/Sequence.hpp>
+
+using namespace ConsensusCore;  // NOLINT
+
+//
+// Counting replacements for the global allocation functions.  Not
+// thread-safe; benchmarks count allocations on one thread only.
+//
+static long allocationCount = 0;  // NOLINT
+
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+    allocationCount++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+    allocationCount++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw()
+{
+    free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+    free(p);
+}
+
+namespace Benchmarks
+{
+    long AllocationCount()  // NOLINT
+    {
+        return allocationCount;
+    }
+
+    double WallSeconds()
+    {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + 1e-6 * tv.tv_usec;
+    }
+
+    double PeakResidentMegabytes()
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024.0;  // ru_maxrss is in kilobytes
+    }
+
+    std::string RandomSequence(RNG& rng, int length)
+    {
+        const char* bases = "ACGT";
+        boost::random::uniform_int_distribution<> baseDist(0, 3);
+        std::string seq(length, 'A');
+        for (int i = 0; i < length; i++)
+        {
+            seq[i] = bases[baseDist(rng)];
+        }
+        return seq;
+    }
+
+    std::string NoisyCopy(RNG& rng, const std::string& tpl, float errorRate)
+    {
+        const char* bases = "ACGT";
+        boost::random::uniform_int_distribution<> baseDist(0, 3);
+        boost::random::uniform_real_distribution<> unif(0, 1);
+        std::string seq;
+        for (size_t j = 0; j < tpl.length(); j++)
+        {
+            double u = unif(rng);
+            if (u < errorRate / 3)
+            {
+                seq.push_back(bases[baseDist(rng)]);   // substitution
+            }
+            else if (u < 2 * errorRate / 3)
+            {
+                seq.push_back(tpl[j]);                 // insertion
+                seq.push_back(bases[baseDist(rng)]);
+            }
+            else if (u >= errorRate)
+            {
+                seq.push_back(tpl[j]);                 // (else deletion)
+            }
+        }
+        return seq;
+    }
+
+    ConsensusCore::MappedRead MappedRead(const std::string& seq,
+                                         StrandEnum strand,
+                                         int templateStart,
+                                         int templateEnd)
+    {
+        Read read(QvSequenceFeatures(seq), "anonymous", "unknown");
+        return ConsensusCore::MappedRead(read, strand, templateStart, templateEnd);
+    }
+
+    QuiverConfig BenchmarkConfig()
+    {
+        QvModelParams params("unknown", "benchmark",
+                             0.f,     // Match,
+                             -10.f,   // Mismatch,
+                             -0.1f,   // MismatchS,
+                             -5.f,    // Branch,
+                             -0.1f,   // BranchS,
+                             -6.f,    // DeletionN,
+                             -7.f,    // DeletionWithTag,
+                             -0.1f,   // DeletionWithTagS,
+                             -8.f,    // Nce,
+                             -0.1f,   // NceS,
+                             -2.f,    // Merge,
+                             0.f);    // MergeS
+        return QuiverConfig(params, ALL_MOVES, BandingOptions(4, 18), -12.5);
+    }
+}
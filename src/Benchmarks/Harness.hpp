@@ -0,0 +1,72 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#pragma once
+
+#include <boost/random/mersenne_twister.hpp>
+#include <string>
+
+#include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Read.hpp>
+
+namespace Benchmarks
+{
+    typedef boost::random::mt19937 RNG;
+
+    // Number of calls to the global operator new (scalar and array)
+    // made so far by this process.
+    long AllocationCount();  // NOLINT
+
+    // Wall clock time, in seconds, from an arbitrary origin.
+    double WallSeconds();
+
+    // Largest resident set size this process has reached, in megabytes.
+    double PeakResidentMegabytes();
+
+    std::string RandomSequence(RNG& rng, int length);
+
+    // A copy of tpl with substitutions, insertions and deletions each
+    // introduced at rate errorRate / 3.
+    std::string NoisyCopy(RNG& rng, const std::string& tpl, float errorRate);
+
+    ConsensusCore::MappedRead MappedRead(const std::string& seq,
+                                         ConsensusCore::StrandEnum strand,
+                                         int templateStart,
+                                         int templateEnd);
+
+    ConsensusCore::QuiverConfig BenchmarkConfig();
+}
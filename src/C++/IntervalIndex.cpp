@@ -0,0 +1,184 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/IntervalIndex.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace ConsensusCore {
+namespace detail {
+
+    IntervalIndex::IntervalIndex()
+        : nodes_(),
+          rootLevel_(-1)
+    {}
+
+    void
+    IntervalIndex::Build(const std::vector<Interval>& intervals)
+    {
+        int n = intervals.size();
+        nodes_.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            nodes_[i].Begin = intervals[i].Begin;
+            nodes_[i].End = intervals[i].End;
+            nodes_[i].MaxEnd = intervals[i].End;
+            nodes_[i].Id = i;
+        }
+        std::sort(nodes_.begin(), nodes_.end(), NodeOrder());
+
+        rootLevel_ = -1;
+        if (n == 0) return;
+
+        // Leaves are the even indices.  The last node on each level
+        // may have a right subtree that is missing or incomplete;
+        // lastMaxEnd carries the max end of whatever of it exists.
+        int lastIndex = 0;
+        int lastMaxEnd = 0;
+        for (int i = 0; i < n; i += 2)
+        {
+            lastIndex = i;
+            lastMaxEnd = nodes_[i].End;
+        }
+        int k;
+        for (k = 1; (1 << k) <= n; k++)
+        {
+            int x = 1 << (k - 1);
+            for (int i = (x << 1) - 1; i < n; i += x << 2)
+            {
+                int leftMax = nodes_[i - x].MaxEnd;
+                int rightMax = (i + x < n ? nodes_[i + x].MaxEnd : lastMaxEnd);
+                nodes_[i].MaxEnd = std::max(nodes_[i].End, std::max(leftMax, rightMax));
+            }
+            lastIndex = ((lastIndex >> k) & 1) ? lastIndex - x : lastIndex + x;
+            if (lastIndex < n && nodes_[lastIndex].MaxEnd > lastMaxEnd)
+            {
+                lastMaxEnd = nodes_[lastIndex].MaxEnd;
+            }
+        }
+        rootLevel_ = k - 1;
+    }
+
+    void
+    IntervalIndex::FindOverlapping(int begin, int end, std::vector<int>* ids) const
+    {
+        if (rootLevel_ < 0) return;
+
+        int n = nodes_.size();
+        int firstFound = ids->size();
+
+        // Top-down traversal; a frame revisits its node (leftDone)
+        // once the left subtree has been searched.
+        struct Frame { int Node; int Level; bool LeftDone; };
+        Frame stack[64];
+        int top = 0;
+        Frame root = { (1 << rootLevel_) - 1, rootLevel_, false };
+        stack[top++] = root;
+        while (top > 0)
+        {
+            Frame f = stack[--top];
+            if (f.Level <= 3)
+            {
+                // Small subtree: scan it linearly
+                int i0 = (f.Node >> f.Level) << f.Level;
+                int i1 = std::min(i0 + (1 << (f.Level + 1)) - 1, n);
+                for (int i = i0; i < i1 && nodes_[i].Begin < end; i++)
+                {
+                    if (begin < nodes_[i].End) ids->push_back(nodes_[i].Id);
+                }
+            }
+            else if (!f.LeftDone)
+            {
+                int left = f.Node - (1 << (f.Level - 1));
+                Frame again = { f.Node, f.Level, true };
+                stack[top++] = again;
+                if (left >= n || nodes_[left].MaxEnd > begin)
+                {
+                    Frame child = { left, f.Level - 1, false };
+                    stack[top++] = child;
+                }
+            }
+            else if (f.Node < n && nodes_[f.Node].Begin < end)
+            {
+                if (begin < nodes_[f.Node].End) ids->push_back(nodes_[f.Node].Id);
+                Frame child = { f.Node + (1 << (f.Level - 1)), f.Level - 1, false };
+                stack[top++] = child;
+            }
+        }
+
+        // The hits come out in order of interval start.  Put them in id
+        // order, by sorting if they are few, else by marking them in a
+        // table of all ids and sweeping it: sorting costs tens of
+        // nanoseconds per hit, sweeping well under one per interval.
+        int nFound = ids->size() - firstFound;
+        if (nFound < 2)
+        {
+            return;
+        }
+        else if (32 * nFound < n)
+        {
+            std::sort(ids->begin() + firstFound, ids->end());
+        }
+        else
+        {
+            std::vector<unsigned char> isFound(n, 0);
+            for (int k = firstFound; k < static_cast<int>(ids->size()); k++)
+            {
+                isFound[(*ids)[k]] = 1;
+            }
+            // (branch-free; the sentinel slot absorbs the final store)
+            ids->push_back(0);
+            int* out = &(*ids)[firstFound];
+            int k = 0;
+            for (int id = 0; id < n; id++)
+            {
+                out[k] = id;
+                k += isFound[id];
+            }
+            ids->pop_back();
+        }
+    }
+
+    int
+    IntervalIndex::Size() const
+    {
+        return nodes_.size();
+    }
+}
+}
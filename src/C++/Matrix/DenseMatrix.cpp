@@ -65,6 +65,15 @@ namespace ConsensusCore {
     DenseMatrix::~DenseMatrix()
     {}
 
+    void
+    DenseMatrix::Reset(int rows, int cols)
+    {
+        assert(columnBeingEdited_ == -1);
+        resize(rows, cols, false);
+        std::fill(data().begin(), data().end(), value_type());
+        usedRanges_.assign(cols, Interval(0, 0));
+    }
+
     int
     DenseMatrix::UsedEntries() const
     {
@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <boost/tuple/tuple.hpp>
 #include <limits>
+#include <new>
 #include <vector>
 
 #include <ConsensusCore/Matrix/SparseMatrix.hpp>
@@ -45,41 +46,96 @@
 namespace ConsensusCore {
     // Performance insensitive routines are not inlined
 
-    SparseMatrix::SparseMatrix(int rows, int cols)
-        : columns_(cols),  nCols_(cols), nRows_(rows), columnBeingEdited_(-1),
-          usedRanges_(cols, Interval(0, 0))
-    {
-        for (int j = 0; j < nCols_; j++)
+    const int SparseMatrix::BAND_PADDING;
+
+    namespace {
+        // A column band refilled with a range this much smaller than
+        // its slot gives the excess back to the arena
+        const float SHRINK_THRESHOLD = 0.8;
+
+        // Bands start at a multiple of four entries, so the arena is
+        // aligned to a cache line
+        const int ARENA_ALIGNMENT = 64;
+
+        float* AllocateArena(int entries)
         {
-            columns_[j] = NULL;
+            if (entries == 0) return NULL;
+            float* arena = static_cast<float*>(_mm_malloc(entries * sizeof(float),
+                                                          ARENA_ALIGNMENT));
+            if (arena == NULL) throw std::bad_alloc();
+            return arena;
         }
     }
 
+    SparseMatrix::SparseMatrix(int rows, int cols)
+        : bands_(cols),
+          arena_(NULL),
+          arenaCapacity_(0),
+          arenaUsed_(0),
+          liveEntries_(0),
+          nCols_(cols),
+          nRows_(rows),
+          columnBeingEdited_(-1),
+          usedRanges_(cols, Interval(0, 0))
+    {}
+
     SparseMatrix::SparseMatrix(const SparseMatrix& other)
-        : columns_(other.nCols_),
+        : bands_(other.bands_),
+          arena_(NULL),
+          arenaCapacity_(0),
+          arenaUsed_(0),
+          liveEntries_(0),
           nCols_(other.nCols_),
           nRows_(other.nRows_),
           columnBeingEdited_(other.columnBeingEdited_),
           usedRanges_(other.usedRanges_)
     {
+        // Copy the live bands only, compacted
+        int entries = 0;
         for (int j = 0; j < nCols_; j++)
         {
-            if (other.columns_[j] != NULL)
-            {
-                columns_[j] = new SparseVector(*other.columns_[j]);
-            }
-            else
-            {
-                columns_[j] = NULL;
-            }
+            entries += BandEntries(bands_[j].Begin, bands_[j].End);
+        }
+        arena_ = AllocateArena(entries);
+        arenaCapacity_ = entries;
+        for (int j = 0; j < nCols_; j++)
+        {
+            ColumnBand& band = bands_[j];
+            if (band.Capacity == 0) continue;
+            int n = BandEntries(band.Begin, band.End);
+            std::copy(other.arena_ + band.Offset,
+                      other.arena_ + band.Offset + n,
+                      arena_ + arenaUsed_);
+            band.Offset = arenaUsed_;
+            band.Capacity = n;
+            arenaUsed_ += n;
         }
+        liveEntries_ = arenaUsed_;
     }
 
     SparseMatrix::~SparseMatrix()
     {
-        for (int j = 0; j < nCols_; j++)
+        _mm_free(arena_);
+    }
+
+    void
+    SparseMatrix::Reset(int rows, int cols)
+    {
+        assert(columnBeingEdited_ == -1);
+        nRows_ = rows;
+        nCols_ = cols;
+        bands_.assign(cols, ColumnBand());
+        usedRanges_.assign(cols, Interval(0, 0));
+        arenaUsed_ = 0;
+        liveEntries_ = 0;
+    }
+
+    void
+    SparseMatrix::Reserve(int entries)
+    {
+        if (entries > arenaCapacity_)
         {
-            if (columns_[j] != NULL) delete columns_[j];
+            Rebuild(entries);
         }
     }
 
@@ -100,13 +156,138 @@ namespace ConsensusCore {
     int
     SparseMatrix::AllocatedEntries() const
     {
-        int sum = 0;
+        // Entries held by column bands; arena slots abandoned by
+        // relocated columns are not counted.
+        return liveEntries_;
+    }
+
+    void
+    SparseMatrix::AllocateColumn(int j, int beginRow, int endRow)
+    {
+        ColumnBand& band = bands_[j];
+        int begin = AlignedBegin(beginRow);
+        int end = AlignedEnd(endRow);
+        int n = BandEntries(begin, end);
+        bool atTail = (band.Offset + band.Capacity == arenaUsed_);
+
+        if (n <= band.Capacity)
+        {
+            if (n < static_cast<int>(SHRINK_THRESHOLD * band.Capacity))
+            {
+                liveEntries_ -= band.Capacity - n;
+                if (atTail) arenaUsed_ -= band.Capacity - n;
+                band.Capacity = n;
+            }
+        }
+        else if (atTail && band.Offset + n <= arenaCapacity_)
+        {
+            liveEntries_ += n - band.Capacity;
+            arenaUsed_ += n - band.Capacity;
+            band.Capacity = n;
+        }
+        else
+        {
+            liveEntries_ -= band.Capacity;
+            band.Capacity = 0;
+            band.Begin = band.End = 0;
+            band.Offset = AllocateEntries(n);
+            band.Capacity = n;
+        }
+        band.Begin = begin;
+        band.End = end;
+        std::fill(arena_ + band.Offset, arena_ + band.Offset + n, Zero<lfloat>());
+    }
+
+    void
+    SparseMatrix::ExpandColumn(int j, int beginRow, int endRow)
+    {
+        ColumnBand& band = bands_[j];
+        int begin = min(AlignedBegin(beginRow), band.Begin);
+        int end = max(AlignedEnd(endRow), band.End);
+        int n = BandEntries(begin, end);
+        int shift = band.Begin - begin;
+        int oldLength = band.End - band.Begin;
+
+        if (n <= band.Capacity)
+        {
+            std::copy_backward(arena_ + band.Offset,
+                               arena_ + band.Offset + oldLength,
+                               arena_ + band.Offset + shift + oldLength);
+        }
+        else if (band.Offset + band.Capacity == arenaUsed_ &&
+                 band.Offset + n <= arenaCapacity_)
+        {
+            // Last column in the arena: grow in place
+            liveEntries_ += n - band.Capacity;
+            arenaUsed_ += n - band.Capacity;
+            band.Capacity = n;
+            std::copy_backward(arena_ + band.Offset,
+                               arena_ + band.Offset + oldLength,
+                               arena_ + band.Offset + shift + oldLength);
+        }
+        else
+        {
+            // Relocate to the end of the arena.  Allocating may move
+            // the arena, and this band with it.
+            int offset = AllocateEntries(n);
+            std::copy(arena_ + band.Offset,
+                      arena_ + band.Offset + oldLength,
+                      arena_ + offset + shift);
+            liveEntries_ -= band.Capacity;
+            band.Offset = offset;
+            band.Capacity = n;
+        }
+        std::fill(arena_ + band.Offset,
+                  arena_ + band.Offset + shift,
+                  Zero<lfloat>());
+        std::fill(arena_ + band.Offset + shift + oldLength,
+                  arena_ + band.Offset + n,
+                  Zero<lfloat>());
+        band.Begin = begin;
+        band.End = end;
+    }
+
+    int
+    SparseMatrix::AllocateEntries(int n)
+    {
+        if (arenaUsed_ + n > arenaCapacity_)
+        {
+            // Compact, growing if that would leave too little room
+            int needed = liveEntries_ + n;
+            int capacity = arenaCapacity_;
+            if (needed + needed / 2 > capacity)
+            {
+                capacity = max(2 * capacity, needed + needed / 2);
+            }
+            Rebuild(capacity);
+        }
+        int offset = arenaUsed_;
+        arenaUsed_ += n;
+        liveEntries_ += n;
+        return offset;
+    }
+
+    void
+    SparseMatrix::Rebuild(int capacity)
+    {
+        assert(capacity >= liveEntries_);
+        float* arena = AllocateArena(capacity);
+        int used = 0;
         for (int j = 0; j < nCols_; j++)
         {
-            sum += (columns_[j] != NULL ?
-                    columns_[j]->AllocatedEntries() : 0);
+            ColumnBand& band = bands_[j];
+            if (band.Capacity == 0) continue;
+            std::copy(arena_ + band.Offset,
+                      arena_ + band.Offset + band.Capacity,
+                      arena + used);
+            band.Offset = used;
+            used += band.Capacity;
         }
-        return sum;
+        _mm_free(arena_);
+        arena_ = arena;
+        arenaCapacity_ = capacity;
+        arenaUsed_ = used;
+        assert(used == liveEntries_);
     }
 
     void
@@ -126,9 +307,16 @@ namespace ConsensusCore {
     void
     SparseMatrix::CheckInvariants(int column) const
     {
+        assert(0 <= liveEntries_ && liveEntries_ <= arenaUsed_);
+        assert(arenaUsed_ <= arenaCapacity_);
         for (int j = 0; j < nCols_; j++)
-         {
-             if (columns_[j] != NULL) columns_[j]->CheckInvariants();
-         }
+        {
+            assert(0 <= bands_[j].Begin && bands_[j].Begin <= bands_[j].End);
+            assert(bands_[j].End <= nRows_);
+            assert(bands_[j].Begin % 4 == 0 && bands_[j].Offset % 4 == 0);
+            assert(bands_[j].End - bands_[j].Begin <= bands_[j].Capacity);
+            assert(bands_[j].Capacity == 0 ||
+                   bands_[j].Offset + bands_[j].Capacity <= arenaUsed_);
+        }
     }
 }
@@ -45,6 +45,7 @@
 #include <vector>
 
 #include <ConsensusCore/Align/AlignConfig.hpp>
+#include <ConsensusCore/Poa/RangeFinder.hpp>
 #include <ConsensusCore/Utils.hpp>
 
 using boost::tie;
@@ -82,16 +83,19 @@ namespace ConsensusCore
     const PoaConsensus*
     PoaConsensus::FindConsensus(const std::vector<std::string>& reads,
                                 const AlignConfig& config,
-                                int minCoverage)
+                                int minCoverage,
+                                bool useKmerRangeFinder)
     {
         PoaGraph pg;
+        detail::KmerRangeFinder kmerRangeFinder;
+        detail::SdpRangeFinder* rangeFinder = useKmerRangeFinder ? &kmerRangeFinder : NULL;
         foreach (const std::string& read, reads)
         {
             if (read.length() == 0)
             {
                 throw InvalidInputError("Input sequences must have nonzero length.");
             }
-            pg.AddRead(read, config);
+            pg.AddRead(read, config, rangeFinder);
         }
         return pg.FindConsensus(config, minCoverage);
     }
@@ -99,9 +103,10 @@ namespace ConsensusCore
     const PoaConsensus*
     PoaConsensus::FindConsensus(const std::vector<std::string>& reads,
                                 AlignMode mode,
-                                int minCoverage)
+                                int minCoverage,
+                                bool useKmerRangeFinder)
     {
-        return FindConsensus(reads, DefaultPoaConfig(mode), minCoverage);
+        return FindConsensus(reads, DefaultPoaConfig(mode), minCoverage, useKmerRangeFinder);
     }
 
     std::string
@@ -82,6 +82,18 @@ namespace ConsensusCore
         return impl->NumReads();
     }
 
+    bool
+    PoaGraph::VectorizedAlignment() const
+    {
+        return impl->VectorizedAlignment();
+    }
+
+    void
+    PoaGraph::VectorizedAlignment(bool enable)
+    {
+        impl->VectorizedAlignment(enable);
+    }
+
     const PoaConsensus*
     PoaGraph::FindConsensus(const AlignConfig& config, int minCoverage) const
     {
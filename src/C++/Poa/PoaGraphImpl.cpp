@@ -7,27 +7,37 @@
 #include <ConsensusCore/Poa/RangeFinder.hpp>
 #include <ConsensusCore/Utils.hpp>
 
-#include <boost/graph/copy.hpp>
-#include <boost/graph/topological_sort.hpp>
-#include <boost/graph/graphviz.hpp>
-
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <emmintrin.h>
+#include <cstdlib>
+#include <fstream>
 #include <set>
-#include <iostream>
+#include <sstream>
+#include <utility>
+
+// Label distance between consecutive vertices appended to the
+// topological order
+#define LABEL_SPACING (static_cast<uint64_t>(1) << 32)
+
+// Largest score magnitude handed to the SSE2 column kernel, leaving
+// room below SHRT_MAX and above its -infinity (SHRT_MIN) for the
+// parameters added to it
+#define MAX_INT16_SCORE 30000
 
+// An alignment column arena that must grow gets a quarter more room
+// than asked for
+#define ARENA_GROWTH_DIVISOR 4
 
-namespace boost
-{
-    using ConsensusCore::detail::VertexInfoMap;
-    using ConsensusCore::PoaConsensus;
-    using ConsensusCore::PoaGraph;
-    using ConsensusCore::detail::VD;
-    using boost::format;
+namespace ConsensusCore {
+namespace detail {
 
-    class my_label_writer
+    // Writes the GraphViz node attributes for a vertex
+    class PoaLabelWriter
     {
     public:
-        my_label_writer(VertexInfoMap map, bool color, bool verbose, const PoaConsensus* pc = NULL)
-            : map_(map),
+        PoaLabelWriter(const CompactGraph& g, bool color, bool verbose, const PoaConsensus* pc = NULL)
+            : g_(g),
               cssVtxs_(),
               color_(color),
               verbose_(verbose)
@@ -38,10 +48,10 @@ namespace boost
             }
         }
 
-        template <class descriptor>
-        void operator()(std::ostream& out, const descriptor& v) const
+        void operator()(std::ostream& out, VD v) const
         {
-            PoaGraph::Vertex vertexId = map_[v].Id;
+            const PoaNode& node = g_[v];
+            PoaGraph::Vertex vertexId = node.Id;
 
             std::string nodeColoringAttribute =
                 (color_ && isInConsensus(vertexId) ?
@@ -51,8 +61,8 @@ namespace boost
             {
                 out << format("[shape=Mrecord,%s label=\"{ %c | %d }\"]")
                     % nodeColoringAttribute
-                    % map_[v].Base
-                    % map_[v].Reads;
+                    % node.Base
+                    % node.Reads;
             }
             else
             {
@@ -61,9 +71,9 @@ namespace boost
                                "{ %d | %d } |"
                                "{ %0.2f | %0.2f } }\"]")
                     % nodeColoringAttribute
-                    % vertexId % map_[v].Base
-                    % map_[v].Reads % map_[v].SpanningReads
-                    % map_[v].Score % map_[v].ReachingScore;
+                    % vertexId % node.Base
+                    % node.Reads % node.SpanningReads
+                    % node.Score % node.ReachingScore;
             }
         }
     private:
@@ -73,27 +83,308 @@ namespace boost
             return cssVtxs_.find(v) != cssVtxs_.end();
         }
 
-        VertexInfoMap map_;
+        const CompactGraph& g_;
         std::set<PoaGraph::Vertex> cssVtxs_;
         bool color_;
         bool verbose_;
     };
-}
 
-namespace ConsensusCore {
-namespace detail {
+    // ----------------- CompactGraph ---------------------
 
-    // ----------------- PoaAlignmentMatrixImpl ---------------------
+    VD CompactGraph::AddVertex(char base, int nReads)
+    {
+        VD v = nodes_.size();
+        nodes_.push_back(PoaNode(v, base, nReads));
+        inEdges_.push_back(AdjacencyList());
+        outEdges_.push_back(AdjacencyList());
+        prev_.push_back(null_vertex);
+        next_.push_back(null_vertex);
+        label_.push_back(0);
+        visited_.push_back(false);
+        linkAfter(tail_, v);
+        return v;
+    }
 
+    void CompactGraph::AddEdge(VD u, VD v)
+    {
+        assert(u != v);
+        bool uIsolated = isIsolated(u);
+        bool vIsolated = isIsolated(v);
+        if (!outEdges_[u].Insert(v))
+        {
+            return;
+        }
+        inEdges_[v].Insert(u);
+        edges_.push_back(Edge(u, v));
 
-    PoaAlignmentMatrixImpl::~PoaAlignmentMatrixImpl()
+        if (label_[u] < label_[v])
+        {
+            return;
+        }
+        if (uIsolated)
+        {
+            unlink(u);
+            linkBefore(v, u);
+        }
+        else if (vIsolated)
+        {
+            unlink(v);
+            linkAfter(u, v);
+        }
+        else
+        {
+            reorder(u, v);
+        }
+    }
+
+    std::vector<VD> CompactGraph::TopologicalOrder() const
+    {
+        std::vector<VD> order;
+        order.reserve(nodes_.size());
+        for (VD v = head_; v != null_vertex; v = next_[v])
+        {
+            order.push_back(v);
+        }
+        return order;
+    }
+
+    bool CompactGraph::OrderIsTopological() const
+    {
+        size_t length = 0;
+        for (VD v = head_; v != null_vertex; v = next_[v], length++)
+        {
+            if (next_[v] != null_vertex && label_[v] >= label_[next_[v]])
+            {
+                return false;
+            }
+        }
+        if (length != nodes_.size())
+        {
+            return false;
+        }
+        foreach (const Edge& e, edges_)
+        {
+            if (label_[e.first] >= label_[e.second])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CompactGraph::unlink(VD v)
+    {
+        if (prev_[v] == null_vertex) { head_ = next_[v]; } else { next_[prev_[v]] = next_[v]; }
+        if (next_[v] == null_vertex) { tail_ = prev_[v]; } else { prev_[next_[v]] = prev_[v]; }
+        prev_[v] = next_[v] = null_vertex;
+    }
+
+    void CompactGraph::linkBefore(VD w, VD v)
+    {
+        linkAfter(w == null_vertex ? tail_ : prev_[w], v);
+    }
+
+    void CompactGraph::linkAfter(VD u, VD v)
+    {
+        VD w = (u == null_vertex) ? head_ : next_[u];
+        uint64_t lo = (u == null_vertex) ? 0 : label_[u];
+        if (w == null_vertex)
+        {
+            label_[v] = lo + LABEL_SPACING;
+        }
+        else
+        {
+            if (label_[w] - lo < 2)
+            {
+                relabelAfter(u);
+            }
+            label_[v] = lo + (label_[w] - lo) / 2;
+        }
+        prev_[v] = u;
+        next_[v] = w;
+        if (u == null_vertex) { head_ = v; } else { next_[u] = v; }
+        if (w == null_vertex) { tail_ = v; } else { prev_[w] = v; }
+    }
+
+    void CompactGraph::relabelAfter(VD u)
     {
-        foreach (AlignmentColumnMap::value_type& kv, columns_)
+        // Make room after u: find the shortest run of j successors whose
+        // labels span more than j^2 and space the run out evenly (after
+        // Dietz & Sleator), or space out everything after u if there is
+        // no such run.
+        uint64_t base = (u == null_vertex) ? 0 : label_[u];
+        VD first = (u == null_vertex) ? head_ : next_[u];
+        VD x = first;
+        uint64_t j = 1;
+        while (x != null_vertex && label_[x] - base <= j * j)
         {
-            delete kv.second;
+            x = next_[x];
+            j++;
+        }
+        uint64_t step = (x == null_vertex) ? LABEL_SPACING : (label_[x] - base) / j;
+        uint64_t k = 1;
+        for (VD y = first; y != x; y = next_[y], k++)
+        {
+            label_[y] = base + k * step;
         }
     }
 
+    void CompactGraph::collectAffected(VD start, bool forward, uint64_t bound,
+                                       std::vector<VD>* affected)
+    {
+        // Vertices reachable from start (forward: along out-edges, to
+        // labels below bound; backward: along in-edges, to labels above
+        // bound)
+        std::vector<VD> stack(1, start);
+        visited_[start] = true;
+        while (!stack.empty())
+        {
+            VD x = stack.back();
+            stack.pop_back();
+            affected->push_back(x);
+            const AdjacencyList& adjacent = forward ? outEdges_[x] : inEdges_[x];
+            foreach (VD w, adjacent)
+            {
+                assert(!forward || label_[w] != bound);  // a cycle
+                bool inRange = forward ? (label_[w] < bound) : (label_[w] > bound);
+                if (inRange && !visited_[w])
+                {
+                    visited_[w] = true;
+                    stack.push_back(w);
+                }
+            }
+        }
+    }
+
+    static inline bool compareOnFirst(const std::pair<uint64_t, VD>& a,
+                                      const std::pair<uint64_t, VD>& b)
+    {
+        return a.first < b.first;
+    }
+
+    void CompactGraph::reorder(VD u, VD v)
+    {
+        // Pearce & Kelly (2006): the new edge u -> v runs against the
+        // order.  Of the vertices labelled between v and u, those
+        // reachable from v must move after those reaching u; they swap
+        // among their own positions in the order, in which both groups
+        // otherwise keep their relative order.
+        std::vector<VD> deltaF, deltaB;
+        collectAffected(v, true, label_[u], &deltaF);
+        collectAffected(u, false, label_[v], &deltaB);
+
+        std::vector<std::pair<uint64_t, VD> > slots, moved;
+        foreach (VD x, deltaB) { moved.push_back(std::make_pair(label_[x], x)); }
+        std::sort(moved.begin(), moved.end(), compareOnFirst);
+        size_t numB = moved.size();
+        foreach (VD x, deltaF) { moved.push_back(std::make_pair(label_[x], x)); }
+        std::sort(moved.begin() + numB, moved.end(), compareOnFirst);
+        slots = moved;
+        std::sort(slots.begin(), slots.end(), compareOnFirst);
+
+        const size_t m = slots.size();
+        std::vector<VD> oldPrev(m), oldNext(m);
+        for (size_t i = 0; i < m; i++)
+        {
+            VD slot = slots[i].second;
+            oldPrev[i] = prev_[slot];
+            oldNext[i] = next_[slot];
+            visited_[slot] = false;
+        }
+        for (size_t i = 0; i < m; i++)
+        {
+            VD x = moved[i].second;
+            label_[x] = slots[i].first;
+            prev_[x] = (i > 0 && oldPrev[i] == slots[i - 1].second) ? moved[i - 1].second : oldPrev[i];
+            next_[x] = (i + 1 < m && oldNext[i] == slots[i + 1].second) ? moved[i + 1].second : oldNext[i];
+            if (prev_[x] == null_vertex) { head_ = x; } else { next_[prev_[x]] = x; }
+            if (next_[x] == null_vertex) { tail_ = x; } else { prev_[next_[x]] = x; }
+        }
+    }
+
+    // ----------------- AlignmentColumnArena ---------------------
+
+    void AlignmentColumnArena::Reset(size_t numVertices)
+    {
+        // (every column starts out without rows, whatever it held for
+        // the previous read)
+        columns_.assign(numVertices, AlignmentColumn());
+    }
+
+    void AlignmentColumnArena::Layout(VD v, int beginRow, int endRow, bool widePredecessors)
+    {
+        assert(beginRow <= endRow);
+        AlignmentColumn& col = columns_[v];
+        col.CurrentVertex = v;
+        col.Score = ColumnRows<int>(beginRow, endRow);
+        col.Traceback = ColumnRows<uint8_t>(beginRow, endRow);
+        col.PredecessorHigh = ColumnRows<uint8_t>(beginRow, widePredecessors ? endRow : beginRow);
+        col.EndPredecessor = null_vertex;
+    }
+
+    void AlignmentColumnArena::Allocate()
+    {
+        size_t numRows = 0, numWideRows = 0;
+        foreach (const AlignmentColumn& col, columns_)
+        {
+            numRows += col.Score.Length();
+            numWideRows += col.PredecessorHigh.Length();
+        }
+        // The buffers only grow, with room to spare, as the graph does.
+        // Their contents need not survive, so the old ones are freed
+        // before the new are allocated, not copied.
+        if (scores_.size() < numRows)
+        {
+            size_t size = numRows + numRows / ARENA_GROWTH_DIVISOR;
+            std::vector<int>().swap(scores_);
+            std::vector<uint8_t>().swap(tracebacks_);
+            scores_.resize(size);
+            tracebacks_.resize(size);
+        }
+        if (predecessorHigh_.size() < numWideRows)
+        {
+            std::vector<uint8_t>().swap(predecessorHigh_);
+            predecessorHigh_.resize(numWideRows + numWideRows / ARENA_GROWTH_DIVISOR);
+        }
+        std::fill(scores_.begin(), scores_.begin() + numRows, -INT_MAX);
+        std::fill(tracebacks_.begin(), tracebacks_.begin() + numRows, InvalidMove);
+        std::fill(predecessorHigh_.begin(), predecessorHigh_.begin() + numWideRows, 0);
+
+        size_t row = 0, wideRow = 0;
+        foreach (AlignmentColumn& col, columns_)
+        {
+            if (col.Score.Length() > 0)
+            {
+                col.Score.SetStorage(&scores_[row]);
+                col.Traceback.SetStorage(&tracebacks_[row]);
+                row += col.Score.Length();
+            }
+            if (col.PredecessorHigh.Length() > 0)
+            {
+                col.PredecessorHigh.SetStorage(&predecessorHigh_[wideRow]);
+                wideRow += col.PredecessorHigh.Length();
+            }
+        }
+    }
+
+    const std::vector<const AlignmentColumn*>&
+    AlignmentColumnArena::PredecessorColumns(const CompactGraph& g, VD v)
+    {
+        predecessorColumns_.clear();
+        foreach (VD u, g.InEdges(v))
+        {
+            assert(columns_[u].CurrentVertex == u);
+            predecessorColumns_.push_back(&columns_[u]);
+        }
+        return predecessorColumns_;
+    }
+
+    // ----------------- PoaAlignmentMatrixImpl ---------------------
+
+
+    PoaAlignmentMatrixImpl::~PoaAlignmentMatrixImpl()
+    {}
+
 
     float PoaAlignmentMatrixImpl::Score() const
     {
@@ -105,10 +396,8 @@ namespace detail {
 
     PoaGraphImpl::PoaGraphImpl()
         : g_(),
-          vertexInfoMap_(get(vertex_info, g_)),
           numReads_(0),
-          totalVertices_(0),
-          liveVertices_(0)
+          vectorizedAlignment_(true)
     {
         enterVertex_ = addVertex('^', 0);
         exitVertex_  = addVertex('$', 0);
@@ -116,10 +405,10 @@ namespace detail {
 
     PoaGraphImpl::PoaGraphImpl(const PoaGraphImpl& other)
         : g_(other.g_),
-          vertexInfoMap_(get(vertex_info, g_)),
           enterVertex_(other.enterVertex_),
           exitVertex_(other.exitVertex_),
-          numReads_(other.numReads_)
+          numReads_(other.numReads_),
+          vectorizedAlignment_(other.vectorizedAlignment_)
     {}
 
     PoaGraphImpl::~PoaGraphImpl()
@@ -128,65 +417,55 @@ namespace detail {
     void PoaGraphImpl::repCheck() const
     {
         // assert the representation invariant for the object
-        foreach (VD v, vertices(g_))
+        assert(g_.OrderIsTopological());
+        for (VD v = 0; v < g_.NumVertices(); v++)
         {
+            assert(g_[v].Id == v);
             if (v == enterVertex_)
             {
-                assert(in_degree(v, g_) == 0);
-                assert(out_degree(v, g_) > 0 || NumReads() == 0);
+                assert(g_.InEdges(v).empty());
+                assert(!g_.OutEdges(v).empty() || NumReads() == 0);
             }
             else if (v == exitVertex_)
             {
-                assert(in_degree(v, g_) > 0 || NumReads() == 0);
-                assert(out_degree(v, g_) == 0);
+                assert(!g_.InEdges(v).empty() || NumReads() == 0);
+                assert(g_.OutEdges(v).empty());
             }
             else
             {
-                assert(in_degree(v, g_) > 0);
-                assert(out_degree(v, g_) > 0);
+                assert(!g_.InEdges(v).empty());
+                assert(!g_.OutEdges(v).empty());
             }
         }
     }
 
-    static inline vector<const AlignmentColumn*>
-    getPredecessorColumns(const BoostGraph& g,
-                          VD v,
-                          const AlignmentColumnMap& colMap)
-    {
-        vector<const AlignmentColumn*> predecessorColumns;
-        const AlignmentColumn* predCol;
-        foreach (ED e, inEdges(v, g))
-        {
-            VD u = source(e, g);
-            predCol = colMap.at(u);
-            assert(predCol != NULL);
-            predecessorColumns.push_back(predCol);
-        }
-        return predecessorColumns;
-    }
-
     PoaConsensus*
     PoaGraphImpl::FindConsensus(const AlignConfig& config, int minCoverage)
     {
+        // The reads are in by now; don't hold the largest alignment's
+        // storage for the rest of the graph's life
+        spareMatrix_.reset();
+
         std::vector<VD> bestPath = consensusPath(config.Mode, minCoverage);
-        std::string consensusSequence = sequenceAlongPath(g_, vertexInfoMap_, bestPath);
+        std::string consensusSequence = sequenceAlongPath(g_, bestPath);
         PoaConsensus* pc = new PoaConsensus(consensusSequence, *this, externalizePath(bestPath));
         return pc;
     }
 
-    const AlignmentColumn*
+    void
     PoaGraphImpl::makeAlignmentColumnForExit(VD v,
-                                             const AlignmentColumnMap& colMap,
+                                             AlignmentColumnArena& colMap,
                                              const std::string& sequence,
                                              const AlignConfig& config) const
     {
-        assert(out_degree(v, g_) == 0);
+        assert(g_.OutEdges(v).empty());
 
-        // this is kind of unnecessary as we are only actually using one entry in this column
+        // only the entry for the whole read is used
         int I = sequence.length();
-        AlignmentColumn* curCol = new AlignmentColumn(v, I + 1);
+        AlignmentColumn* curCol = colMap[v];
+        assert(curCol->BeginRow() == I && curCol->EndRow() == I + 1);
 
-        float bestScore = -FLT_MAX;
+        int bestScore = -INT_MAX;
         VD prevVertex = null_vertex;
 
         // Under local or semiglobal alignment the vertex $ can be
@@ -196,14 +475,15 @@ namespace detail {
         // row, not necessarily I.
         if (config.Mode == SEMIGLOBAL || config.Mode == LOCAL)
         {
-            foreach (VD u, vertices(g_))
+            for (VD u = 0; u < g_.NumVertices(); u++)
             {
                 if (u != exitVertex_)
                 {
-                    const AlignmentColumn* predCol = colMap.at(u);
+                    const AlignmentColumn* predCol = colMap[u];
+                    if (predCol->EndRow() == predCol->BeginRow()) continue;
                     int prevRow = (config.Mode == LOCAL ? ArgMax(predCol->Score) : I);
 
-                    if (predCol->Score[prevRow] > bestScore)
+                    if (predCol->HasScore(prevRow) && predCol->Score[prevRow] > bestScore)
                     {
                         bestScore = predCol->Score[prevRow];
                         prevVertex = predCol->CurrentVertex;
@@ -214,78 +494,392 @@ namespace detail {
         else
         {
             // regular predecessors
-            vector<const AlignmentColumn*> predecessorColumns  =
-                    getPredecessorColumns(g_, v, colMap);
+            const vector<const AlignmentColumn*>& predecessorColumns =
+                    colMap.PredecessorColumns(g_, v);
             foreach (const AlignmentColumn * predCol, predecessorColumns)
             {
-                if (predCol->Score[I] > bestScore)
+                if (predCol->HasScore(I) && predCol->Score[I] > bestScore)
                 {
                     bestScore = predCol->Score[I];
                     prevVertex = predCol->CurrentVertex;
                 }
             }
         }
-        assert(prevVertex != null_vertex);
-        curCol->Score[I] = bestScore;
-        curCol->PreviousVertex[I] = prevVertex;
-        curCol->ReachingMove[I] = EndMove;
-        return curCol;
+        // (if the bands let no alignment through, the cell is left
+        // invalid and TryAddRead aligns again without them)
+        if (prevVertex != null_vertex)
+        {
+            curCol->Score[I] = bestScore;
+            curCol->SetTraceback(I, EndMove);
+            curCol->EndPredecessor = prevVertex;
+        }
+    }
+
+    VD PoaGraphImpl::previousVertex(const AlignmentColumn* column, int i) const
+    {
+        switch (column->ReachingMove(i))
+        {
+            case MatchMove:
+            case MismatchMove:
+            case DeleteMove:
+                return g_.InEdges(column->CurrentVertex)[column->PredecessorIndex(i)];
+            case ExtraMove:
+                return column->CurrentVertex;
+            case StartMove:
+                return enterVertex_;
+            case EndMove:
+                return column->EndPredecessor;
+            default:
+                return null_vertex;
+        }
+    }
+
+    bool PoaGraphImpl::scoresFitInt16(int readLength, const AlignParams& params) const
+    {
+        // Every cell's score is the sum of the moves on an alignment
+        // path ending there; there are at most readLength of them, plus
+        // one for each vertex of the longest path through the graph.
+        std::vector<VD> order = g_.TopologicalOrder();
+        std::vector<int> depth(g_.NumVertices(), 0);
+        int longestPath = 0;
+        foreach (VD v, order)
+        {
+            foreach (VD u, g_.InEdges(v))
+            {
+                depth[v] = std::max(depth[v], depth[u] + 1);
+            }
+            longestPath = std::max(longestPath, depth[v]);
+        }
+        int maxParam = std::max(std::max(std::abs(params.Match), std::abs(params.Mismatch)),
+                                std::max(std::abs(params.Insert), std::abs(params.Delete)));
+        // The kernel also tells cells with no score (SHRT_MIN, plus at
+        // most a match and seven inserts) from real ones by their
+        // being below -MAX_INT16_SCORE.
+        return (static_cast<double>(maxParam) * (readLength + longestPath + 16) <= MAX_INT16_SCORE &&
+                8 * maxParam < -MAX_INT16_SCORE - SHRT_MIN);
+    }
+
+    //
+    // The substitution score of each read position against each base,
+    // and whether it is a match, laid out by alignment row for the
+    // SSE2 kernel (row i holds read position i - 1).  Built as bases
+    // are asked for.
+    //
+    class ReadProfile
+    {
+    public:
+        ReadProfile(const std::string& sequence, const AlignParams& params)
+            : sequence_(sequence)
+            , params_(params)
+            , profiles_(256)
+        {}
+
+        const int16_t* Substitution(char base) const { return profile(base).Substitution; }
+        const int16_t* DiagonalMove(char base) const { return profile(base).DiagonalMove; }
+
+    private:
+        struct BaseProfile
+        {
+            const int16_t* Substitution;
+            const int16_t* DiagonalMove;
+            std::vector<int16_t> Storage;
+        };
+
+        const BaseProfile& profile(char base) const
+        {
+            boost::shared_ptr<BaseProfile>& p = profiles_[static_cast<unsigned char>(base)];
+            if (!p)
+            {
+                const int rows = sequence_.length() + 1;
+                p.reset(new BaseProfile());
+                p->Storage.resize(2 * rows, 0);
+                int16_t* substitution = &p->Storage[0];
+                int16_t* diagonalMove = &p->Storage[rows];
+                for (int i = 1; i < rows; i++)
+                {
+                    bool isMatch = sequence_[i - 1] == base;
+                    substitution[i] = isMatch ? params_.Match : params_.Mismatch;
+                    diagonalMove[i] = isMatch ? MatchMove : MismatchMove;
+                }
+                p->Substitution = substitution;
+                p->DiagonalMove = diagonalMove;
+            }
+            return *p;
+        }
+
+        const std::string& sequence_;
+        AlignParams params_;
+        mutable std::vector<boost::shared_ptr<BaseProfile> > profiles_;
+    };
+
+    // Row i (>= 1) of a column, from its predecessors and from row i - 1
+    static inline void
+    fillRow(AlignmentColumn* curCol,
+            const vector<const AlignmentColumn*>& predecessorColumns,
+            int i,
+            bool isMatch,
+            const AlignConfig& config)
+    {
+        int candidateScore, bestScore;
+        size_t bestPredecessor = 0;
+        MoveType reachingMove;
+
+        if (config.Mode == LOCAL)
+        {
+            bestScore = 0;
+            reachingMove = StartMove;
+        }
+        else
+        {
+            bestScore = -INT_MAX;
+            reachingMove = InvalidMove;
+        }
+
+        for (size_t k = 0; k < predecessorColumns.size(); k++)
+        {
+            const AlignmentColumn* prevCol = predecessorColumns[k];
+            // Incorporate (Match or Mismatch)
+            if (prevCol->HasScore(i - 1))
+            {
+                candidateScore = prevCol->Score[i - 1] + (isMatch ?
+                                                          config.Params.Match :
+                                                          config.Params.Mismatch);
+                if (candidateScore > bestScore)
+                {
+                    bestScore = candidateScore;
+                    bestPredecessor = k;
+                    reachingMove = (isMatch ? MatchMove : MismatchMove);
+                }
+            }
+            // Delete
+            if (prevCol->HasScore(i))
+            {
+                candidateScore = prevCol->Score[i] + config.Params.Delete;
+                if (candidateScore > bestScore)
+                {
+                    bestScore = candidateScore;
+                    bestPredecessor = k;
+                    reachingMove = DeleteMove;
+                }
+            }
+        }
+        // Extra
+        if (curCol->HasScore(i - 1))
+        {
+            candidateScore = curCol->Score[i - 1] + config.Params.Insert;
+            if (candidateScore > bestScore)
+            {
+                bestScore = candidateScore;
+                reachingMove = ExtraMove;
+            }
+        }
+        // (with banding, a row may be out of reach: InvalidMove)
+        curCol->Score[i] = bestScore;
+        curCol->SetTraceback(i, reachingMove, bestPredecessor);
     }
 
-    const AlignmentColumn*
+    static inline __m128i select8(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    // Eight scores of a column from row i on, narrowed to 16 bits; rows
+    // outside its band, or without a score, read as SHRT_MIN
+    static inline __m128i loadScores8(const AlignmentColumn* column, int i)
+    {
+        if (column->BeginRow() <= i && i + 8 <= column->EndRow())
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(&column->Score[i]);
+            return _mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+        }
+        int scores[8];
+        for (int r = 0; r < 8; r++)
+        {
+            bool inBand = column->BeginRow() <= i + r && i + r < column->EndRow();
+            scores[r] = inBand ? column->Score[i + r] : -INT_MAX;
+        }
+        return _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(scores)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(scores + 4)));
+    }
+
+    static inline void storeScores8(ColumnRows<int>& scores, int i, __m128i x)
+    {
+        __m128i* p = reinterpret_cast<__m128i*>(&scores[i]);
+        _mm_storeu_si128(p,     _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+        _mm_storeu_si128(p + 1, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+    }
+
+    //
+    // Rows 1.. of a column (within its band), eight at a time in 16-bit
+    // lanes, with the same candidates compared in the same order as
+    // fillRow, so the same (first) best candidate wins.  The Extra
+    // move's dependence of each row on the one above is resolved
+    // afterwards by a prefix-max scan over the block.  Candidates built
+    // on a SHRT_MIN (no score) stay below every real score, so they
+    // never win over one, and lanes left with nothing else are marked
+    // as having no score.  Rows past the last whole block are left to
+    // fillRow.
+    //
+    static int
+    fillRowsSse(AlignmentColumn* curCol,
+                const vector<const AlignmentColumn*>& predecessorColumns,
+                const int16_t* substitution,
+                const int16_t* diagonalMove,
+                const AlignConfig& config)
+    {
+        const __m128i negInf = _mm_set1_epi16(SHRT_MIN);
+        const __m128i deleteScore = _mm_set1_epi16(config.Params.Delete);
+        const __m128i insertScore1 = _mm_set1_epi16(config.Params.Insert);
+        const __m128i insertScore2 = _mm_set1_epi16(2 * config.Params.Insert);
+        const __m128i insertScore4 = _mm_set1_epi16(4 * config.Params.Insert);
+        const __m128i deleteMove = _mm_set1_epi16(DeleteMove);
+        const __m128i extraMove = _mm_set1_epi16(ExtraMove);
+        const __m128i invalidMove = _mm_set1_epi16(InvalidMove);
+        const __m128i noScoreBound = _mm_set1_epi16(-MAX_INT16_SCORE);
+        const __m128i lowMask = _mm_set1_epi16(AlignmentColumn::NARROW_PREDECESSOR_LIMIT - 1);
+        const bool wide = curCol->WidePredecessors();
+
+        int i = std::max(curCol->BeginRow(), 1);
+        for (; i + 8 <= curCol->EndRow(); i += 8)
+        {
+            __m128i best, move;
+            if (config.Mode == LOCAL)
+            {
+                best = _mm_setzero_si128();
+                move = _mm_set1_epi16(StartMove);
+            }
+            else
+            {
+                best = negInf;
+                move = _mm_set1_epi16(InvalidMove);
+            }
+            __m128i predecessor = _mm_setzero_si128();
+            __m128i matchScore = _mm_loadu_si128(reinterpret_cast<const __m128i*>(substitution + i));
+            __m128i matchMove = _mm_loadu_si128(reinterpret_cast<const __m128i*>(diagonalMove + i));
+
+            for (size_t k = 0; k < predecessorColumns.size(); k++)
+            {
+                const AlignmentColumn* prevCol = predecessorColumns[k];
+                if (i + 8 <= prevCol->BeginRow() || i - 1 >= prevCol->EndRow())
+                {
+                    continue;  // the block is outside prevCol's band
+                }
+                __m128i index = _mm_set1_epi16(k);
+
+                __m128i candidate = _mm_adds_epi16(loadScores8(prevCol, i - 1), matchScore);
+                __m128i better = _mm_cmpgt_epi16(candidate, best);
+                best = _mm_max_epi16(best, candidate);
+                move = select8(better, matchMove, move);
+                predecessor = select8(better, index, predecessor);
+
+                candidate = _mm_adds_epi16(loadScores8(prevCol, i), deleteScore);
+                better = _mm_cmpgt_epi16(candidate, best);
+                best = _mm_max_epi16(best, candidate);
+                move = select8(better, deleteMove, move);
+                predecessor = select8(better, index, predecessor);
+            }
+
+            // Extra: score[r] = max(best[r], score[r - 1] + Insert)
+            __m128i carry = negInf;
+            if (curCol->HasScore(i - 1))
+            {
+                carry = _mm_insert_epi16(carry, curCol->Score[i - 1] + config.Params.Insert, 0);
+            }
+            __m128i score = _mm_max_epi16(best, carry);
+            score = _mm_max_epi16(score, _mm_adds_epi16(
+                _mm_or_si128(_mm_slli_si128(score, 2), _mm_srli_si128(negInf, 14)), insertScore1));
+            score = _mm_max_epi16(score, _mm_adds_epi16(
+                _mm_or_si128(_mm_slli_si128(score, 4), _mm_srli_si128(negInf, 12)), insertScore2));
+            score = _mm_max_epi16(score, _mm_adds_epi16(
+                _mm_or_si128(_mm_slli_si128(score, 8), _mm_srli_si128(negInf, 8)), insertScore4));
+            move = select8(_mm_cmpgt_epi16(score, best), extraMove, move);
+
+            storeScores8(curCol->Score, i, score);
+            __m128i noScore = _mm_cmplt_epi16(score, noScoreBound);
+            if (_mm_movemask_epi8(noScore))
+            {
+                move = select8(noScore, invalidMove, move);
+                predecessor = _mm_andnot_si128(noScore, predecessor);
+                for (int r = 0; r < 8; r++)
+                {
+                    if (curCol->Score[i + r] < -MAX_INT16_SCORE) curCol->Score[i + r] = -INT_MAX;
+                }
+            }
+            __m128i traceback = _mm_or_si128(move, _mm_slli_epi16(_mm_and_si128(predecessor, lowMask),
+                                                                 AlignmentColumn::TRACEBACK_MOVE_BITS));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(&curCol->Traceback[i]),
+                             _mm_packus_epi16(traceback, traceback));
+            if (wide)
+            {
+                __m128i high = _mm_srli_epi16(predecessor, 8 - AlignmentColumn::TRACEBACK_MOVE_BITS);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(&curCol->PredecessorHigh[i]),
+                                 _mm_packus_epi16(high, high));
+            }
+        }
+        return i;
+    }
+
+    void
     PoaGraphImpl::makeAlignmentColumn(VD v,
-                                      const AlignmentColumnMap& colMap,
+                                      AlignmentColumnArena& colMap,
                                       const std::string& sequence,
                                       const AlignConfig& config,
-                                      int beginRow,
-                                      int endRow) const
+                                      const ReadProfile* profile) const
     {
-        AlignmentColumn* curCol = new AlignmentColumn(v, sequence.length() + 1);
-        const PoaNode& vertexInfo = vertexInfoMap_[v];
-        vector<const AlignmentColumn*> predecessorColumns =
-                getPredecessorColumns(g_, v, colMap);
+        const PoaNode& vertexInfo = g_[v];
+        const vector<const AlignmentColumn*>& predecessorColumns =
+                colMap.PredecessorColumns(g_, v);
+        AlignmentColumn* curCol = colMap[v];
+        const int beginRow = curCol->BeginRow();
+        const int endRow = curCol->EndRow();
+        assert(0 <= beginRow && beginRow <= endRow &&
+               endRow <= static_cast<int>(sequence.length()) + 1);
+        assert(curCol->WidePredecessors() ==
+               (predecessorColumns.size() > AlignmentColumn::NARROW_PREDECESSOR_LIMIT &&
+                endRow > beginRow));
 
         //
         // handle row 0 separately:
         //
-        if (predecessorColumns.size() == 0)
+        if (beginRow > 0 || endRow <= beginRow)
+        {
+            // row 0 is outside the band
+        }
+        else if (predecessorColumns.size() == 0)
         {
             // if this vertex doesn't have any in-edges it is ^; has
             // no reaching move
             assert(v == enterVertex_);
             curCol->Score[0] = 0;
-            curCol->ReachingMove[0] = InvalidMove;
-            curCol->PreviousVertex[0] = null_vertex;
+            curCol->SetTraceback(0, InvalidMove);
         }
         else if (config.Mode == SEMIGLOBAL  || config.Mode == LOCAL)
         {
             // under semiglobal or local alignment, we use the Start move
             curCol->Score[0] = 0;
-            curCol->ReachingMove[0] = StartMove;
-            curCol->PreviousVertex[0] = enterVertex_;
+            curCol->SetTraceback(0, StartMove);
         }
         else
         {
             // otherwise it's a deletion
-            float candidateScore;
-            float bestScore = -FLT_MAX;
-            VD prevVertex = null_vertex;
+            int candidateScore;
+            int bestScore = -INT_MAX;
+            size_t bestPredecessor = 0;
             MoveType reachingMove = InvalidMove;
 
-            foreach (const AlignmentColumn * prevCol, predecessorColumns)
+            for (size_t k = 0; k < predecessorColumns.size(); k++)
             {
-                candidateScore = prevCol->Score[0] + config.Params.Delete;
+                if (!predecessorColumns[k]->HasScore(0)) continue;
+                candidateScore = predecessorColumns[k]->Score[0] + config.Params.Delete;
                 if (candidateScore > bestScore)
                 {
                     bestScore = candidateScore;
-                    prevVertex = prevCol->CurrentVertex;
+                    bestPredecessor = k;
                     reachingMove = DeleteMove;
                 }
             }
-            assert(reachingMove != InvalidMove);
             curCol->Score[0] = bestScore;
-            curCol->ReachingMove[0] = reachingMove;
-            curCol->PreviousVertex[0] = prevVertex;
+            curCol->SetTraceback(0, reachingMove, bestPredecessor);
         }
 
         //
@@ -293,62 +887,18 @@ namespace detail {
         //
         // i represents position in array
         // readPos=i-1 represents position in read
-        for (unsigned int i = 1, readPos = 0;  i <= sequence.length(); i++, readPos++)
+        int i = std::max(beginRow, 1);
+        if (profile != NULL)
         {
-            float candidateScore, bestScore;
-            VD prevVertex;
-            MoveType reachingMove;
-
-            if (config.Mode == LOCAL)
-            {
-                bestScore = 0;
-                prevVertex = enterVertex_;
-                reachingMove = StartMove;
-            }
-            else
-            {
-                bestScore = -FLT_MAX;
-                prevVertex = null_vertex;
-                reachingMove = InvalidMove;
-            }
-
-            foreach (const AlignmentColumn* prevCol, predecessorColumns)
-            {
-                // Incorporate (Match or Mismatch)
-                bool isMatch = sequence[readPos] == vertexInfo.Base;
-                candidateScore = prevCol->Score[i - 1] + (isMatch ?
-                                                             config.Params.Match :
-                                                             config.Params.Mismatch);
-                if (candidateScore > bestScore)
-                {
-                    bestScore = candidateScore;
-                    prevVertex = prevCol->CurrentVertex;
-                    reachingMove = (isMatch ? MatchMove : MismatchMove);
-                }
-                // Delete
-                candidateScore = prevCol->Score[i] + config.Params.Delete;
-                if (candidateScore > bestScore)
-                {
-                    bestScore = candidateScore;
-                    prevVertex = prevCol->CurrentVertex;
-                    reachingMove = DeleteMove;
-                }
-            }
-            // Extra
-            candidateScore = curCol->Score[i - 1] + config.Params.Insert;
-            if (candidateScore > bestScore)
-            {
-                bestScore = candidateScore;
-                prevVertex = v;
-                reachingMove = ExtraMove;
-            }
-            assert(reachingMove != InvalidMove);
-            curCol->Score[i] = bestScore;
-            curCol->ReachingMove[i] = reachingMove;
-            curCol->PreviousVertex[i] = prevVertex;
+            i = fillRowsSse(curCol, predecessorColumns,
+                            profile->Substitution(vertexInfo.Base),
+                            profile->DiagonalMove(vertexInfo.Base),
+                            config);
+        }
+        for (; i < endRow; i++)
+        {
+            fillRow(curCol, predecessorColumns, i, sequence[i - 1] == vertexInfo.Base, config);
         }
-
-        return curCol;
     }
 
     void PoaGraphImpl::AddRead(const std::string& readSeq,
@@ -362,9 +912,14 @@ namespace detail {
         }
         else
         {
-            PoaAlignmentMatrixImpl* mat = TryAddRead(readSeq, config, rangeFinder);
-            CommitAdd(mat, readPathOutput);
-            delete mat;
+            // (the alignment is kept, so that its arena serves the next
+            // read too)
+            if (!spareMatrix_)
+            {
+                spareMatrix_.reset(new PoaAlignmentMatrixImpl());
+            }
+            alignRead(readSeq, config, rangeFinder, spareMatrix_.get());
+            CommitAdd(spareMatrix_.get(), readPathOutput);
         }
     }
 
@@ -385,53 +940,113 @@ namespace detail {
     PoaGraphImpl::TryAddRead(const std::string& readSeq,
                              const AlignConfig& config,
                              SdpRangeFinder* rangeFinder) const
+    {
+        PoaAlignmentMatrixImpl* mat = new PoaAlignmentMatrixImpl();
+        alignRead(readSeq, config, rangeFinder, mat);
+        return mat;
+    }
+
+    void
+    PoaGraphImpl::alignRead(const std::string& readSeq,
+                            const AlignConfig& config,
+                            SdpRangeFinder* rangeFinder,
+                            PoaAlignmentMatrixImpl* mat) const
     {
         DEBUG_ONLY(repCheck());
         assert(readSeq.length() > 0);
         assert(numReads_ > 0);
 
-        // Prepare the range finder, if applicable
+        // Prepare the range finder, if applicable.  Without one, GLOBAL
+        // alignments are banded around the diagonal of the consensus.
+        DiagonalRangeFinder diagonalRangeFinder;
+        if (rangeFinder == NULL && config.Mode == GLOBAL)
+        {
+            rangeFinder = &diagonalRangeFinder;
+        }
         if (rangeFinder != NULL)
         {
             // NB: no minCoverage applicable here; this
             // "intermediate" consensus may include extra sequence
             // at either end
             std::vector<VD> cssPath = consensusPath(config.Mode);
-            std::string cssSeq = sequenceAlongPath(g_, vertexInfoMap_, cssPath);
+            std::string cssSeq = sequenceAlongPath(g_, cssPath);
             rangeFinder->InitRangeFinder(*this, externalizePath(cssPath), cssSeq, readSeq);
         }
 
+        boost::scoped_ptr<ReadProfile> profile;
+        if (vectorizedAlignment_ && scoresFitInt16(readSeq.size(), config.Params))
+        {
+            profile.reset(new ReadProfile(readSeq, config.Params));
+        }
+
+        alignColumns(readSeq, config, rangeFinder, profile.get(), mat);
+        const AlignmentColumn* exitCol = mat->columns_[exitVertex_];
+        if (rangeFinder != NULL && exitCol->ReachingMove(readSeq.size()) == InvalidMove)
+        {
+            // the bands cut off every alignment of the whole read
+            alignColumns(readSeq, config, NULL, profile.get(), mat);
+            exitCol = mat->columns_[exitVertex_];
+        }
+        mat->score_ = exitCol->Score[readSeq.size()];
+        DEBUG_ONLY(repCheck());
+    }
+
+    void
+    PoaGraphImpl::alignColumns(const std::string& readSeq,
+                               const AlignConfig& config,
+                               SdpRangeFinder* rangeFinder,
+                               const ReadProfile* profile,
+                               PoaAlignmentMatrixImpl* mat) const
+    {
+        const int I = readSeq.size();
+
         // Calculate alignment columns of sequence vs. graph, using sparsity if
         // we have a range finder.
-        PoaAlignmentMatrixImpl* mat = new PoaAlignmentMatrixImpl();
         mat->readSequence_ = readSeq;
         mat->mode_ = config.Mode;
 
-        vector<VD> sortedVertices(num_vertices(g_));
-        topological_sort(g_, sortedVertices.rbegin());
-        const AlignmentColumn* curCol;
-        foreach (VD v, sortedVertices)
+        // Lay out every column's rows first, so that the arena can
+        // place them all at once
+        AlignmentColumnArena& columns = mat->columns_;
+        columns.Reset(g_.NumVertices());
+        for (VD v = g_.FirstInOrder(); v != null_vertex; v = g_.NextInOrder(v))
         {
             if (v != exitVertex_)
             {
-                Interval rowRange;
-                if (rangeFinder) {
-                    rowRange = rangeFinder->FindAlignableRange(externalize(v));
-                } else {
-                    rowRange = Interval(0, readSeq.size());
+                // The read positions [Begin, End) aligned to v are
+                // consumed by rows Begin + 1 .. End; row Begin holds
+                // where v is entered from.  Every alignment starts at
+                // row 0 of ^.
+                int beginRow = 0, endRow = I + 1;
+                if (rangeFinder)
+                {
+                    Interval readRange = rangeFinder->FindAlignableRange(externalize(v));
+                    beginRow = (v == enterVertex_ ? 0 : std::min(std::max(readRange.Begin, 0), I + 1));
+                    endRow = std::max(std::min(readRange.End, I) + 1, beginRow);
+                    if (v == enterVertex_)
+                    {
+                        endRow = std::max(endRow, 1);
+                    }
                 }
-                curCol = makeAlignmentColumn(v, mat->columns_, readSeq, config, rowRange.Begin, rowRange.End);
+                columns.Layout(v, beginRow, endRow,
+                               g_.InEdges(v).size() > AlignmentColumn::NARROW_PREDECESSOR_LIMIT);
             }
             else {
-                curCol = makeAlignmentColumnForExit(v, mat->columns_, readSeq, config);
+                columns.Layout(v, I, I + 1);
             }
-            mat->columns_[v] = curCol;
         }
+        columns.Allocate();
 
-        mat->score_ = mat->columns_[exitVertex_]->Score[readSeq.size()];
-        DEBUG_ONLY(repCheck());
-
-        return mat;
+        for (VD v = g_.FirstInOrder(); v != null_vertex; v = g_.NextInOrder(v))
+        {
+            if (v != exitVertex_)
+            {
+                makeAlignmentColumn(v, columns, readSeq, config, profile);
+            }
+            else {
+                makeAlignmentColumnForExit(v, columns, readSeq, config);
+            }
+        }
     }
 
     void
@@ -454,10 +1069,22 @@ namespace detail {
     string PoaGraphImpl::ToGraphViz(int flags, const PoaConsensus* pc) const
     {
        std::stringstream ss;
-       write_graphviz(ss, g_, my_label_writer(vertexInfoMap_,
-                                              flags & PoaGraph::COLOR_NODES,
-                                              flags & PoaGraph::VERBOSE_NODES,
-                                              pc));
+       PoaLabelWriter writeLabel(g_,
+                                 flags & PoaGraph::COLOR_NODES,
+                                 flags & PoaGraph::VERBOSE_NODES,
+                                 pc);
+       ss << "digraph G {" << std::endl;
+       for (VD v = 0; v < g_.NumVertices(); v++)
+       {
+           ss << v;
+           writeLabel(ss, v);
+           ss << ";" << std::endl;
+       }
+       foreach (const CompactGraph::Edge& e, g_.Edges())
+       {
+           ss << e.first << "->" << e.second << " ;" << std::endl;
+       }
+       ss << "}" << std::endl;
        return ss.str();
     }
 
@@ -9,38 +9,31 @@
 
 #include <ConsensusCore/Align/AlignConfig.hpp>
 #include <ConsensusCore/Poa/PoaGraph.hpp>
-#include <ConsensusCore/Matrix/VectorL.hpp>
 
-#include <boost/config.hpp>
 #include <boost/format.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/static_assert.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
-#include <boost/type_traits.hpp>
 #include <boost/utility.hpp>
+#include <algorithm>
+#include <cassert>
 #include <cfloat>
 #include <climits>
+#include <stdexcept>
+#include <stdint.h>
+#include <utility>
 #include <vector>
 
 using std::string;
 using std::vector;
 
-///
-///  Boost graph library typedefs, properties, and graphviz output.
-///
 using namespace boost; // NOLINT
 
-namespace boost
-{
-    enum vertex_info_t { vertex_info = 424 };  // a unique #
-    BOOST_INSTALL_PROPERTY(vertex, info);
-}
-
 
 namespace ConsensusCore {
 namespace detail {
 
     class SdpRangeFinder;
+    class ReadProfile;
 
     enum MoveType
     {
@@ -61,8 +54,9 @@ namespace detail {
         int Reads;
         // move the below out of here?
         int SpanningReads;
-        float Score;
-        float ReachingScore;
+        // Scratch values recomputed by every (const) consensusPath call
+        mutable float Score;
+        mutable float ReachingScore;
 
         void Init(size_t id, char base, int reads)
         {
@@ -90,88 +84,367 @@ namespace detail {
         }
     };
 
-    // BGL is intimidating, and it *deserves* your hatred.  But it's
-    // the only game in town!
-    typedef property<vertex_info_t, PoaNode, property<vertex_index_t, size_t> > vertex_property_t;
-    typedef adjacency_list<setS, listS, bidirectionalS, vertex_property_t> BoostGraph;
+    // Vertex ids are dense integers, assigned in order of insertion.
+    // The same id is used internally and externally.
+    typedef size_t VD;
+    typedef size_t Vertex;
+    static const VD null_vertex = static_cast<VD>(-1);
+
+    //
+    // A sorted set of vertex ids, used for the in- and out-adjacency of
+    // a vertex.  Nearly every POA vertex has degree one or two, so up to
+    // INLINE_CAPACITY ids are kept in the object itself and only
+    // higher-degree vertices pay for a heap block.
+    //
+    class AdjacencyList
+    {
+    public:
+        typedef const VD* iterator;
+        typedef const VD* const_iterator;
 
+        AdjacencyList()
+            : size_(0)
+            , capacity_(INLINE_CAPACITY)
+        {}
 
-    // Descriptor types used internally
-    typedef graph_traits<BoostGraph>::edge_descriptor   ED;
-    typedef graph_traits<BoostGraph>::vertex_descriptor VD;
+        AdjacencyList(const AdjacencyList& other)
+            : size_(0)
+            , capacity_(INLINE_CAPACITY)
+        {
+            assign(other);
+        }
 
-    // External-facing vertex id type
-    typedef size_t Vertex;
+        AdjacencyList& operator=(const AdjacencyList& other)
+        {
+            if (this != &other)
+            {
+                release();
+                assign(other);
+            }
+            return *this;
+        }
 
-    typedef property_map<BoostGraph, vertex_info_t>::type VertexInfoMap;
-    typedef property_map<BoostGraph, vertex_index_t>::type index_map_t;
-    static const VD null_vertex = graph_traits<BoostGraph>::null_vertex();
+        ~AdjacencyList()
+        {
+            release();
+        }
 
+        size_t size() const               { return size_; }
+        bool empty() const                { return size_ == 0; }
+        VD operator[](size_t k) const     { return data()[k]; }
+        const_iterator begin() const      { return data(); }
+        const_iterator end() const        { return data() + size_; }
 
-    struct EdgeComparator
-    {
-        EdgeComparator(const BoostGraph& g) : g_(g) {}
+        bool Contains(VD v) const
+        {
+            return std::binary_search(begin(), end(), v);
+        }
 
-        // want lex. comparison... just using pair to get it..
-        bool operator() (ED e1, ED e2)
+        // Inserts v in sorted position; returns false if already present.
+        bool Insert(VD v)
         {
-            std::pair<int, int> vt1, vt2;
-            vt1 = std::make_pair(get(vertex_index, g_, source(e1, g_)),
-                                 get(vertex_index, g_, target(e1, g_)));
-            vt2 = std::make_pair(get(vertex_index, g_, source(e2, g_)),
-                                 get(vertex_index, g_, target(e2, g_)));
-            return (vt1 < vt2);
+            VD* pos = std::lower_bound(data(), data() + size_, v);
+            if (pos != data() + size_ && *pos == v)
+            {
+                return false;
+            }
+            size_t k = pos - data();
+            if (size_ == capacity_)
+            {
+                grow();
+            }
+            VD* d = data();
+            std::copy_backward(d + k, d + size_, d + size_ + 1);
+            d[k] = v;
+            size_++;
+            return true;
         }
 
     private:
-        const BoostGraph& g_;
+        enum { INLINE_CAPACITY = 2 };
+
+        bool onHeap() const { return capacity_ > INLINE_CAPACITY; }
+        VD* data()             { return onHeap() ? heap_ : inline_; }
+        const VD* data() const { return onHeap() ? heap_ : inline_; }
+
+        void grow()
+        {
+            uint32_t newCapacity = 2 * capacity_;
+            VD* block = new VD[newCapacity];
+            std::copy(data(), data() + size_, block);
+            release();
+            heap_ = block;
+            capacity_ = newCapacity;
+        }
+
+        void release()
+        {
+            if (onHeap())
+            {
+                delete[] heap_;
+                capacity_ = INLINE_CAPACITY;
+            }
+        }
+
+        void assign(const AdjacencyList& other)
+        {
+            if (other.onHeap())
+            {
+                heap_ = new VD[other.capacity_];
+                capacity_ = other.capacity_;
+            }
+            std::copy(other.begin(), other.end(), data());
+            size_ = other.size_;
+        }
+
+        union
+        {
+            VD inline_[INLINE_CAPACITY];
+            VD* heap_;
+        };
+        uint32_t size_;
+        uint32_t capacity_;
     };
 
-    inline std::vector<ED> inEdges(VD v, const BoostGraph& g)
+    //
+    // The POA graph proper: vertices live in a vector indexed by id,
+    // alongside their sorted in- and out-adjacency.  Edges are also
+    // recorded in order of insertion, which is the order GraphViz
+    // output lists them in.  Vertices and edges are never removed.
+    //
+    // A topological order of the vertices is maintained as edges are
+    // added, as a doubly-linked list carrying increasing integer
+    // labels.  A vertex with no edges yet can go anywhere, so its first
+    // edge just splices it in next to the other endpoint; threading a
+    // read only ever creates such vertices, and otherwise adds edges
+    // that agree with the order.  Any other edge that contradicts the
+    // order is repaired by Pearce & Kelly's local reordering.
+    //
+    class CompactGraph
     {
-        // This is a sad workaround the nondeterministic order of iteration
-        // from BGL's in_edges. (see: http://stackoverflow.com/questions/30968690/)
-
-        // Unfortunately, we can't just use the boost::sort range adapter
-        // because it requires an underlying random access iterator, which
-        // we can't get from the std::set container.
-        graph_traits<BoostGraph>::in_edge_iterator begin, end;
-        tie(begin, end) = in_edges(v, g);
-        std::vector<ED> tmp(begin, end);
-        std::sort(tmp.begin(), tmp.end(), EdgeComparator(g));
-        return tmp;
-       }
-
-    struct AlignmentColumn : noncopyable
+    public:
+        typedef std::pair<VD, VD> Edge;
+
+        CompactGraph()
+            : head_(null_vertex)
+            , tail_(null_vertex)
+        {}
+
+        size_t NumVertices() const { return nodes_.size(); }
+        size_t NumEdges() const    { return edges_.size(); }
+
+        PoaNode& operator[](VD v)             { return nodes_[v]; }
+        const PoaNode& operator[](VD v) const { return nodes_[v]; }
+
+        const AdjacencyList& InEdges(VD v) const  { return inEdges_[v]; }
+        const AdjacencyList& OutEdges(VD v) const { return outEdges_[v]; }
+        const std::vector<Edge>& Edges() const    { return edges_; }
+
+        // New vertices go at the end of the topological order.
+        VD AddVertex(char base, int nReads);
+
+        // Parallel edges are not added, matching a set-based edge list.
+        void AddEdge(VD u, VD v);
+
+        // Walking the topological order: the first vertex, and the one
+        // after v (null_vertex after the last).
+        VD FirstInOrder() const  { return head_; }
+        VD NextInOrder(VD v) const { return next_[v]; }
+
+        // All the vertices, in topological order
+        std::vector<VD> TopologicalOrder() const;
+
+        // Does the order agree with every edge?  O(V + E); for repCheck.
+        bool OrderIsTopological() const;
+
+    private:
+        bool isIsolated(VD v) const
+        {
+            return inEdges_[v].empty() && outEdges_[v].empty();
+        }
+
+        void unlink(VD v);
+        void linkAfter(VD u, VD v);   // u == null_vertex: at the front
+        void linkBefore(VD w, VD v);  // w == null_vertex: at the back
+        void relabelAfter(VD u);
+        void reorder(VD u, VD v);
+        void collectAffected(VD start, bool forward, uint64_t bound,
+                             std::vector<VD>* affected);
+
+    private:
+        std::vector<PoaNode> nodes_;
+        std::vector<AdjacencyList> inEdges_;
+        std::vector<AdjacencyList> outEdges_;
+        std::vector<Edge> edges_;
+
+        // topological order
+        std::vector<VD> prev_;
+        std::vector<VD> next_;
+        std::vector<uint64_t> label_;
+        VD head_;
+        VD tail_;
+        std::vector<bool> visited_;  // scratch for reorder
+    };
+
+    //
+    // Rows [BeginRow, EndRow) of one column, in storage owned by an
+    // AlignmentColumnArena
+    //
+    template<typename T>
+    class ColumnRows
     {
-        VD CurrentVertex;
-        VectorL<float> Score;
-        VectorL<MoveType> ReachingMove;
-        VectorL<VD> PreviousVertex;
-
-        AlignmentColumn(VD vertex, int len)
-            : CurrentVertex(vertex),
-              Score(0, len, -FLT_MAX),
-              ReachingMove(0, len, InvalidMove),
-              PreviousVertex(0, len, null_vertex)
+    public:
+        ColumnRows()
+            : rows_(NULL), beginRow_(0), endRow_(0)
         {}
 
-        AlignmentColumn(VD vertex, int beginRow, int endRow)
-            : CurrentVertex(vertex),
-              Score(beginRow, endRow, -FLT_MAX),
-              ReachingMove(beginRow, endRow, InvalidMove),
-              PreviousVertex(beginRow, endRow, null_vertex)
+        ColumnRows(int beginRow, int endRow)
+            : rows_(NULL), beginRow_(beginRow), endRow_(endRow)
         {}
 
-        ~AlignmentColumn()
+        void SetStorage(T* rows) { rows_ = rows; }
+
+        T& operator[](int pos)
+        {
+            assert(beginRow_ <= pos && pos < endRow_);
+            return rows_[pos - beginRow_];
+        }
+
+        const T& operator[](int pos) const
+        {
+            assert(beginRow_ <= pos && pos < endRow_);
+            return rows_[pos - beginRow_];
+        }
+
+        int BeginRow() const { return beginRow_; }
+        int EndRow()   const { return endRow_;   }
+        int Length()   const { return endRow_ - beginRow_; }
+
+    private:
+        T* rows_;
+        int beginRow_;
+        int endRow_;
+    };
+
+    // The (first) row holding the greatest value; BeginRow if there
+    // are no rows
+    template<typename T>
+    int ArgMax(const ColumnRows<T>& v)
+    {
+        int best = v.BeginRow();
+        for (int i = v.BeginRow() + 1; i < v.EndRow(); i++)
+        {
+            if (v[i] > v[best]) best = i;
+        }
+        return best;
+    }
+
+    //
+    // One column of the read-to-graph alignment.  Scores are integers,
+    // as the AlignParams are.  The traceback of each cell is packed in a
+    // byte: the reaching move in the low three bits and, for moves from
+    // a predecessor (Match, Mismatch, Delete), its index among the
+    // in-edges of CurrentVertex in the high five.  A vertex with more
+    // than 32 in-edges keeps the rest of the index in PredecessorHigh.
+    // The vertex each move comes from is recovered by
+    // PoaGraphImpl::previousVertex.  Only the rows [BeginRow, EndRow)
+    // of a banded column are stored; the others, like cells no
+    // alignment reaches (Score -INT_MAX, InvalidMove), have no score.
+    //
+    struct AlignmentColumn
+    {
+        VD CurrentVertex;
+        ColumnRows<int> Score;
+        ColumnRows<uint8_t> Traceback;
+        ColumnRows<uint8_t> PredecessorHigh;
+        VD EndPredecessor;   // exit column: where the End move comes from
+
+        AlignmentColumn()
+            : CurrentVertex(null_vertex),
+              EndPredecessor(null_vertex)
         {}
 
         int BeginRow() const { return Score.BeginRow(); }
         int EndRow()   const { return Score.EndRow();   }
+
+        bool HasScore(int i) const
+        {
+            return BeginRow() <= i && i < EndRow() && Score[i] != -INT_MAX;
+        }
+
+        bool WidePredecessors() const
+        {
+            return PredecessorHigh.Length() > 0;
+        }
+
+        MoveType ReachingMove(int i) const
+        {
+            return static_cast<MoveType>(Traceback[i] & TRACEBACK_MOVE_MASK);
+        }
+
+        size_t PredecessorIndex(int i) const
+        {
+            size_t index = Traceback[i] >> TRACEBACK_MOVE_BITS;
+            if (WidePredecessors())
+            {
+                index |= static_cast<size_t>(PredecessorHigh[i]) << (8 - TRACEBACK_MOVE_BITS);
+            }
+            return index;
+        }
+
+        void SetTraceback(int i, MoveType move, size_t predecessorIndex=0)
+        {
+            Traceback[i] = static_cast<uint8_t>(move | (predecessorIndex << TRACEBACK_MOVE_BITS));
+            if (WidePredecessors())
+            {
+                PredecessorHigh[i] = static_cast<uint8_t>(predecessorIndex >> (8 - TRACEBACK_MOVE_BITS));
+            }
+        }
+
+        enum
+        {
+            TRACEBACK_MOVE_BITS = 3,
+            TRACEBACK_MOVE_MASK = (1 << TRACEBACK_MOVE_BITS) - 1,
+            NARROW_PREDECESSOR_LIMIT = 1 << (8 - TRACEBACK_MOVE_BITS)
+        };
     };
 
+    //
+    // The alignment columns of one read, indexed by vertex.  The columns
+    // are first laid out (their rows chosen), then Allocate carves the
+    // rows of all of them from one buffer per field.  The buffers keep
+    // their capacity from one Reset to the next, so an arena reused
+    // read after read stops allocating once it has held the largest
+    // alignment.
+    //
+    class AlignmentColumnArena : noncopyable
+    {
+    public:
+        // Start laying out an alignment to a graph of numVertices
+        void Reset(size_t numVertices);
+
+        // v's column is to hold rows [beginRow, endRow)
+        void Layout(VD v, int beginRow, int endRow, bool widePredecessors=false);
+
+        // Give every column laid out its rows, none with a score yet
+        void Allocate();
+
+        AlignmentColumn* operator[](VD v)             { return &columns_[v]; }
+        const AlignmentColumn* operator[](VD v) const { return &columns_[v]; }
+
+        // The columns of v's predecessors, in in-edge order (overwritten
+        // by the next call)
+        const std::vector<const AlignmentColumn*>&
+        PredecessorColumns(const CompactGraph& g, VD v);
+
+    private:
+        std::vector<AlignmentColumn> columns_;
+        std::vector<int> scores_;
+        std::vector<uint8_t> tracebacks_;
+        std::vector<uint8_t> predecessorHigh_;
+        std::vector<const AlignmentColumn*> predecessorColumns_;
+    };
 
-    typedef unordered_map<VD, const AlignmentColumn*> AlignmentColumnMap;
 
     class PoaAlignmentMatrixImpl : public PoaAlignmentMatrix
     {
@@ -180,7 +453,7 @@ namespace detail {
         virtual float Score() const;
 
     public:
-        AlignmentColumnMap columns_;
+        AlignmentColumnArena columns_;
         std::string readSequence_;
         AlignMode mode_;
         float score_;
@@ -191,20 +464,30 @@ namespace detail {
     {
         friend class SdpRangeFinder;
 
-        BoostGraph g_;
-        VertexInfoMap vertexInfoMap_;        // NB: this is a reference type and refers to an "internal" property map
-        index_map_t indexMap_;
+        CompactGraph g_;
         VD enterVertex_;
         VD exitVertex_;
         size_t numReads_;
-        size_t totalVertices_;               // includes "ex"-vertices which have since been removed
-        size_t liveVertices_;                // vertices that are in the graph.  this is needed for algorithms.
-        std::map<Vertex, VD> vertexLookup_;  // external ID -> internal ID
+        bool vectorizedAlignment_;
+        // AddRead's alignment, kept for the next read to reuse until
+        // FindConsensus releases it
+        boost::scoped_ptr<PoaAlignmentMatrixImpl> spareMatrix_;
 
         void repCheck() const;
 
-        Vertex externalize(VD vd) const         { return vertexInfoMap_[vd].Id; }
-        VD     internalize(Vertex vertex) const { return vertexLookup_.at(vertex); }
+        Vertex externalize(VD vd) const
+        {
+            return g_[vd].Id;
+        }
+
+        VD internalize(Vertex vertex) const
+        {
+            if (vertex >= g_.NumVertices())
+            {
+                throw std::out_of_range("PoaGraph: no such vertex");
+            }
+            return vertex;
+        }
 
         std::vector<Vertex> externalizePath(const std::vector<VD>& vds) const
         {
@@ -228,30 +511,53 @@ namespace detail {
 
         VD addVertex(char base, int nReads=1)
         {
-            VD vd = add_vertex(g_);
-            Vertex vExt = totalVertices_++;
-            vertexInfoMap_[vd] = PoaNode(vExt, base, nReads);
-            vertexLookup_[vExt] = vd;
-            indexMap_[vd] = liveVertices_++;
-            return vd;
+            return g_.AddVertex(base, nReads);
         }
 
         //
         // utility routines
         //
-        const AlignmentColumn*
+        //
+        // Only the rows v's column was laid out with are computed;
+        // predecessor rows outside their own bands count as -inf.
+        // profile, if not NULL, selects the SSE2 kernel; TryAddRead
+        // supplies one when scores are known to fit in 16 bits.
+        //
+        void
         makeAlignmentColumn(VD v,
-                            const AlignmentColumnMap& alignmentColumnForVertex,
+                            AlignmentColumnArena& alignmentColumnForVertex,
                             const std::string& sequence,
                             const AlignConfig& config,
-                            int beginRow, int endRow) const;
+                            const ReadProfile* profile=NULL) const;
 
-        const AlignmentColumn*
+        void
         makeAlignmentColumnForExit(VD v,
-                                   const AlignmentColumnMap& alignmentColumnForVertex,
+                                   AlignmentColumnArena& alignmentColumnForVertex,
                                    const std::string& sequence,
                                    const AlignConfig& config) const;
 
+        // All the columns of an alignment of sequence to the graph,
+        // each banded to the alignable range rangeFinder (if any)
+        // gives its vertex, in the arena of mat
+        void
+        alignColumns(const std::string& sequence,
+                     const AlignConfig& config,
+                     SdpRangeFinder* rangeFinder,
+                     const ReadProfile* profile,
+                     PoaAlignmentMatrixImpl* mat) const;
+
+        // The body of TryAddRead, aligning into the given matrix
+        void alignRead(const std::string& sequence,
+                       const AlignConfig& config,
+                       SdpRangeFinder* rangeFinder,
+                       PoaAlignmentMatrixImpl* mat) const;
+
+        VD previousVertex(const AlignmentColumn* column, int i) const;
+
+        // Does every score of aligning a read of this length fit in the
+        // SSE2 kernel's 16-bit lanes?
+        bool scoresFitInt16(int readLength, const AlignParams& params) const;
+
     public:
         //
         // Graph traversal functions, defined in PoaGraphTraversals
@@ -263,8 +569,8 @@ namespace detail {
         void threadFirstRead(std::string sequence, std::vector<Vertex>* readPathOutput=NULL);
 
         void tracebackAndThread
-          (std::string sequence,
-           const AlignmentColumnMap& alignmentColumnForVertex,
+          (const std::string& sequence,
+           const AlignmentColumnArena& alignmentColumnForVertex,
            AlignMode mode,
            std::vector<Vertex>* readPathOutput=NULL);
 
@@ -293,13 +599,14 @@ namespace detail {
         PoaConsensus* FindConsensus(const AlignConfig& config, int minCoverage=-INT_MAX);
 
         size_t NumReads() const;
+        bool VectorizedAlignment() const          { return vectorizedAlignment_; }
+        void VectorizedAlignment(bool enable)     { vectorizedAlignment_ = enable; }
         string ToGraphViz(int flags, const PoaConsensus* pc) const;
         void WriteGraphVizFile(string filename, int flags, const PoaConsensus* pc) const;
     };
 
     // free functions, we should put these all in traversals
-    std::string sequenceAlongPath(const BoostGraph& g,
-                                  const VertexInfoMap& vertexInfoMap,
+    std::string sequenceAlongPath(const CompactGraph& g,
                                   const std::vector<VD>& path);
 
 }} // ConsensusCore::detail
@@ -35,25 +35,25 @@
 
 // Author: David Alexander
 
-#include <ConsensusCore/Matrix/VectorL.hpp>
 #include <ConsensusCore/Poa/PoaGraph.hpp>
 #include <ConsensusCore/Utils.hpp>
 
-#include <boost/graph/topological_sort.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
 
 #include "PoaGraphImpl.hpp"
 
 namespace ConsensusCore {
 namespace detail {
 
-    std::string sequenceAlongPath(const BoostGraph& g,
-                                  const VertexInfoMap& vertexInfoMap,
+    std::string sequenceAlongPath(const CompactGraph& g,
                                   const std::vector<VD>& path)
     {
         std::stringstream ss;
         foreach (VD v, path)
         {
-            ss << vertexInfoMap[v].Base;
+            ss << g[v].Base;
         }
         return ss.str();
     }
@@ -61,23 +61,38 @@ namespace detail {
     void PoaGraphImpl::tagSpan(VD start, VD end)
     {
         // cout << "Tagging span " << start << " to " << end << endl;
-        std::list<VD> sortedVertices(num_vertices(g_));
-        topological_sort(g_, sortedVertices.rbegin());
-        bool spanning = false;
-        foreach (VD v, sortedVertices)
+        //
+        // A read spans the vertices that lie on some path from its
+        // first vertex to its last (the last itself excepted): those
+        // reachable from start that can also reach end.  All of them
+        // fall between start and end in the topological order, but
+        // that stretch of the order also holds vertices of other
+        // reads' branches, wherever insertion happened to put them, so
+        // reachability is worked out over the stretch in both
+        // directions.
+        std::vector<VD> between;
+        std::vector<char> fromStart(g_.NumVertices(), 0);
+        fromStart[start] = 1;
+        for (VD v = start; v != end; v = g_.NextInOrder(v))
         {
-            if (v == start)
-            {
-                spanning = true;
-            }
-            if (v == end)
+            assert(v != null_vertex);
+            foreach (VD u, g_.InEdges(v))
             {
-                break;
+                if (fromStart[u]) fromStart[v] = 1;
             }
-            if (spanning)
+            if (fromStart[v]) between.push_back(v);
+        }
+
+        std::vector<char> toEnd(g_.NumVertices(), 0);
+        toEnd[end] = 1;
+        for (int k = static_cast<int>(between.size()) - 1; k >= 0; k--)
+        {
+            VD v = between[k];
+            foreach (VD w, g_.OutEdges(v))
             {
-                vertexInfoMap_[v].SpanningReads++;
+                if (toEnd[w]) toEnd[v] = 1;
             }
+            if (toEnd[v]) g_[v].SpanningReads++;
         }
     }
 
@@ -100,22 +115,20 @@ namespace detail {
         // against inclusion in the consensus.
         int totalReads = NumReads();
 
-        std::list<VD> path;
-        std::list<VD> sortedVertices(num_vertices(g_));
-        topological_sort(g_, sortedVertices.rbegin());
-        unordered_map<VD, VD> bestPrevVertex;
+        std::vector<VD> path;
+        std::vector<VD> sortedVertices = g_.TopologicalOrder();
+        std::vector<VD> bestPrevVertex(g_.NumVertices(), null_vertex);
 
         // ignore ^ and $
         // TODO(dalexander): find a cleaner way to do this
-        vertexInfoMap_[sortedVertices.front()].ReachingScore = 0;
-        sortedVertices.pop_back();
-        sortedVertices.pop_front();
+        g_[sortedVertices.front()].ReachingScore = 0;
 
         VD bestVertex = null_vertex;
         float bestReachingScore = -FLT_MAX;
-        foreach (VD v, sortedVertices)
+        for (size_t k = 1; k + 1 < sortedVertices.size(); k++)
         {
-            PoaNode& vInfo = vertexInfoMap_[v];
+            VD v = sortedVertices[k];
+            const PoaNode& vInfo = g_[v];
             int containingReads = vInfo.Reads;
             int spanningReads = vInfo.SpanningReads;
             float score = (mode != GLOBAL) ?
@@ -123,11 +136,9 @@ namespace detail {
                 (2 * containingReads - 1 * totalReads - 0.0001f);
             vInfo.Score = score;
             vInfo.ReachingScore = score;
-            bestPrevVertex[v] = null_vertex;
-            foreach (ED e, inEdges(v, g_))
+            foreach (VD sourceVertex, g_.InEdges(v))
             {
-                VD sourceVertex = source(e, g_);
-                float rsc = score + vertexInfoMap_[sourceVertex].ReachingScore;
+                float rsc = score + g_[sourceVertex].ReachingScore;
                 if (rsc > vInfo.ReachingScore)
                 {
                     vInfo.ReachingScore = rsc;
@@ -146,10 +157,11 @@ namespace detail {
         VD v = bestVertex;
         while (v != null_vertex)
         {
-            path.push_front(v);
+            path.push_back(v);
             v = bestPrevVertex[v];
         }
-        return std::vector<VD>(path.begin(), path.end());
+        std::reverse(path.begin(), path.end());
+        return path;
     }
 
     void PoaGraphImpl::threadFirstRead(std::string sequence,
@@ -168,12 +180,12 @@ namespace detail {
             if (outputPath) { outputPath->push_back(externalize(v)); }
             if (readPos == 0)
             {
-                add_edge(enterVertex_, v, g_);
+                g_.AddEdge(enterVertex_, v);
                 startSpanVertex = v;
             }
             else
             {
-                add_edge(u, v, g_);
+                g_.AddEdge(u, v);
             }
             u = v;
             readPos++;
@@ -181,13 +193,13 @@ namespace detail {
         assert(startSpanVertex != null_vertex);
         assert(u != null_vertex);
         endSpanVertex = u;
-        add_edge(u, exitVertex_, g_);  // terminus -> $
+        g_.AddEdge(u, exitVertex_);  // terminus -> $
         tagSpan(startSpanVertex, endSpanVertex);
     }
 
     void PoaGraphImpl::tracebackAndThread
-      (std::string sequence,
-       const AlignmentColumnMap& alignmentColumnForVertex,
+      (const std::string& sequence,
+       const AlignmentColumnArena& alignmentColumnForVertex,
        AlignMode alignMode,
        std::vector<Vertex>* outputPath)
     {
@@ -200,7 +212,7 @@ namespace detail {
         VD v = null_vertex, forkVertex = null_vertex;
         VD u = exitVertex_;
         VD startSpanVertex;
-        VD endSpanVertex = alignmentColumnForVertex.at(exitVertex_)->PreviousVertex[I];
+        VD endSpanVertex = previousVertex(alignmentColumnForVertex[exitVertex_], I);
 
         if (outputPath) {
             outputPath->resize(I);
@@ -216,11 +228,12 @@ namespace detail {
             // u: current vertex
             // v: vertex last visited in traceback (could be == u)
             // forkVertex: the vertex that will be the target of a new edge
-            curCol = alignmentColumnForVertex.at(u);
+            curCol = alignmentColumnForVertex[u];
             assert(curCol != NULL);
-            PoaNode& curNodeInfo = vertexInfoMap_[u];
-            VD prevVertex = curCol->PreviousVertex[i];
-            MoveType reachingMove = curCol->ReachingMove[i];
+            // (threading only adds in-edges to vertices already
+            // passed, so the predecessor indices in curCol still hold)
+            VD prevVertex = previousVertex(curCol, i);
+            MoveType reachingMove = curCol->ReachingMove(i);
 
             if (reachingMove == StartMove)
             {
@@ -235,7 +248,7 @@ namespace detail {
                 {
                     assert(alignMode == LOCAL);
                     VD newForkVertex = addVertex(sequence[READPOS]);
-                    add_edge(newForkVertex, forkVertex, g_);
+                    g_.AddEdge(newForkVertex, forkVertex);
                     VERTEX_ON_PATH(READPOS, newForkVertex);
                     forkVertex = newForkVertex;
                     i--;
@@ -251,13 +264,13 @@ namespace detail {
                     // Find the row # we are coming from, walk
                     // back to there, threading read bases onto
                     // graph via forkVertex, adjusting i.
-                    const AlignmentColumn* prevCol = alignmentColumnForVertex.at(prevVertex);
+                    const AlignmentColumn* prevCol = alignmentColumnForVertex[prevVertex];
                     int prevRow = ArgMax(prevCol->Score);
 
                     while (i > static_cast<int>(prevRow))
                     {
                         VD newForkVertex = addVertex(sequence[READPOS]);
-                        add_edge(newForkVertex, forkVertex, g_);
+                        g_.AddEdge(newForkVertex, forkVertex);
                         VERTEX_ON_PATH(READPOS, newForkVertex);
                         forkVertex = newForkVertex;
                         i--;
@@ -270,11 +283,11 @@ namespace detail {
                 // if there is an extant forkVertex, join it
                 if (forkVertex != null_vertex)
                 {
-                    add_edge(u, forkVertex, g_);
+                    g_.AddEdge(u, forkVertex);
                     forkVertex = null_vertex;
                 }
                 // add to existing node
-                curNodeInfo.Reads++;
+                g_[u].Reads++;
                 i--;
             }
             else if (reachingMove == DeleteMove)
@@ -293,7 +306,7 @@ namespace detail {
                 {
                     forkVertex = v;
                 }
-                add_edge(newForkVertex, forkVertex, g_);
+                g_.AddEdge(newForkVertex, forkVertex);
                 VERTEX_ON_PATH(READPOS, newForkVertex);
                 forkVertex = newForkVertex;
                 i--;
@@ -315,7 +328,7 @@ namespace detail {
         // if there is an extant forkVertex, join it to enterVertex
         if (forkVertex != null_vertex)
         {
-            add_edge(enterVertex_, forkVertex, g_);
+            g_.AddEdge(enterVertex_, forkVertex);
             forkVertex = null_vertex;
         }
 
@@ -327,31 +340,6 @@ namespace detail {
 #undef VERTEX_ON_PATH
     }
 
-    static boost::unordered_set<VD>
-    childVertices(VD v,
-                  const BoostGraph& g)
-    {
-        boost::unordered_set<VD> result;
-        foreach (ED e, out_edges(v, g))
-        {
-            result.insert(target(e, g));
-        }
-        return result;
-    }
-
-    static boost::unordered_set<VD>
-    parentVertices(VD v,
-                   const BoostGraph& g)
-    {
-        boost::unordered_set<VD> result;
-        foreach (ED e, in_edges(v, g))
-        {
-            result.insert(source(e, g));
-        }
-        return result;
-    }
-
-
     vector<ScoredMutation>*
     PoaGraphImpl::findPossibleVariants(const std::vector<Vertex>& bestPath) const
     {
@@ -363,14 +351,14 @@ namespace detail {
         for (int i = 2; i < (int)bestPath_.size() - 2; i++) // NOLINT
         {
             VD v = bestPath_[i];
-            boost::unordered_set<VD> children = childVertices(v, g_);
+            const AdjacencyList& children = g_.OutEdges(v);
 
             // Look for a direct edge from the current node to the node
             // two spaces down---suggesting a deletion with respect to
             // the consensus sequence.
-            if (children.find(bestPath_[i + 2]) != children.end())
+            if (children.Contains(bestPath_[i + 2]))
             {
-                float score = -vertexInfoMap_[bestPath_[i + 1]].Score;
+                float score = -g_[bestPath_[i + 1]].Score;
                 variants->push_back(Mutation(DELETION, i + 1, '-').WithScore(score));
             }
 
@@ -378,31 +366,27 @@ namespace detail {
             // This indicates we should try inserting the base at i + 1.
 
             // Parents of (i + 1)
-            boost::unordered_set<VD> lookBack = parentVertices(bestPath_[i + 1], g_);
+            const AdjacencyList* lookBack = &g_.InEdges(bestPath_[i + 1]);
 
-            // (We could do this in STL using std::set sorted on score, which would then
-            // provide an intersection mechanism (in <algorithm>) but that actually ends
-            // up being more code.  Sad.)
             float bestInsertScore = -FLT_MAX;
             VD bestInsertVertex = null_vertex;
 
             foreach (VD v, children)
             {
-                boost::unordered_set<VD>::iterator found = lookBack.find(v);
-                if (found != lookBack.end())
+                if (lookBack->Contains(v))
                 {
-                    float score = vertexInfoMap_[*found].Score;
+                    float score = g_[v].Score;
                     if (score > bestInsertScore)
                     {
                         bestInsertScore = score;
-                        bestInsertVertex = *found;
+                        bestInsertVertex = v;
                     }
                 }
             }
 
             if (bestInsertVertex != null_vertex)
             {
-                char base = vertexInfoMap_[bestInsertVertex].Base;
+                char base = g_[bestInsertVertex].Base;
                 variants->push_back(
                         Mutation(INSERTION, i + 1, base).WithScore(bestInsertScore));
             }
@@ -411,7 +395,7 @@ namespace detail {
             // to i + 2.  This indicates we should try mismatching the base i + 1.
 
             // Parents of (i + 2)
-            lookBack = parentVertices(bestPath_[i + 2], g_);
+            lookBack = &g_.InEdges(bestPath_[i + 2]);
 
             float bestMismatchScore = -FLT_MAX;
             VD bestMismatchVertex = null_vertex;
@@ -420,14 +404,13 @@ namespace detail {
             {
                 if (v == bestPath_[i + 1]) continue;
 
-                boost::unordered_set<VD>::iterator found = lookBack.find(v);
-                if (found != lookBack.end())
+                if (lookBack->Contains(v))
                 {
-                    float score = vertexInfoMap_[*found].Score;
+                    float score = g_[v].Score;
                     if (score > bestMismatchScore)
                     {
                         bestMismatchScore = score;
-                        bestMismatchVertex = *found;
+                        bestMismatchVertex = v;
                     }
                 }
             }
@@ -437,7 +420,7 @@ namespace detail {
                 // TODO(dalexander): As implemented (compatibility), this returns
                 // the score of the mismatch node. I think it should return the score
                 // difference, no?
-                char base = vertexInfoMap_[bestMismatchVertex].Base;
+                char base = g_[bestMismatchVertex].Base;
                 variants->push_back(
                         Mutation(SUBSTITUTION, i + 1, base).WithScore(bestMismatchScore));
             }
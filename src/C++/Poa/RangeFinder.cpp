@@ -3,9 +3,8 @@
 #include <ConsensusCore/Interval.hpp>
 
 #include <algorithm>
-#include <boost/graph/topological_sort.hpp>
 #include <boost/optional.hpp>
-#include <map>
+#include <cstdlib>
 #include <string>
 #include <vector>
 #include <utility>
@@ -13,6 +12,10 @@
 #include "PoaGraphImpl.hpp"
 
 #define WIDTH 30
+#define DIAGONAL_MIN_WIDTH 64
+#define DIAGONAL_WIDTH_DIVISOR 25
+#define MAX_KMER_OCCURRENCES 16
+#define CHAIN_LOOKBACK 50
 #define DEBUG_RANGE_FINDER 0
 
 #if DEBUG_RANGE_FINDER
@@ -81,19 +84,27 @@ namespace detail {
         alignableReadIntervalByVertex_.clear();
 
         const int readLength = readSequence.size();
+        const int width = AnchorRangeWidth(readLength);
 
         SdpAnchorVector anchors = FindAnchors(consensusSequence, readSequence);
 
-        std::map<VD, optional<Interval> > directRanges;
-        std::map<VD, Interval> fwdMarks, revMarks;
-
-        std::vector<VD> sortedVertices(num_vertices(poaGraph.g_));
-        topological_sort(poaGraph.g_, sortedVertices.rbegin());
-        foreach (VD v, sortedVertices)
+        // Without anchors there is nothing to band by: every vertex
+        // may align anywhere in the read
+        if (anchors.empty())
         {
-            directRanges[v] = boost::none;
+            alignableReadIntervalByVertex_.assign(poaGraph.g_.NumVertices(),
+                                                  Interval(0, readLength));
+            return;
         }
 
+        // (vertex ids are dense, so per-vertex state is kept in vectors)
+        const size_t numVertices = poaGraph.g_.NumVertices();
+        std::vector<optional<Interval> > directRanges(numVertices);
+        std::vector<Interval> fwdMarks(numVertices), revMarks(numVertices);
+        std::vector<Interval> steppedRanges;
+
+        std::vector<VD> sortedVertices = poaGraph.g_.TopologicalOrder();
+
         // Find the "direct ranges" implied by the anchors between the
         // css and this read.  Possibly null.
         for (size_t cssPos = 0; cssPos < consensusPath.size(); cssPos++)
@@ -106,8 +117,8 @@ namespace detail {
                 cout << "Anchor: " << anchor->first << "-" << anchor->second
                      <<  " (Vertex " << vExt << ")" << endl;
 #endif
-                directRanges[v] = Interval(max(int(anchor->second) - WIDTH, 0),
-                                           min(int(anchor->second) + WIDTH, readLength));
+                directRanges[v] = Interval(max(int(anchor->second) - width, 0),
+                                           min(int(anchor->second) + width, readLength));
             } else {
                 directRanges[v] = boost::none;
             }
@@ -118,44 +129,41 @@ namespace detail {
         // union of the "forward stepped" ranges of its predecessors
         foreach (VD v, sortedVertices)
         {
-            optional<Interval> directRange = directRanges.at(v);
+            const optional<Interval>& directRange = directRanges[v];
             if (directRange) {
                 fwdMarks[v] = directRange.get();
             } else {
-                std::vector<Interval> predRangesStepped;
-                foreach (ED e, inEdges(v, poaGraph.g_))
+                steppedRanges.clear();
+                foreach (VD pred, poaGraph.g_.InEdges(v))
                 {
-                    VD pred = source(e, poaGraph.g_);
-                    Interval predRangeStepped = next(fwdMarks.at(pred), readLength);
-                    predRangesStepped.push_back(predRangeStepped);
+                    steppedRanges.push_back(next(fwdMarks[pred], readLength));
                 }
-                fwdMarks[v] = RangeUnion(predRangesStepped);
+                fwdMarks[v] = RangeUnion(steppedRanges);
             }
         }
 
         // Do the same thing, but as a backwards recursion
         foreach (VD v, make_pair(sortedVertices.rbegin(), sortedVertices.rend()))
         {
-            optional<Interval> directRange = directRanges.at(v);
+            const optional<Interval>& directRange = directRanges[v];
             if (directRange) {
                 revMarks[v] = directRange.get();
             } else {
-                std::vector<Interval> succRangesStepped;
-                foreach (ED e, out_edges(v, poaGraph.g_))
+                steppedRanges.clear();
+                foreach (VD succ, poaGraph.g_.OutEdges(v))
                 {
-                    VD succ = target(e, poaGraph.g_);
-                    Interval succRangeStepped = prev(revMarks.at(succ), 0);
-                    succRangesStepped.push_back(succRangeStepped);
+                    steppedRanges.push_back(prev(revMarks[succ], 0));
                 }
-                revMarks[v] = RangeUnion(succRangesStepped);
+                revMarks[v] = RangeUnion(steppedRanges);
             }
         }
 
         // take hulls of extents from forward and reverse recursions
+        alignableReadIntervalByVertex_.resize(numVertices);
         foreach (VD v, sortedVertices)
         {
             Vertex vExt = poaGraph.externalize(v);
-            alignableReadIntervalByVertex_[vExt] = RangeUnion(fwdMarks.at(v), revMarks.at(v));
+            alignableReadIntervalByVertex_[vExt] = RangeUnion(fwdMarks[v], revMarks[v]);
 #if DEBUG_RANGE_FINDER
             cout << vExt << " range = ["
                  << alignableReadIntervalByVertex_[v].Begin  << ", "
@@ -170,4 +178,146 @@ namespace detail {
         return alignableReadIntervalByVertex_.at(v);
     }
 
+    int SdpRangeFinder::AnchorRangeWidth(int readLength) const
+    {
+        return WIDTH;
+    }
+
+    SdpAnchorVector
+    DiagonalRangeFinder::FindAnchors(const std::string& consensusSequence,
+                                     const std::string& readSequence)
+    {
+        SdpAnchorVector anchors;
+        const size_t cssLength = consensusSequence.length();
+        anchors.reserve(cssLength);
+        for (size_t cssPos = 0; cssPos < cssLength; cssPos++)
+        {
+            size_t readPos = static_cast<size_t>(
+                static_cast<double>(cssPos) * readSequence.length() / cssLength);
+            anchors.push_back(make_pair(cssPos, readPos));
+        }
+        return anchors;
+    }
+
+    int DiagonalRangeFinder::AnchorRangeWidth(int readLength) const
+    {
+        return max(DIAGONAL_MIN_WIDTH, readLength / DIAGONAL_WIDTH_DIVISOR);
+    }
+
+    // ----------------- KmerRangeFinder ---------------------
+
+    // (k-mer code, position) pairs
+    typedef std::pair<uint32_t, uint32_t> KmerPosition;
+
+    static inline bool compareKmerCodes(const KmerPosition& a, const KmerPosition& b)
+    {
+        return a.first < b.first;
+    }
+
+    // The k-mers of seq (k <= 16) in two-bit code; k-mers spanning a
+    // character other than ACGT are skipped
+    static void kmerPositions(const std::string& seq, int k, std::vector<KmerPosition>* out)
+    {
+        const uint32_t mask = (k == 16) ? ~0u : ((1u << (2 * k)) - 1);
+        uint32_t code = 0;
+        int run = 0;
+        out->clear();
+        out->reserve(seq.length());
+        for (size_t i = 0; i < seq.length(); i++)
+        {
+            uint32_t base;
+            switch (seq[i])
+            {
+                case 'A': base = 0; break;
+                case 'C': base = 1; break;
+                case 'G': base = 2; break;
+                case 'T': base = 3; break;
+                default:  run = 0; continue;
+            }
+            code = ((code << 2) | base) & mask;
+            if (++run >= k)
+            {
+                out->push_back(make_pair(code, static_cast<uint32_t>(i + 1 - k)));
+            }
+        }
+    }
+
+    KmerRangeFinder::KmerRangeFinder(int kmerSize)
+        : kmerSize_(kmerSize)
+    {
+        if (kmerSize < 1 || kmerSize > 16)
+        {
+            throw std::invalid_argument("KmerRangeFinder: k-mer size must be in 1..16");
+        }
+    }
+
+    SdpAnchorVector
+    KmerRangeFinder::FindAnchors(const std::string& consensusSequence,
+                                 const std::string& readSequence)
+    {
+        const int k = kmerSize_;
+
+        // Seeds: (cssPos, readPos) of the k-mers the read shares with
+        // the consensus, in consensus order
+        std::vector<KmerPosition> cssKmers, readKmers;
+        kmerPositions(consensusSequence, k, &cssKmers);
+        kmerPositions(readSequence, k, &readKmers);
+        std::sort(cssKmers.begin(), cssKmers.end());
+
+        SdpAnchorVector seeds;
+        typedef std::vector<KmerPosition>::const_iterator iter_t;
+        foreach (const KmerPosition& readKmer, readKmers)
+        {
+            std::pair<iter_t, iter_t> hits = std::equal_range(
+                cssKmers.begin(), cssKmers.end(), readKmer, compareKmerCodes);
+            if (hits.second - hits.first > MAX_KMER_OCCURRENCES) continue;
+            for (iter_t hit = hits.first; hit != hits.second; ++hit)
+            {
+                seeds.push_back(make_pair(hit->second, readKmer.second));
+            }
+        }
+        std::sort(seeds.begin(), seeds.end());
+
+        // Sparse DP: a chain ending in seed j extends the best chain
+        // ending in one of the CHAIN_LOOKBACK seeds before it that lies
+        // strictly above and left of it, scoring the bases j adds and
+        // paying one per base of shift in diagonal.
+        const int nSeeds = seeds.size();
+        std::vector<int> chainScore(nSeeds, k);
+        std::vector<int> chainPrev(nSeeds, -1);
+        int bestEnd = -1;
+        for (int j = 0; j < nSeeds; j++)
+        {
+            for (int i = j - 1; i >= 0 && i >= j - CHAIN_LOOKBACK; i--)
+            {
+                int dc = seeds[j].first - seeds[i].first;
+                int dr = seeds[j].second - seeds[i].second;
+                if (dc <= 0 || dr <= 0) continue;
+                int score = chainScore[i] + min(min(dc, dr), k) - std::abs(dc - dr);
+                if (score > chainScore[j])
+                {
+                    chainScore[j] = score;
+                    chainPrev[j] = i;
+                }
+            }
+            if (bestEnd < 0 || chainScore[j] > chainScore[bestEnd])
+            {
+                bestEnd = j;
+            }
+        }
+
+        // A lone seed, or two, may be chance; leave such reads unbanded
+        SdpAnchorVector anchors;
+        if (bestEnd < 0 || chainScore[bestEnd] < 2 * k)
+        {
+            return anchors;
+        }
+        for (int j = bestEnd; j >= 0; j = chainPrev[j])
+        {
+            anchors.push_back(seeds[j]);
+        }
+        std::reverse(anchors.begin(), anchors.end());
+        return anchors;
+    }
+
 }}
@@ -0,0 +1,95 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/Quiver/MatrixBudget.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ConsensusCore
+{
+    namespace {
+        size_t defaultMatrixMemoryBudget = 0;
+
+        bool LessInformative(const ReadMatrixUsage& a, const ReadMatrixUsage& b)
+        {
+            if (a.TemplateSpan != b.TemplateSpan) return a.TemplateSpan < b.TemplateSpan;
+            if (a.AllocatedEntries != b.AllocatedEntries)
+            {
+                return a.AllocatedEntries > b.AllocatedEntries;
+            }
+            return a.ReadIndex < b.ReadIndex;
+        }
+
+        bool LessRecentlyUsed(const ReadMatrixUsage& a, const ReadMatrixUsage& b)
+        {
+            if (a.LastUse != b.LastUse) return a.LastUse < b.LastUse;
+            return a.ReadIndex < b.ReadIndex;
+        }
+    }
+
+    bool DeactivateLeastInformativeReads::RecomputesMatrices() const
+    {
+        return false;
+    }
+
+    void DeactivateLeastInformativeReads::Rank(std::vector<ReadMatrixUsage>* candidates) const
+    {
+        std::sort(candidates->begin(), candidates->end(), LessInformative);
+    }
+
+    bool RecomputeLeastRecentlyUsed::RecomputesMatrices() const
+    {
+        return true;
+    }
+
+    void RecomputeLeastRecentlyUsed::Rank(std::vector<ReadMatrixUsage>* candidates) const
+    {
+        std::sort(candidates->begin(), candidates->end(), LessRecentlyUsed);
+    }
+
+    void DefaultMatrixMemoryBudget(size_t bytes)
+    {
+        defaultMatrixMemoryBudget = bytes;
+    }
+
+    size_t DefaultMatrixMemoryBudget()
+    {
+        return defaultMatrixMemoryBudget;
+    }
+}
@@ -40,16 +40,22 @@
 #include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
 #include <ConsensusCore/Mutation.hpp>
 #include <ConsensusCore/Sequence.hpp>
+#include <ConsensusCore/ThreadPool.hpp>
 #include <ConsensusCore/Utils.hpp>
 
 #include <algorithm>
 #include <cfloat>
+#include <cstdlib>
+#include <new>
 #include <map>
 #include <string>
 #include <vector>
 #include <boost/format.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <sys/time.h>
 
 #define MIN_FAVORABLE_SCOREDIFF 0.04  // Chosen such that 0.49 = 1 / (1 + exp(minScoreDiff))
+#define FAST_SCORE_BLOCK_SIZE   128   // Mutations per FastScoreMutations block
 
 namespace ConsensusCore
 {
@@ -124,6 +130,267 @@ namespace ConsensusCore
     }
 
 
+    namespace detail {
+
+        //
+        // Work items handed to the thread pool.  Each only touches the
+        // ReadStates (and the slots of the output arrays) in its own
+        // index range, so no locking is needed.
+        //
+        // Scores a batch of mutations against a range of reads, in
+        // read-major order so that each read's alpha/beta matrices
+        // stay hot while all of the mutations are scored.  Results go
+        // in row-major (read x mutation) arrays.
+        //
+        template<typename ReadStateType>
+        class ScoreMutationsTask : public ParallelTask
+        {
+        public:
+            ScoreMutationsTask(const std::vector<ReadStateType>& reads,
+                               const std::vector<Mutation>& muts,
+                               float* deltas,
+                               unsigned char* isScored)
+                : reads_(reads),
+                  muts_(muts),
+                  deltas_(deltas),
+                  isScored_(isScored)
+            {}
+
+            void Run(int begin, int end)
+            {
+                int nMuts = muts_.size();
+                for (int i = begin; i < end; i++)
+                {
+                    const ReadStateType& rs = reads_[i];
+                    float* deltaRow = deltas_ + i * nMuts;
+                    unsigned char* isScoredRow = isScored_ + i * nMuts;
+                    if (!rs.IsActive)
+                    {
+                        std::fill(isScoredRow, isScoredRow + nMuts, 0);
+                        continue;
+                    }
+                    float baseline = rs.Scorer->Score();
+                    for (int j = 0; j < nMuts; j++)
+                    {
+                        if (ReadScoresMutation(*rs.Read, muts_[j]))
+                        {
+                            Mutation orientedMut = OrientedMutation(*rs.Read, muts_[j]);
+                            deltaRow[j] = rs.Scorer->ScoreMutation(orientedMut) - baseline;
+                            isScoredRow[j] = 1;
+                        }
+                        else
+                        {
+                            isScoredRow[j] = 0;
+                        }
+                    }
+                }
+            }
+
+        private:
+            const std::vector<ReadStateType>& reads_;
+            const std::vector<Mutation>& muts_;
+            float* deltas_;
+            unsigned char* isScored_;
+        };
+
+        //
+        // Scores a single mutation against a list of reads.  Results
+        // go in arrays parallel to the list.
+        //
+        template<typename ReadStateType>
+        class ScoreReadsTask : public ParallelTask
+        {
+        public:
+            ScoreReadsTask(const std::vector<ReadStateType>& reads,
+                           const std::vector<int>& readIds,
+                           const Mutation& mut,
+                           float* deltas,
+                           unsigned char* isScored)
+                : reads_(reads),
+                  readIds_(readIds),
+                  mut_(mut),
+                  deltas_(deltas),
+                  isScored_(isScored)
+            {}
+
+            void Run(int begin, int end)
+            {
+                for (int k = begin; k < end; k++)
+                {
+                    const ReadStateType& rs = reads_[readIds_[k]];
+                    if (rs.IsActive && ReadScoresMutation(*rs.Read, mut_))
+                    {
+                        Mutation orientedMut = OrientedMutation(*rs.Read, mut_);
+                        deltas_[k] = rs.Scorer->ScoreMutation(orientedMut) - rs.Scorer->Score();
+                        isScored_[k] = 1;
+                    }
+                    else
+                    {
+                        isScored_[k] = 0;
+                    }
+                }
+            }
+
+        private:
+            const std::vector<ReadStateType>& reads_;
+            const std::vector<int>& readIds_;
+            const Mutation& mut_;
+            float* deltas_;
+            unsigned char* isScored_;
+        };
+
+        //
+        // Screens a range of candidate mutations, for
+        // FavorableMutations.  Each chunk gets its own scratch extend
+        // buffer, shared by all of its reads.
+        //
+        template<typename MMS>
+        class ScreenMutationsTask : public ParallelTask
+        {
+        public:
+            ScreenMutationsTask(const MMS& mms,
+                                const std::vector<Mutation>& candidates,
+                                float* scores,
+                                unsigned char* isFavorable)
+                : mms_(mms),
+                  candidates_(candidates),
+                  scores_(scores),
+                  isFavorable_(isFavorable)
+            {}
+
+            void Run(int begin, int end)
+            {
+                typename MMS::MatrixType extendBuffer(0, 0);
+                std::vector<int> readIds;
+                for (int k = begin; k < end; k++)
+                {
+                    isFavorable_[k] = mms_.ScreenMutation(candidates_[k], &readIds,
+                                                          extendBuffer, &scores_[k]);
+                }
+            }
+
+        private:
+            const MMS& mms_;
+            const std::vector<Mutation>& candidates_;
+            float* scores_;
+            unsigned char* isFavorable_;
+        };
+
+        //
+        // FastScores a range of blocks of mutations, for
+        // FastScoreMutations, with one scratch extend buffer per chunk.
+        //
+        template<typename MMS>
+        class FastScoreMutationsTask : public ParallelTask
+        {
+        public:
+            FastScoreMutationsTask(const MMS& mms,
+                                   const std::vector<Mutation>& mutations,
+                                   float* sums)
+                : mms_(mms),
+                  mutations_(mutations),
+                  sums_(sums)
+            {}
+
+            void Run(int begin, int end)
+            {
+                typename MMS::MatrixType extendBuffer(0, 0);
+                int nMuts = mutations_.size();
+                for (int b = begin; b < end; b++)
+                {
+                    mms_.FastScoreBlock(mutations_,
+                                        b * FAST_SCORE_BLOCK_SIZE,
+                                        std::min(nMuts, (b + 1) * FAST_SCORE_BLOCK_SIZE),
+                                        extendBuffer, sums_);
+                }
+            }
+
+        private:
+            const MMS& mms_;
+            const std::vector<Mutation>& mutations_;
+            float* sums_;
+        };
+
+        template<typename MMS, typename ReadStateType>
+        class RefillTemplateTask : public ParallelTask
+        {
+        public:
+            RefillTemplateTask(const MMS& mms, std::vector<ReadStateType>& reads)
+                : mms_(mms),
+                  reads_(reads)
+            {}
+
+            void Run(int begin, int end)
+            {
+                for (int i = begin; i < end; i++)
+                {
+                    ReadStateType& rs = reads_[i];
+                    if (!rs.IsActive || rs.IsPending) continue;
+                    try {
+                        rs.Scorer->Template(mms_.Template(rs.Read->Strand,
+                                                          rs.Read->TemplateStart,
+                                                          rs.Read->TemplateEnd));
+                    }
+                    catch (AlphaBetaMismatchException& e)
+                    {
+                        rs.IsActive = false;
+                    }
+                }
+            }
+
+        private:
+            const MMS& mms_;
+            std::vector<ReadStateType>& reads_;
+        };
+
+        //
+        // Constructs the scorers of a list of pending reads.  A read
+        // the threshold rejects keeps no scorer.
+        //
+        template<typename MMS, typename ReadStateType>
+        class BuildScorersTask : public ParallelTask
+        {
+        public:
+            BuildScorersTask(const MMS& mms,
+                             std::vector<ReadStateType>& reads,
+                             const std::vector<int>& readIds)
+                : mms_(mms),
+                  reads_(reads),
+                  readIds_(readIds)
+            {}
+
+            void Run(int begin, int end)
+            {
+                for (int k = begin; k < end; k++)
+                {
+                    ReadStateType& rs = reads_[readIds_[k]];
+                    rs.Scorer = mms_.MakeScorer(*rs.Read, rs.AddThreshold, &rs.ConstructionTime,
+                                                &rs.AlphaBetaMismatch);
+                    rs.IsActive = (rs.Scorer != NULL);
+                    rs.IsPending = false;
+                    rs.HasCachedScore = false;
+                }
+            }
+
+        private:
+            const MMS& mms_;
+            std::vector<ReadStateType>& reads_;
+            const std::vector<int>& readIds_;
+        };
+    }
+
+    namespace {
+        double WallClockSeconds()
+        {
+            struct timeval tv;
+            gettimeofday(&tv, NULL);
+            return tv.tv_sec + 1e-6 * tv.tv_usec;
+        }
+
+        const DeactivateLeastInformativeReads defaultEvictionPolicy;
+    }
+
+
 
     template<typename R>
     MultiReadMutationScorer<R>::MultiReadMutationScorer
@@ -131,7 +398,17 @@ namespace ConsensusCore
         : quiverConfigByChemistry_(quiverConfigByChemistry),
           fwdTemplate_(tpl),
           revTemplate_(ReverseComplement(tpl)),
-          reads_()
+          reads_(),
+          readIndex_(),
+          readIndexIsStale_(true),
+          threadPool_(NULL),
+          moveTables_(false),
+          lazyAlphaBeta_(false),
+          matrixBudget_(DefaultMatrixMemoryBudget()),
+          evictionPolicy_(&defaultEvictionPolicy),
+          peakMatrixEntries_(0),
+          useClock_(0),
+          numPendingReads_(0)
     {
         DEBUG_ONLY(CheckInvariants());
         fastScoreThreshold_ = 0;
@@ -148,13 +425,24 @@ namespace ConsensusCore
           fastScoreThreshold_(other.fastScoreThreshold_),
           fwdTemplate_(other.fwdTemplate_),
           revTemplate_(other.revTemplate_),
-          reads_()
+          reads_(),
+          readIndex_(),
+          readIndexIsStale_(true),
+          threadPool_(NULL),
+          moveTables_(other.moveTables_),
+          lazyAlphaBeta_(other.lazyAlphaBeta_),
+          matrixBudget_(other.matrixBudget_),
+          evictionPolicy_(other.evictionPolicy_),
+          peakMatrixEntries_(other.peakMatrixEntries_),
+          useClock_(other.useClock_),
+          numPendingReads_(0)
     {
         // Make a deep copy of the readsAndScorers
         foreach (const ReadStateType& read, reads_)
         {
             reads_.push_back(ReadStateType(read));
         }
+        NumThreads(other.NumThreads());
 
         DEBUG_ONLY(CheckInvariants());
     }
@@ -162,7 +450,162 @@ namespace ConsensusCore
 
     template<typename R>
     MultiReadMutationScorer<R>::~MultiReadMutationScorer()
-    {}
+    {
+        delete threadPool_;
+    }
+
+    template<typename R>
+    int
+    MultiReadMutationScorer<R>::NumThreads() const
+    {
+        return (threadPool_ == NULL ? 1 : threadPool_->NumThreads());
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::NumThreads(int numThreads)
+    {
+        if (numThreads == NumThreads()) return;
+        delete threadPool_;
+        threadPool_ = NULL;
+        if (numThreads > 1)
+        {
+            threadPool_ = new detail::ThreadPool(numThreads);
+        }
+    }
+
+    template<typename R>
+    bool
+    MultiReadMutationScorer<R>::MoveTables() const
+    {
+        return moveTables_;
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::MoveTables(bool moveTables)
+    {
+        moveTables_ = moveTables;
+    }
+
+    template<typename R>
+    bool
+    MultiReadMutationScorer<R>::LazyAlphaBeta() const
+    {
+        return lazyAlphaBeta_;
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::LazyAlphaBeta(bool lazyAlphaBeta)
+    {
+        lazyAlphaBeta_ = lazyAlphaBeta;
+    }
+
+    template<typename R>
+    std::vector<float>
+    MultiReadMutationScorer<R>::ConstructionTimes() const
+    {
+        std::vector<float> times;
+        foreach (const ReadStateType& rs, reads_)
+        {
+            times.push_back(rs.ConstructionTime);
+        }
+        return times;
+    }
+
+    template<typename R>
+    size_t
+    MultiReadMutationScorer<R>::MatrixMemoryBudget() const
+    {
+        return matrixBudget_;
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::MatrixMemoryBudget(size_t bytes)
+    {
+        matrixBudget_ = bytes;
+        KeepToMatrixBudget(std::vector<int>());
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::MatrixMemoryBudget(size_t bytes,
+                                                   const AbstractEvictionPolicy& policy)
+    {
+        evictionPolicy_ = &policy;
+        MatrixMemoryBudget(bytes);
+    }
+
+    template<typename R>
+    size_t
+    MultiReadMutationScorer<R>::PeakAllocatedMatrixEntries() const
+    {
+        return peakMatrixEntries_;
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::UpdateReadIndex() const
+    {
+        if (readIndexIsStale_)
+        {
+            std::vector<Interval> spans;
+            foreach (const ReadStateType& rs, reads_)
+            {
+                spans.push_back(Interval(rs.Read->TemplateStart, rs.Read->TemplateEnd));
+            }
+            readIndex_.Build(spans);
+            readIndexIsStale_ = false;
+        }
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::CandidateReads(const Mutation& m,
+                                               std::vector<int>* readIds) const
+    {
+        UpdateReadIndex();
+        // ReadScoresMutation needs TemplateStart < m.End(), and either
+        // m.Start() < TemplateEnd or (insertions) m.End() <= TemplateEnd
+        readIds->clear();
+        readIndex_.FindOverlapping(m.Start() - 1, m.End(), readIds);
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::ParallelScores(const Mutation& m,
+                                               std::vector<int>* readIds,
+                                               std::vector<float>* deltas,
+                                               std::vector<unsigned char>* isScored) const
+    {
+        assert(threadPool_ != NULL);
+        CandidateReads(m, readIds);
+        deltas->resize(readIds->size());
+        isScored->resize(readIds->size());
+        if (readIds->empty()) return;
+        detail::ScoreReadsTask<ReadStateType> task(reads_, *readIds, m,
+                                                   &(*deltas)[0], &(*isScored)[0]);
+        threadPool_->ParallelFor(readIds->size(), task);
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::ScoreMutationsByRead(const std::vector<Mutation>& mutations,
+                                                     float* deltas,
+                                                     unsigned char* isScored) const
+    {
+        detail::ScoreMutationsTask<ReadStateType> task(reads_, mutations, deltas, isScored);
+        if (threadPool_ != NULL)
+        {
+            threadPool_->ParallelFor(reads_.size(), task);
+        }
+        else
+        {
+            task.Run(0, reads_.size());
+        }
+    }
 
     template<typename R>
     int
@@ -214,46 +657,60 @@ namespace ConsensusCore
     MultiReadMutationScorer<R>::ApplyMutations(const std::vector<Mutation>& mutations)
     {
         DEBUG_ONLY(CheckInvariants());
+        // An evicted read's score is stale once its template changes;
+        // its scorer will be built against the new template
+        foreach (ReadStateType& rs, reads_)
+        {
+            if (!rs.HasCachedScore) continue;
+            foreach (const Mutation& m, mutations)
+            {
+                if (ReadScoresMutation(*rs.Read, m)) rs.HasCachedScore = false;
+            }
+        }
         std::vector<int> mtp = TargetToQueryPositions(mutations, fwdTemplate_);
         fwdTemplate_ = ConsensusCore::ApplyMutations(mutations, fwdTemplate_);
         revTemplate_ = ReverseComplement(fwdTemplate_);
 
+        // Reads (even inactive reads) will have their mapping coords updated
         foreach (ReadStateType& rs, reads_)
         {
-            try {
-                int newTemplateStart = mtp[rs.Read->TemplateStart];
-                int newTemplateEnd   = mtp[rs.Read->TemplateEnd];
-
-                // reads (even inactive reads) will have their mapping coords updated
-                rs.Read->TemplateStart = newTemplateStart;
-                rs.Read->TemplateEnd   = newTemplateEnd;
+            rs.Read->TemplateStart = mtp[rs.Read->TemplateStart];
+            rs.Read->TemplateEnd   = mtp[rs.Read->TemplateEnd];
+        }
+        readIndexIsStale_ = true;
 
-                if (rs.IsActive)
-                {
-                    rs.Scorer->Template(Template(rs.Read->Strand,
-                                                 newTemplateStart,
-                                                 newTemplateEnd));
-                }
-            }
-            catch (AlphaBetaMismatchException& e)
-            {
-                rs.IsActive = false;
-            }
+        // Refill the active scorers, concurrently if we have a pool
+        detail::RefillTemplateTask<MultiReadMutationScorer<R>, ReadStateType> task(*this, reads_);
+        if (threadPool_ != NULL)
+        {
+            threadPool_->ParallelFor(reads_.size(), task);
         }
+        else
+        {
+            task.Run(0, reads_.size());
+        }
+        KeepToMatrixBudget(std::vector<int>());
         DEBUG_ONLY(CheckInvariants());
     }
 
     template<typename R>
-    bool MultiReadMutationScorer<R>::AddRead(const MappedRead& mr, float threshold)
+    typename MultiReadMutationScorer<R>::ScorerType*
+    MultiReadMutationScorer<R>::MakeScorer(const MappedRead& mr,
+                                           float threshold,
+                                           float* seconds,
+                                           bool* alphaBetaMismatch) const
     {
-        DEBUG_ONLY(CheckInvariants());
+        double startTime = WallClockSeconds();
         const QuiverConfig* config = &quiverConfigByChemistry_.At(mr.Chemistry);
         EvaluatorType ev(mr,
                          Template(mr.Strand, mr.TemplateStart, mr.TemplateEnd),
-                         config->QvParams);
+                         config->QvParams,
+                         true, true,
+                         moveTables_);
         RecursorType recursor(config->MovesAvailable, config->Banding);
 
         ScorerType* scorer;
+        *alphaBetaMismatch = false;
         try
         {
             scorer = new MutationScorer<R>(ev, recursor);
@@ -261,6 +718,7 @@ namespace ConsensusCore
         catch (AlphaBetaMismatchException& e)
         {
             scorer = NULL;
+            *alphaBetaMismatch = true;
         }
 
         if (scorer != NULL && threshold < 1.0f)
@@ -277,10 +735,235 @@ namespace ConsensusCore
             }
         }
 
-        bool isActive = scorer != NULL;
-        reads_.push_back(ReadStateType(new MappedRead(mr), scorer, isActive));
+        *seconds = static_cast<float>(WallClockSeconds() - startTime);
+        return scorer;
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::BuildScorers(const std::vector<int>& readIds)
+    {
+        detail::BuildScorersTask<MultiReadMutationScorer<R>, ReadStateType>
+            task(*this, reads_, readIds);
+        if (threadPool_ != NULL && readIds.size() > 1)
+        {
+            threadPool_->ParallelFor(readIds.size(), task);
+        }
+        else
+        {
+            task.Run(0, readIds.size());
+        }
+        numPendingReads_ -= readIds.size();
+    }
+
+    template<typename R>
+    bool MultiReadMutationScorer<R>::ScorersAreEnsured() const
+    {
+        // Nothing to build, and no use to record
+        return (numPendingReads_ == 0 &&
+                !(matrixBudget_ > 0 && evictionPolicy_->RecomputesMatrices()));
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::EnsureScorers(const std::vector<int>& readIds) const
+    {
+        if (ScorersAreEnsured()) return;
+        // Building and evicting scorers changes nothing a caller can
+        // observe but the time taken and the memory reported.  It does
+        // change the scorer itself, though, which is why the const
+        // methods that come here are not safe to call concurrently
+        // (see LazyAlphaBeta and MatrixMemoryBudget).
+        MultiReadMutationScorer<R>* self = const_cast<MultiReadMutationScorer<R>*>(this);
+        self->useClock_++;
+        std::vector<int> pending;
+        foreach (int i, readIds)
+        {
+            ReadStateType& rs = self->reads_[i];
+            rs.LastUse = useClock_;
+            if (rs.IsPending) pending.push_back(i);
+        }
+        if (pending.empty()) return;
+        self->BuildScorers(pending);
+        self->KeepToMatrixBudget(readIds);
         DEBUG_ONLY(CheckInvariants());
-        return isActive;
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::EnsureScorers(const Mutation& m) const
+    {
+        if (ScorersAreEnsured()) return;
+        std::vector<int> readIds;
+        CandidateReads(m, &readIds);
+        EnsureScorers(readIds);
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::EnsureScorers(const std::vector<Mutation>& mutations,
+                                                   int begin, int end) const
+    {
+        if (begin == end || ScorersAreEnsured()) return;
+        int spanBegin = mutations[begin].Start() - 1;
+        int spanEnd = mutations[begin].End();
+        for (int k = begin; k < end; k++)
+        {
+            spanBegin = std::min(spanBegin, mutations[k].Start() - 1);
+            spanEnd = std::max(spanEnd, mutations[k].End());
+        }
+        UpdateReadIndex();
+        std::vector<int> readIds;
+        readIndex_.FindOverlapping(spanBegin, spanEnd, &readIds);
+        EnsureScorers(readIds);
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::EnsureAllScorers() const
+    {
+        if (ScorersAreEnsured()) return;
+        std::vector<int> readIds;
+        for (int i = 0; i < static_cast<int>(reads_.size()); i++)
+        {
+            readIds.push_back(i);
+        }
+        EnsureScorers(readIds);
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::EnsureBaselineScores() const
+    {
+        if (numPendingReads_ == 0) return;
+        std::vector<int> unscored;
+        for (int i = 0; i < static_cast<int>(reads_.size()); i++)
+        {
+            const ReadStateType& rs = reads_[i];
+            if (rs.IsPending && !rs.HasCachedScore) unscored.push_back(i);
+        }
+        // Under a budget, evicting each batch makes room for the next
+        int batchSize = unscored.size();
+        if (matrixBudget_ > 0) batchSize = std::max(1, NumThreads());
+        for (int b = 0; b < static_cast<int>(unscored.size()); b += batchSize)
+        {
+            int e = std::min(static_cast<int>(unscored.size()), b + batchSize);
+            EnsureScorers(std::vector<int>(unscored.begin() + b, unscored.begin() + e));
+        }
+    }
+
+    template<typename R>
+    void MultiReadMutationScorer<R>::KeepToMatrixBudget(const std::vector<int>& spared)
+    {
+        bool recomputes = evictionPolicy_->RecomputesMatrices();
+        size_t totalEntries = 0;
+        std::vector<ReadMatrixUsage> candidates;
+        for (int i = 0; i < static_cast<int>(reads_.size()); i++)
+        {
+            const ReadStateType& rs = reads_[i];
+            if (rs.Scorer == NULL) continue;
+            ReadMatrixUsage usage;
+            usage.ReadIndex = i;
+            usage.AllocatedEntries = (rs.Scorer->Alpha()->AllocatedEntries() +
+                                      rs.Scorer->Beta()->AllocatedEntries());
+            usage.TemplateSpan = rs.Read->TemplateEnd - rs.Read->TemplateStart;
+            usage.Score = rs.Scorer->Score();
+            usage.LastUse = rs.LastUse;
+            totalEntries += usage.AllocatedEntries;
+            if (!recomputes || !std::binary_search(spared.begin(), spared.end(), i))
+            {
+                candidates.push_back(usage);
+            }
+        }
+        peakMatrixEntries_ = std::max(peakMatrixEntries_, totalEntries);
+
+        // Matrix entries are floats
+        size_t budgetEntries = matrixBudget_ / sizeof(float);
+        if (matrixBudget_ == 0 || totalEntries <= budgetEntries) return;
+
+        evictionPolicy_->Rank(&candidates);
+        for (int k = 0; k < static_cast<int>(candidates.size()) && totalEntries > budgetEntries; k++)
+        {
+            ReadStateType& rs = reads_[candidates[k].ReadIndex];
+            if (recomputes)
+            {
+                numPendingReads_++;
+                rs.IsPending = true;
+                rs.HasCachedScore = true;
+                rs.CachedScore = rs.Scorer->Score();
+            }
+            else
+            {
+                rs.IsActive = false;
+            }
+            delete rs.Scorer;
+            rs.Scorer = NULL;
+            totalEntries -= candidates[k].AllocatedEntries;
+        }
+    }
+
+    template<typename R>
+    int MultiReadMutationScorer<R>::ScreeningChunkSize(int numMutations, int numThreads) const
+    {
+        if (matrixBudget_ > 0 && evictionPolicy_->RecomputesMatrices())
+        {
+            return FAST_SCORE_BLOCK_SIZE * std::max(1, numThreads);
+        }
+        return std::max(1, numMutations);
+    }
+
+    template<typename R>
+    bool MultiReadMutationScorer<R>::AddRead(const MappedRead& mr, float threshold)
+    {
+        DEBUG_ONLY(CheckInvariants());
+        // Check the chemistry here, before the read is added
+        quiverConfigByChemistry_.At(mr.Chemistry);
+        reads_.push_back(ReadStateType(new MappedRead(mr), NULL, false));
+        ReadStateType& rs = reads_.back();
+        rs.IsActive = true;
+        rs.IsPending = true;
+        rs.AddThreshold = threshold;
+        rs.LastUse = ++useClock_;
+        numPendingReads_++;
+        readIndexIsStale_ = true;
+        if (lazyAlphaBeta_) return true;
+
+        BuildScorers(std::vector<int>(1, reads_.size() - 1));
+        KeepToMatrixBudget(std::vector<int>());
+        DEBUG_ONLY(CheckInvariants());
+        return reads_.back().IsActive;
+    }
+
+    template<typename R>
+    int MultiReadMutationScorer<R>::AddReads(const std::vector<MappedRead>& mrs)
+    {
+        DEBUG_ONLY(CheckInvariants());
+        std::vector<float> thresholds;
+        foreach (const MappedRead& mr, mrs)
+        {
+            thresholds.push_back(quiverConfigByChemistry_.At(mr.Chemistry).AddThreshold);
+        }
+
+        std::vector<int> readIds;
+        useClock_++;
+        for (int k = 0; k < static_cast<int>(mrs.size()); k++)
+        {
+            readIds.push_back(reads_.size());
+            reads_.push_back(ReadStateType(new MappedRead(mrs[k]), NULL, false));
+            ReadStateType& rs = reads_.back();
+            rs.IsActive = true;
+            rs.IsPending = true;
+            rs.AddThreshold = thresholds[k];
+            rs.LastUse = useClock_;
+        }
+        numPendingReads_ += readIds.size();
+        readIndexIsStale_ = true;
+        if (lazyAlphaBeta_) return readIds.size();
+
+        BuildScorers(readIds);
+        KeepToMatrixBudget(std::vector<int>());
+        DEBUG_ONLY(CheckInvariants());
+
+        int numActive = 0;
+        foreach (int i, readIds)
+        {
+            if (reads_[i].IsActive) numActive++;
+        }
+        return numActive;
     }
 
     template<typename R>
@@ -294,9 +977,24 @@ namespace ConsensusCore
     template<typename R>
     float MultiReadMutationScorer<R>::Score(const Mutation& m) const
     {
+        EnsureScorers(m);
         float sum = 0;
-        foreach (const ReadStateType& rs, reads_)
+        std::vector<int> readIds;
+        if (threadPool_ != NULL)
+        {
+            std::vector<float> deltas;
+            std::vector<unsigned char> isScored;
+            ParallelScores(m, &readIds, &deltas, &isScored);
+            for (int k = 0; k < (int)readIds.size(); k++)
+            {
+                if (isScored[k]) sum += deltas[k];
+            }
+            return sum;
+        }
+        CandidateReads(m, &readIds);
+        foreach (int i, readIds)
         {
+            const ReadStateType& rs = reads_[i];
             if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
             {
                 Mutation orientedMut = OrientedMutation(*rs.Read, m);
@@ -318,9 +1016,31 @@ namespace ConsensusCore
     template<typename R>
     float MultiReadMutationScorer<R>::FastScore(const Mutation& m) const
     {
+        EnsureScorers(m);
         float sum = 0;
-        foreach (const ReadStateType& rs, reads_)
+        std::vector<int> readIds;
+        if (threadPool_ != NULL)
         {
+            // All reads get scored, but the early exit is replayed in
+            // read order so the result matches the serial path.
+            std::vector<float> deltas;
+            std::vector<unsigned char> isScored;
+            ParallelScores(m, &readIds, &deltas, &isScored);
+            for (int k = 0; k < (int)readIds.size(); k++)
+            {
+                if (!isScored[k]) continue;
+                sum += deltas[k];
+                if (sum < fastScoreThreshold_)
+                {
+                    return sum;
+                }
+            }
+            return sum;
+        }
+        CandidateReads(m, &readIds);
+        foreach (int i, readIds)
+        {
+            const ReadStateType& rs = reads_[i];
             if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
             {
                 Mutation orientedMut = OrientedMutation(*rs.Read, m);
@@ -339,18 +1059,29 @@ namespace ConsensusCore
     std::vector<float>
     MultiReadMutationScorer<R>::Scores(const Mutation& m, float unscoredValue) const
     {
-        std::vector<float> scoreByRead;
-        foreach (const ReadStateType& rs, reads_)
+        EnsureScorers(m);
+        std::vector<float> scoreByRead(reads_.size(), unscoredValue);
+        std::vector<int> readIds;
+        if (threadPool_ != NULL)
         {
-            if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
+            std::vector<float> deltas;
+            std::vector<unsigned char> isScored;
+            ParallelScores(m, &readIds, &deltas, &isScored);
+            for (int k = 0; k < (int)readIds.size(); k++)
             {
-                Mutation orientedMut = OrientedMutation(*rs.Read, m);
-                scoreByRead.push_back(rs.Scorer->ScoreMutation(orientedMut) -
-                                      rs.Scorer->Score());
+                if (isScored[k]) scoreByRead[readIds[k]] = deltas[k];
             }
-            else
+            return scoreByRead;
+        }
+        CandidateReads(m, &readIds);
+        foreach (int i, readIds)
+        {
+            const ReadStateType& rs = reads_[i];
+            if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
             {
-                scoreByRead.push_back(unscoredValue);
+                Mutation orientedMut = OrientedMutation(*rs.Read, m);
+                scoreByRead[i] = (rs.Scorer->ScoreMutation(orientedMut) -
+                                  rs.Scorer->Score());
             }
         }
         return scoreByRead;
@@ -368,9 +1099,17 @@ namespace ConsensusCore
     template<typename R>
     bool MultiReadMutationScorer<R>::IsFavorable(const Mutation& m) const
     {
+        EnsureScorers(m);
+        if (threadPool_ != NULL)
+        {
+            return (Score(m) > MIN_FAVORABLE_SCOREDIFF);
+        }
         float sum = 0;
-        foreach (const ReadStateType& rs, reads_)
+        std::vector<int> readIds;
+        CandidateReads(m, &readIds);
+        foreach (int i, readIds)
         {
+            const ReadStateType& rs = reads_[i];
             if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
             {
                 Mutation orientedMut = OrientedMutation(*rs.Read, m);
@@ -384,9 +1123,29 @@ namespace ConsensusCore
     template<typename R>
     bool MultiReadMutationScorer<R>::FastIsFavorable(const Mutation& m) const
     {
+        EnsureScorers(m);
         float sum = 0;
-        foreach (const ReadStateType& rs, reads_)
+        std::vector<int> readIds;
+        if (threadPool_ != NULL)
+        {
+            std::vector<float> deltas;
+            std::vector<unsigned char> isScored;
+            ParallelScores(m, &readIds, &deltas, &isScored);
+            for (int k = 0; k < (int)readIds.size(); k++)
+            {
+                if (!isScored[k]) continue;
+                sum += deltas[k];
+                if (sum < fastScoreThreshold_)
+                {
+                    return false;
+                }
+            }
+            return (sum > MIN_FAVORABLE_SCOREDIFF);
+        }
+        CandidateReads(m, &readIds);
+        foreach (int i, readIds)
         {
+            const ReadStateType& rs = reads_[i];
             if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
             {
                 Mutation orientedMut = OrientedMutation(*rs.Read, m);
@@ -402,27 +1161,326 @@ namespace ConsensusCore
     }
 
 
+    template<typename R>
+    bool
+    MultiReadMutationScorer<R>::ScreenMutation(const Mutation& m,
+                                               std::vector<int>* readIds,
+                                               MatrixType& extendBuffer,
+                                               float* score) const
+    {
+        // As FastIsFavorable; a sum that never dropped below the
+        // threshold is also the Score, term for term.
+        float sum = 0;
+        CandidateReads(m, readIds);
+        foreach (int i, *readIds)
+        {
+            const ReadStateType& rs = reads_[i];
+            if (rs.IsActive && ReadScoresMutation(*rs.Read, m))
+            {
+                Mutation orientedMut = OrientedMutation(*rs.Read, m);
+                sum += (rs.Scorer->ScoreMutation(orientedMut, extendBuffer) -
+                        rs.Scorer->Score());
+                if (sum < fastScoreThreshold_)
+                {
+                    return false;
+                }
+            }
+        }
+        *score = sum;
+        return (sum > MIN_FAVORABLE_SCOREDIFF);
+    }
+
+    template<typename R>
+    std::vector<ScoredMutation>
+    MultiReadMutationScorer<R>::FavorableMutations(const std::vector<Mutation>& candidates,
+                                                   int numThreads,
+                                                   MutationScoreCache* cache) const
+    {
+        int nCandidates = candidates.size();
+        std::vector<float> scores(nCandidates);
+        std::vector<unsigned char> isFavorable(nCandidates, 0);
+        if (cache != NULL)
+        {
+            // FastScore is cut short only below the fast score
+            // threshold, so a favorable FastScore is the Score
+            scores = FastScoreMutations(candidates, numThreads, cache);
+            for (int k = 0; k < nCandidates; k++)
+            {
+                isFavorable[k] = (scores[k] > MIN_FAVORABLE_SCOREDIFF);
+            }
+        }
+        else if (numThreads > 1 && nCandidates > 0)
+        {
+            detail::ThreadPool pool(numThreads);
+            int chunkSize = ScreeningChunkSize(nCandidates, numThreads);
+            for (int begin = 0; begin < nCandidates; begin += chunkSize)
+            {
+                int end = std::min(nCandidates, begin + chunkSize);
+                // The workers only read the index, so it must be current
+                EnsureScorers(candidates, begin, end);
+                UpdateReadIndex();
+                std::vector<Mutation> chunk(candidates.begin() + begin, candidates.begin() + end);
+                detail::ScreenMutationsTask<MultiReadMutationScorer<R> >
+                    task(*this, chunk, &scores[begin], &isFavorable[begin]);
+                pool.ParallelFor(end - begin, task);
+            }
+        }
+        else
+        {
+            int chunkSize = ScreeningChunkSize(nCandidates, numThreads);
+            for (int begin = 0; begin < nCandidates; begin += chunkSize)
+            {
+                int end = std::min(nCandidates, begin + chunkSize);
+                EnsureScorers(candidates, begin, end);
+                for (int k = begin; k < end; k++)
+                {
+                    if (FastIsFavorable(candidates[k]))
+                    {
+                        scores[k] = Score(candidates[k]);
+                        isFavorable[k] = 1;
+                    }
+                }
+            }
+        }
+
+        std::vector<ScoredMutation> favorable;
+        for (int k = 0; k < nCandidates; k++)
+        {
+            if (isFavorable[k]) favorable.push_back(candidates[k].WithScore(scores[k]));
+        }
+        return favorable;
+    }
+
+    template<typename R>
+    void
+    MultiReadMutationScorer<R>::FastScoreBlock(const std::vector<Mutation>& mutations,
+                                               int begin, int end,
+                                               MatrixType& extendBuffer,
+                                               float* sums) const
+    {
+        // Every read that could score a mutation in the block, in read
+        // order, so that each sum is accumulated, and cut short, just
+        // as FastScore's is.
+        int spanBegin = mutations[begin].Start() - 1;
+        int spanEnd = mutations[begin].End();
+        for (int k = begin; k < end; k++)
+        {
+            spanBegin = std::min(spanBegin, mutations[k].Start() - 1);
+            spanEnd = std::max(spanEnd, mutations[k].End());
+            sums[k] = 0;
+        }
+        std::vector<int> readIds;
+        readIndex_.FindOverlapping(spanBegin, spanEnd, &readIds);
+
+        std::vector<unsigned char> isCutShort(end - begin, 0);
+        foreach (int i, readIds)
+        {
+            const ReadStateType& rs = reads_[i];
+            if (!rs.IsActive) continue;
+            for (int k = begin; k < end; k++)
+            {
+                if (!isCutShort[k - begin] && ReadScoresMutation(*rs.Read, mutations[k]))
+                {
+                    Mutation orientedMut = OrientedMutation(*rs.Read, mutations[k]);
+                    sums[k] += (rs.Scorer->ScoreMutation(orientedMut, extendBuffer) -
+                                rs.Scorer->Score());
+                    if (sums[k] < fastScoreThreshold_)
+                    {
+                        isCutShort[k - begin] = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename R>
+    std::vector<float>
+    MultiReadMutationScorer<R>::FastScoreMutations(const std::vector<Mutation>& mutations,
+                                                   int numThreads,
+                                                   MutationScoreCache* cache) const
+    {
+        if (cache != NULL)
+        {
+            std::vector<float> sums(mutations.size());
+            std::vector<Mutation> misses;
+            std::vector<int> missIndices;
+            for (int k = 0; k < static_cast<int>(mutations.size()); k++)
+            {
+                if (!cache->Find(mutations[k], &sums[k]))
+                {
+                    misses.push_back(mutations[k]);
+                    missIndices.push_back(k);
+                }
+            }
+            std::vector<float> missSums = FastScoreMutations(misses, numThreads);
+            for (int j = 0; j < static_cast<int>(misses.size()); j++)
+            {
+                sums[missIndices[j]] = missSums[j];
+                cache->Insert(misses[j], missSums[j]);
+            }
+            return sums;
+        }
+
+        int nMuts = mutations.size();
+        std::vector<float> sums(nMuts, 0.0f);
+        if (nMuts == 0) return sums;
+
+        boost::scoped_ptr<detail::ThreadPool> pool;
+        if (numThreads > 1) pool.reset(new detail::ThreadPool(numThreads));
+        int chunkSize = ScreeningChunkSize(nMuts, numThreads);
+        for (int begin = 0; begin < nMuts; begin += chunkSize)
+        {
+            int end = std::min(nMuts, begin + chunkSize);
+            // The blocks only read the index, so it must be current
+            EnsureScorers(mutations, begin, end);
+            UpdateReadIndex();
+            std::vector<Mutation> chunk(mutations.begin() + begin, mutations.begin() + end);
+            int nBlocks = (end - begin + FAST_SCORE_BLOCK_SIZE - 1) / FAST_SCORE_BLOCK_SIZE;
+            detail::FastScoreMutationsTask<MultiReadMutationScorer<R> >
+                task(*this, chunk, &sums[begin]);
+            if (pool.get() != NULL)
+            {
+                pool->ParallelFor(nBlocks, task);
+            }
+            else
+            {
+                task.Run(0, nBlocks);
+            }
+        }
+        return sums;
+    }
+
+    template<typename R>
+    std::vector<float>
+    MultiReadMutationScorer<R>::ScoreMutations(const std::vector<Mutation>& mutations) const
+    {
+        EnsureAllScorers();
+        int nReads = reads_.size();
+        int nMuts = mutations.size();
+        std::vector<float> totals(nMuts, 0.0f);
+        if (nReads == 0 || nMuts == 0) return totals;
+
+        if (threadPool_ == NULL)
+        {
+            // Accumulate directly, without materializing the matrix
+            foreach (const ReadStateType& rs, reads_)
+            {
+                if (!rs.IsActive) continue;
+                float baseline = rs.Scorer->Score();
+                for (int j = 0; j < nMuts; j++)
+                {
+                    if (ReadScoresMutation(*rs.Read, mutations[j]))
+                    {
+                        Mutation orientedMut = OrientedMutation(*rs.Read, mutations[j]);
+                        totals[j] += rs.Scorer->ScoreMutation(orientedMut) - baseline;
+                    }
+                }
+            }
+            return totals;
+        }
+
+        std::vector<float> deltas(nReads * nMuts);
+        std::vector<unsigned char> isScored(nReads * nMuts);
+        ScoreMutationsByRead(mutations, &deltas[0], &isScored[0]);
+        for (int i = 0; i < nReads; i++)
+        {
+            for (int j = 0; j < nMuts; j++)
+            {
+                if (isScored[i * nMuts + j]) totals[j] += deltas[i * nMuts + j];
+            }
+        }
+        return totals;
+    }
+
+    template<typename R>
+    std::vector<float>
+    MultiReadMutationScorer<R>::ScoreMutations(const std::vector<Mutation>& mutations,
+                                               float unscoredValue,
+                                               float** readScores,
+                                               int* numReads,
+                                               int* numMutations) const
+    {
+        EnsureAllScorers();
+        int nReads = reads_.size();
+        int nMuts = mutations.size();
+        std::vector<float> totals(nMuts, 0.0f);
+
+        // malloc, so that ownership can be handed to numpy
+        float* deltas = static_cast<float*>(malloc(std::max(1, nReads * nMuts) * sizeof(float)));
+        if (deltas == NULL) throw std::bad_alloc();
+        std::vector<unsigned char> isScored;
+        try {
+            isScored.resize(nReads * nMuts);
+            if (nReads > 0 && nMuts > 0)
+            {
+                ScoreMutationsByRead(mutations, deltas, &isScored[0]);
+            }
+        }
+        catch (...)
+        {
+            free(deltas);
+            throw;
+        }
+        for (int i = 0; i < nReads; i++)
+        {
+            for (int j = 0; j < nMuts; j++)
+            {
+                float& delta = deltas[i * nMuts + j];
+                if (isScored[i * nMuts + j])
+                {
+                    totals[j] += delta;
+                }
+                else
+                {
+                    delta = unscoredValue;
+                }
+            }
+        }
+
+        *readScores = deltas;
+        *numReads = nReads;
+        *numMutations = nMuts;
+        return totals;
+    }
+
     template<typename R>
     std::vector<int> MultiReadMutationScorer<R>::AllocatedMatrixEntries() const
     {
         std::vector<int> allocatedCounts;
         for (int i = 0; i < (int)reads_.size(); i++)
         {
-            int n = AlphaMatrix(i)->AllocatedEntries() + BetaMatrix(i)->AllocatedEntries();
-            allocatedCounts.push_back(n);
+            const ScorerType* scorer = reads_[i].Scorer;
+            allocatedCounts.push_back(scorer != NULL ?
+                                      scorer->Alpha()->AllocatedEntries() +
+                                      scorer->Beta()->AllocatedEntries() : 0);
         }
         return allocatedCounts;
     }
 
 
+    template<typename R>
+    std::vector<int> MultiReadMutationScorer<R>::AllocatedMoveTableEntries() const
+    {
+        std::vector<int> allocatedCounts;
+        for (int i = 0; i < (int)reads_.size(); i++)
+        {
+            const ScorerType* scorer = reads_[i].Scorer;
+            allocatedCounts.push_back(scorer != NULL ?
+                                      scorer->Evaluator()->AllocatedMoveTableEntries() : 0);
+        }
+        return allocatedCounts;
+    }
+
     template<typename R>
     std::vector<int> MultiReadMutationScorer<R>::UsedMatrixEntries() const
     {
         std::vector<int> usedCounts;
         for (int i = 0; i < (int)reads_.size(); i++)
         {
-            int n =  AlphaMatrix(i)->UsedEntries() + BetaMatrix(i)->UsedEntries();
-            usedCounts.push_back(n);
+            const ScorerType* scorer = reads_[i].Scorer;
+            usedCounts.push_back(scorer != NULL ?
+                                 scorer->Alpha()->UsedEntries() +
+                                 scorer->Beta()->UsedEntries() : 0);
         }
         return usedCounts;
     }
@@ -431,14 +1489,16 @@ namespace ConsensusCore
     template<typename R>
     const AbstractMatrix* MultiReadMutationScorer<R>::AlphaMatrix(int i) const
     {
-        return reads_[i].Scorer->Alpha();
+        EnsureScorers(std::vector<int>(1, i));
+        return reads_[i].Scorer != NULL ? reads_[i].Scorer->Alpha() : NULL;
     }
 
 
     template<typename R>
     const AbstractMatrix* MultiReadMutationScorer<R>::BetaMatrix(int i) const
     {
-        return reads_[i].Scorer->Beta();
+        EnsureScorers(std::vector<int>(1, i));
+        return reads_[i].Scorer != NULL ? reads_[i].Scorer->Beta() : NULL;
     }
 
 
@@ -448,7 +1508,14 @@ namespace ConsensusCore
         std::vector<int> nFlipFlops;
         foreach (const ReadStateType& rs, reads_)
         {
-            nFlipFlops.push_back(rs.Scorer->NumFlipFlops());
+            if (rs.Scorer != NULL)
+            {
+                nFlipFlops.push_back(rs.Scorer->NumFlipFlops());
+            }
+            else
+            {
+                nFlipFlops.push_back(rs.AlphaBetaMismatch ? -1 : 0);
+            }
         }
         return nFlipFlops;
     }
@@ -457,10 +1524,11 @@ namespace ConsensusCore
     template<typename R>
     float MultiReadMutationScorer<R>::BaselineScore() const
     {
+        EnsureBaselineScores();
         float sum = 0;
         foreach (const ReadStateType& rs, reads_)
         {
-            if (rs.IsActive) sum += rs.Scorer->Score();
+            if (rs.IsActive) sum += (rs.Scorer != NULL ? rs.Scorer->Score() : rs.CachedScore);
         }
         return sum;
     }
@@ -469,10 +1537,14 @@ namespace ConsensusCore
     template<typename R>
     std::vector<float> MultiReadMutationScorer<R>::BaselineScores() const
     {
+        EnsureBaselineScores();
         std::vector<float> scoreByRead;
         foreach (const ReadStateType& rs, reads_)
         {
-            if (rs.IsActive) scoreByRead.push_back(rs.Scorer->Score());
+            if (rs.IsActive)
+            {
+                scoreByRead.push_back(rs.Scorer != NULL ? rs.Scorer->Score() : rs.CachedScore);
+            }
         }
         return scoreByRead;
     }
@@ -485,7 +1557,7 @@ namespace ConsensusCore
         foreach (const ReadStateType& rs, reads_)
         {
             rs.CheckInvariants();
-            if (rs.IsActive) {
+            if (rs.IsActive && !rs.IsPending) {
                 assert(rs.Scorer->Template() == Template(rs.Read->Strand,
                                                          rs.Read->TemplateStart,
                                                          rs.Read->TemplateEnd));
@@ -525,7 +1597,14 @@ namespace ConsensusCore
                                          bool isActive)
             : Read(read),
               Scorer(scorer),
-              IsActive(isActive)
+              IsActive(isActive),
+              ConstructionTime(0),
+              IsPending(false),
+              AddThreshold(1.0f),
+              AlphaBetaMismatch(false),
+              HasCachedScore(false),
+              CachedScore(0),
+              LastUse(0)
         {
             CheckInvariants();
         }
@@ -534,7 +1613,14 @@ namespace ConsensusCore
         ReadState<ScorerType>::ReadState(const ReadState& other)
             : Read(NULL),
               Scorer(NULL),
-              IsActive(other.IsActive)
+              IsActive(other.IsActive),
+              ConstructionTime(other.ConstructionTime),
+              IsPending(other.IsPending),
+              AddThreshold(other.AddThreshold),
+              AlphaBetaMismatch(other.AlphaBetaMismatch),
+              HasCachedScore(other.HasCachedScore),
+              CachedScore(other.CachedScore),
+              LastUse(other.LastUse)
         {
             if (other.Read != NULL) Read = new MappedRead(*other.Read);
             if (other.Scorer != NULL) Scorer = new ScorerType(*other.Scorer);
@@ -552,7 +1638,11 @@ namespace ConsensusCore
         void ReadState<ScorerType>::CheckInvariants() const
         {
 #ifndef NDEBUG
-            if (IsActive)
+            if (IsPending)
+            {
+                assert(Read != NULL && Scorer == NULL);
+            }
+            else if (IsActive)
             {
                 assert(Read != NULL && Scorer != NULL);
                 assert((int)Scorer->Template().length() ==
@@ -565,10 +1655,18 @@ namespace ConsensusCore
         std::string ReadState<ScorerType>::ToString() const
         {
             std::string score;
-            if (IsActive)
+            if (IsActive && Scorer != NULL)
             {
                 score = (boost::format(" (Score= %0.2f)") % Scorer->Score()).str();
             }
+            else if (IsActive && HasCachedScore)
+            {
+                score = (boost::format(" (Score= %0.2f, evicted)") % CachedScore).str();
+            }
+            else if (IsActive)
+            {
+                score = "*PENDING*";
+            }
             else
             {
                 score = "*INACTIVE*";
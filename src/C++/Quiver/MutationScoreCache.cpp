@@ -0,0 +1,143 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/Quiver/MutationScoreCache.hpp>
+
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Types.hpp>
+#include <ConsensusCore/Utils.hpp>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ConsensusCore
+{
+    MutationScoreCache::MutationScoreCache(int invalidationDistance)
+        : invalidationDistance_(invalidationDistance),
+          scores_(),
+          hits_(0),
+          misses_(0)
+    {
+        // A surviving mutation must not touch an applied one, or its
+        // position in the new template would be ill-defined
+        if (invalidationDistance < 1)
+        {
+            throw InvalidInputError("Invalidation distance must be at least 1");
+        }
+    }
+
+    int MutationScoreCache::InvalidationDistance() const
+    {
+        return invalidationDistance_;
+    }
+
+    bool MutationScoreCache::Find(const Mutation& m, float* score)
+    {
+        ScoreMap::const_iterator it = scores_.find(m);
+        if (it == scores_.end())
+        {
+            misses_++;
+            return false;
+        }
+        hits_++;
+        *score = it->second;
+        return true;
+    }
+
+    void MutationScoreCache::Insert(const Mutation& m, float score)
+    {
+        scores_[m] = score;
+    }
+
+    void MutationScoreCache::ApplyMutations(const std::vector<Mutation>& mutations,
+                                            const std::string& tpl)
+    {
+        if (mutations.empty()) return;
+
+        // Mark the template positions within the invalidation distance
+        // of an applied mutation; dropped[p] counts the marked
+        // positions before p.  A cached mutation is dropped if any of
+        // the positions [Start, End] is marked.
+        int tplLength = tpl.length();
+        std::vector<int> marks(tplLength + 2, 0);
+        foreach (const Mutation& m, mutations)
+        {
+            marks[std::max(0, m.Start() - invalidationDistance_)]++;
+            marks[std::min(tplLength + 1, m.End() + invalidationDistance_)]--;
+        }
+        std::vector<int> dropped(tplLength + 2, 0);
+        int depth = 0;
+        for (int p = 0; p <= tplLength; p++)
+        {
+            depth += marks[p];
+            dropped[p + 1] = dropped[p] + (depth > 0 ? 1 : 0);
+        }
+
+        std::vector<int> mtp = TargetToQueryPositions(mutations, tpl);
+        ScoreMap survivors;
+        for (ScoreMap::const_iterator it = scores_.begin(); it != scores_.end(); ++it)
+        {
+            const Mutation& m = it->first;
+            if (dropped[m.End() + 1] > dropped[m.Start()]) continue;
+            Mutation moved(m.Type(), mtp[m.Start()], mtp[m.End()], m.NewBases());
+            survivors.insert(survivors.end(), std::make_pair(moved, it->second));
+        }
+        scores_.swap(survivors);
+    }
+
+    void MutationScoreCache::Clear()
+    {
+        scores_.clear();
+    }
+
+    int MutationScoreCache::Size() const
+    {
+        return scores_.size();
+    }
+
+    int MutationScoreCache::Hits() const
+    {
+        return hits_;
+    }
+
+    int MutationScoreCache::Misses() const
+    {
+        return misses_;
+    }
+}
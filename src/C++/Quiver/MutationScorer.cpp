@@ -45,34 +45,98 @@
 #include <ConsensusCore/Quiver/SseRecursor.hpp>
 #include <ConsensusCore/Mutation.hpp>
 
+#include <algorithm>
 #include <string>
 
 #define EXTEND_BUFFER_COLUMNS 8
 
 namespace ConsensusCore
 {
+    namespace {
+        // The span [editBegin, editEnd) of oldTpl replaced to give
+        // newTpl, found by trimming the common prefix and suffix.
+        void EditSpan(const std::string& oldTpl, const std::string& newTpl,
+                      int* editBegin, int* editEnd)
+        {
+            int oldLen = oldTpl.length();
+            int newLen = newTpl.length();
+            int begin = 0;
+            while (begin < std::min(oldLen, newLen) && oldTpl[begin] == newTpl[begin])
+            {
+                begin++;
+            }
+            int commonSuffix = 0;
+            while (commonSuffix < std::min(oldLen, newLen) - begin &&
+                   oldTpl[oldLen - 1 - commonSuffix] == newTpl[newLen - 1 - commonSuffix])
+            {
+                commonSuffix++;
+            }
+            *editBegin = begin;
+            *editEnd = oldLen - commonSuffix;
+        }
+
+        // Is an incremental refill worthwhile for this edit?
+        bool IsLocalEdit(const std::string& oldTpl, const std::string& newTpl,
+                         int editBegin, int editEnd)
+        {
+            int oldLen = oldTpl.length();
+            int lengthDiff = static_cast<int>(newTpl.length()) - oldLen;
+            return 2 * std::max(editEnd - editBegin, lengthDiff + editEnd - editBegin) < oldLen;
+        }
+
+        // Size a matrix's storage up front to match the one it replaces
+        void ReserveLike(SparseMatrix& m, const SparseMatrix& like)
+        {
+            m.Reserve(like.AllocatedEntries());
+        }
+
+        void ReserveLike(DenseMatrix& m, const DenseMatrix& like)
+        {}
+    }
+
     template<typename R>
     MutationScorer<R>::MutationScorer(const EvaluatorType& evaluator, const R& recursor)
         throw(AlphaBetaMismatchException)
         : evaluator_(new EvaluatorType(evaluator)),
           recursor_(new R(recursor))
     {
+        Init(NULL);
+    }
+
+    template<typename R>
+    MutationScorer<R>::MutationScorer(const EvaluatorType& evaluator, const R& recursor,
+                                      const std::vector<int>& guidePath)
+        throw(AlphaBetaMismatchException)
+        : evaluator_(new EvaluatorType(evaluator)),
+          recursor_(new R(recursor))
+    {
+        Init(&guidePath);
+    }
+
+    template<typename R>
+    void MutationScorer<R>::Init(const std::vector<int>* guidePath)
+        throw(AlphaBetaMismatchException)
+    {
+        alpha_ = beta_ = extendBuffer_ = NULL;
         try {
             // Allocate alpha and beta
-            alpha_ = new MatrixType(evaluator.ReadLength() + 1,
-                                    evaluator.TemplateLength() + 1);
-            beta_ = new MatrixType(evaluator.ReadLength() + 1,
-                                   evaluator.TemplateLength() + 1);
+            alpha_ = new MatrixType(evaluator_->ReadLength() + 1,
+                                    evaluator_->TemplateLength() + 1);
+            beta_ = new MatrixType(evaluator_->ReadLength() + 1,
+                                   evaluator_->TemplateLength() + 1);
             // Buffer where we extend into
-            extendBuffer_ = new MatrixType(evaluator.ReadLength() + 1, EXTEND_BUFFER_COLUMNS);
+            extendBuffer_ = new MatrixType(evaluator_->ReadLength() + 1, EXTEND_BUFFER_COLUMNS);
             // Initial alpha and beta
-            numFlipFlops_ = recursor.FillAlphaBeta(*evaluator_, *alpha_, *beta_);
+            numFlipFlops_ = (guidePath == NULL) ?
+                recursor_->FillAlphaBeta(*evaluator_, *alpha_, *beta_) :
+                recursor_->FillAlphaBeta(*evaluator_, *guidePath, *alpha_, *beta_);
         }
-        catch(AlphaBetaMismatchException e) {
+        catch(const AlphaBetaMismatchException& e) {
             delete alpha_;
             delete beta_;
             delete extendBuffer_;
             delete recursor_;
+            delete evaluator_;
             throw;
         }
     }
@@ -108,14 +172,54 @@ namespace ConsensusCore
     void MutationScorer<R>::Template(std::string tpl)
         throw(AlphaBetaMismatchException)
     {
-        delete alpha_;
-        delete beta_;
+        int editBegin, editEnd;
+        EditSpan(evaluator_->Template(), tpl, &editBegin, &editEnd);
+        if (editBegin == editEnd && tpl.length() == evaluator_->Template().length())
+        {
+            return;  // Unchanged
+        }
+        bool local = IsLocalEdit(evaluator_->Template(), tpl, editBegin, editEnd);
+
         evaluator_->Template(tpl);
+        if (!local)
+        {
+            // Refill from scratch, reusing the existing storage
+            alpha_->Reset(evaluator_->ReadLength() + 1, evaluator_->TemplateLength() + 1);
+            beta_->Reset(evaluator_->ReadLength() + 1, evaluator_->TemplateLength() + 1);
+            try
+            {
+                numFlipFlops_ = recursor_->FillAlphaBeta(*evaluator_, *alpha_, *beta_);
+            }
+            catch (AlphaBetaMismatchException& e)
+            {
+                numFlipFlops_ = -1;
+                throw;
+            }
+            return;
+        }
+
+        MatrixType* oldAlpha = alpha_;
+        MatrixType* oldBeta = beta_;
         alpha_ = new MatrixType(evaluator_->ReadLength() + 1,
                                 evaluator_->TemplateLength() + 1);
         beta_  = new MatrixType(evaluator_->ReadLength() + 1,
                                 evaluator_->TemplateLength() + 1);
-        recursor_->FillAlphaBeta(*evaluator_, *alpha_, *beta_);
+        ReserveLike(*alpha_, *oldAlpha);
+        ReserveLike(*beta_, *oldBeta);
+        try
+        {
+            numFlipFlops_ = recursor_->RefillAlphaBeta(*evaluator_, *oldAlpha, *oldBeta,
+                                                       editBegin, editEnd, *alpha_, *beta_);
+        }
+        catch (AlphaBetaMismatchException& e)
+        {
+            delete oldAlpha;
+            delete oldBeta;
+            numFlipFlops_ = -1;
+            throw;
+        }
+        delete oldAlpha;
+        delete oldBeta;
     }
 
     template<typename R>
@@ -146,20 +250,32 @@ namespace ConsensusCore
     float
     MutationScorer<R>::ScoreMutation(const Mutation& m) const
     {
+        return ScoreMutation(m, *extendBuffer_);
+    }
+
+    template<typename R>
+    float
+    MutationScorer<R>::ScoreMutation(const Mutation& m, MatrixType& extendBuffer) const
+    {
+        if (extendBuffer.Rows() != evaluator_->ReadLength() + 1 ||
+            extendBuffer.Columns() != EXTEND_BUFFER_COLUMNS)
+        {
+            extendBuffer.Reset(evaluator_->ReadLength() + 1, EXTEND_BUFFER_COLUMNS);
+        }
+
         int betaLinkCol = 1 + m.End();
         int absoluteLinkColumn = 1 + m.End() + m.LengthDiff();
-        std::string oldTpl = evaluator_->Template();
-        std::string newTpl = ApplyMutation(m, oldTpl);
         float score;
 
         bool atBegin = (m.Start() < 3);
-        bool atEnd   = (m.End() > (int)oldTpl.length() - 2);
+        bool atEnd   = (m.End() > evaluator_->TemplateLength() - 2);
+
+        // View of the mutated template; shares all storage with
+        // evaluator_, so no copying or allocation happens here.
+        const EvaluatorType mutEvaluator(*evaluator_, m);
 
         if (!atBegin && !atEnd)
         {
-            // Install mutated template
-            evaluator_->Template(newTpl);
-
             int extendStartCol, extendLength;
 
             if (m.Type() == DELETION)
@@ -177,10 +293,10 @@ namespace ConsensusCore
                 assert(extendLength <= EXTEND_BUFFER_COLUMNS);
             }
 
-            recursor_->ExtendAlpha(*evaluator_, *alpha_,
-                                   extendStartCol, *extendBuffer_, extendLength);
-            score = recursor_->LinkAlphaBeta(*evaluator_,
-                                             *extendBuffer_, extendLength,
+            recursor_->ExtendAlpha(mutEvaluator, *alpha_,
+                                   extendStartCol, extendBuffer, extendLength);
+            score = recursor_->LinkAlphaBeta(mutEvaluator,
+                                             extendBuffer, extendLength,
                                              *beta_, betaLinkCol,
                                              absoluteLinkColumn);
         }
@@ -189,14 +305,12 @@ namespace ConsensusCore
             //
             // Extend alpha to end
             //
-            evaluator_->Template(newTpl);
-
             int extendStartCol = m.Start() - 1;
-            int extendLength = newTpl.length() - extendStartCol + 1;
+            int extendLength = mutEvaluator.TemplateLength() - extendStartCol + 1;
 
-            recursor_->ExtendAlpha(*evaluator_, *alpha_,
-                                   extendStartCol, *extendBuffer_, extendLength);
-            score = (*extendBuffer_)(evaluator_->ReadLength(), extendLength - 1);
+            recursor_->ExtendAlpha(mutEvaluator, *alpha_,
+                                   extendStartCol, extendBuffer, extendLength);
+            score = extendBuffer(mutEvaluator.ReadLength(), extendLength - 1);
 
             // if (fabs(score - Score()) > 50) {
             //     // FIXME!  This happens on fluidigm amplicons, figure out why
@@ -208,15 +322,13 @@ namespace ConsensusCore
             //
             // Extend beta back
             //
-            evaluator_->Template(newTpl);
-
             int extendLastCol = m.End();
             int extendLength = m.End() + m.LengthDiff() + 1;
 
-            recursor_->ExtendBeta(*evaluator_, *beta_,
-                                  extendLastCol, *extendBuffer_, extendLength,
+            recursor_->ExtendBeta(mutEvaluator, *beta_,
+                                  extendLastCol, extendBuffer, extendLength,
                                   m.LengthDiff());
-            score = (*extendBuffer_)(0, 0);
+            score = extendBuffer(0, 0);
         }
         else
         {
@@ -224,16 +336,12 @@ namespace ConsensusCore
             //
             // Just do the whole fill
             //
-            MatrixType alphaP(evaluator_->ReadLength() + 1,
-                              newTpl.length() + 1);
-            evaluator_->Template(newTpl);
-            recursor_->FillAlpha(*evaluator_, MatrixType::Null(), alphaP);
-            score = alphaP(evaluator_->ReadLength(), newTpl.length());
+            MatrixType alphaP(mutEvaluator.ReadLength() + 1,
+                              mutEvaluator.TemplateLength() + 1);
+            recursor_->FillAlpha(mutEvaluator, MatrixType::Null(), alphaP);
+            score = alphaP(mutEvaluator.ReadLength(), mutEvaluator.TemplateLength());
         }
 
-        // Restore the original template.
-        evaluator_->Template(oldTpl);
-
         // if (fabs(score - Score()) > 50) { Breakpoint(); }
 
         return score;
@@ -66,6 +66,7 @@ namespace ConsensusCore
             : MinDinucleotideRepeatElements(minDinucleotideRepeatElements)
         {
             MaximumIterations = 1;
+            NumThreads = 1;
         }
 
         int MinDinucleotideRepeatElements;
@@ -129,6 +130,17 @@ namespace ConsensusCore
     }
 
 
+    int NumActiveReads(const AbstractMultiReadMutationScorer& mms)
+    {
+        int numActive = 0;
+        for (int i = 0; i < mms.NumReads(); i++)
+        {
+            if (mms.Read(i) != NULL) numActive++;
+        }
+        return numActive;
+    }
+
+
     int ProbabilityToQV(double probability, int cap = 93)
     {
         using std::min;
@@ -156,7 +168,8 @@ namespace ConsensusCore
     }
 
     template <typename E, typename O>
-    bool AbstractRefineConsensus(AbstractMultiReadMutationScorer& mms, const O& opts)
+    bool AbstractRefineConsensus(AbstractMultiReadMutationScorer& mms, const O& opts,
+                                 MutationScoreCache* cache = NULL)
     {
         bool isConverged = false;
         float score = mms.BaselineScore();
@@ -200,14 +213,7 @@ namespace ConsensusCore
             //
             // Screen for favorable mutations.  If none, we are done (converged).
             //
-            favorableMutsAndScores.clear();
-            foreach (const Mutation& m, mutationsToTry)
-            {
-                if (mms.FastIsFavorable(m)) {
-                    float mutScore = mms.Score(m);
-                    favorableMutsAndScores.push_back(m.WithScore(mutScore));
-                }
-            }
+            favorableMutsAndScores = mms.FavorableMutations(mutationsToTry, opts.NumThreads, cache);
             if (favorableMutsAndScores.empty())
             {
                 isConverged = true;
@@ -241,7 +247,18 @@ namespace ConsensusCore
             }
 
             tplHistory.insert(hash(mms.Template()));
-            mms.ApplyMutations(ProjectDown(bestSubset));
+            if (cache != NULL)
+            {
+                // Cached scores are only good for the same reads
+                int numActiveReads = NumActiveReads(mms);
+                cache->ApplyMutations(ProjectDown(bestSubset), mms.Template());
+                mms.ApplyMutations(ProjectDown(bestSubset));
+                if (NumActiveReads(mms) != numActiveReads) cache->Clear();
+            }
+            else
+            {
+                mms.ApplyMutations(ProjectDown(bestSubset));
+            }
         }
 
         return isConverged;
@@ -249,9 +266,10 @@ namespace ConsensusCore
     }  // PRIVATE
 
 
-    bool RefineConsensus(AbstractMultiReadMutationScorer& mms, const RefineOptions& opts)
+    bool RefineConsensus(AbstractMultiReadMutationScorer& mms, const RefineOptions& opts,
+                         MutationScoreCache* cache)
     {
-        return AbstractRefineConsensus<UniqueSingleBaseMutationEnumerator>(mms, opts);
+        return AbstractRefineConsensus<UniqueSingleBaseMutationEnumerator>(mms, opts, cache);
     }
 
 
@@ -263,16 +281,31 @@ namespace ConsensusCore
     }
 
 
-    std::vector<int> ConsensusQVs(AbstractMultiReadMutationScorer& mms)
+    std::vector<int> ConsensusQVs(AbstractMultiReadMutationScorer& mms, int numThreads,
+                                  MutationScoreCache* cache)
     {
+        // Score every position's mutations in one go, so that the
+        // scorer can visit each read once per block of positions
+        std::string tpl = mms.Template();
+        UniqueSingleBaseMutationEnumerator mutationEnumerator(tpl);
+        std::vector<Mutation> mutations;
+        std::vector<int> positionEnds;
+        for (size_t pos = 0; pos < tpl.length(); pos++)
+        {
+            std::vector<Mutation> atPos = mutationEnumerator.Mutations(pos, pos + 1);
+            mutations.insert(mutations.end(), atPos.begin(), atPos.end());
+            positionEnds.push_back(mutations.size());
+        }
+        std::vector<float> scores = mms.FastScoreMutations(mutations, numThreads, cache);
+
         std::vector<int> QVs;
-        UniqueSingleBaseMutationEnumerator mutationEnumerator(mms.Template());
-        for (size_t pos = 0; pos < mms.Template().length(); pos++)
+        int k = 0;
+        for (size_t pos = 0; pos < tpl.length(); pos++)
         {
             double scoreSum = 0.0;
-            foreach (const Mutation& m, mutationEnumerator.Mutations(pos, pos + 1))
+            for (; k < positionEnds[pos]; k++)
             {
-                scoreSum += exp(mms.FastScore(m));
+                scoreSum += exp(scores[k]);
             }
             QVs.push_back(ProbabilityToQV(1.0 - 1.0 / (1.0 + scoreSum)));
         }
@@ -0,0 +1,78 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
+
+namespace ConsensusCore
+{
+    bool IsSimdTargetSupported(SimdTarget target)
+    {
+        switch (target)
+        {
+            case SSE3_TARGET:
+                return true;
+#if CONSENSUSCORE_WIDE_KERNELS
+            case AVX2_TARGET:
+                return __builtin_cpu_supports("avx2");
+            case AVX512_TARGET:
+                return __builtin_cpu_supports("avx512f");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    SimdTarget BestSimdTarget()
+    {
+        // AVX-512 is not (yet) faster than AVX2: Quiver's bands are
+        // rarely tall enough for its 16-row blocks.  It is opt-in.
+        static const SimdTarget best =
+            IsSimdTargetSupported(AVX2_TARGET) ? AVX2_TARGET : SSE3_TARGET;
+        return best;
+    }
+
+    const char* SimdTargetName(SimdTarget target)
+    {
+        switch (target)
+        {
+            case SSE3_TARGET:   return "SSE3";
+            case AVX2_TARGET:   return "AVX2";
+            case AVX512_TARGET: return "AVX-512";
+            default:            return "unknown";
+        }
+    }
+}
@@ -61,6 +61,15 @@ namespace ConsensusCore {
     template<typename M, typename E, typename C>
     void
     SimpleRecursor<M, E, C>::FillAlpha(const E& e, const M& guide, M& alpha) const
+    {
+        FillAlpha(e, guide, alpha, 0, e.TemplateLength() + 1);
+    }
+
+
+    template<typename M, typename E, typename C>
+    void
+    SimpleRecursor<M, E, C>::FillAlpha(const E& e, const M& guide, M& alpha,
+                                       int beginColumn, int endColumn) const
     {
         int I = e.ReadLength();
         int J = e.TemplateLength();
@@ -68,12 +77,24 @@ namespace ConsensusCore {
         assert(alpha.Rows() == I + 1 && alpha.Columns() == J + 1);
         assert(guide.IsNull() ||
                (guide.Rows() == alpha.Rows() && guide.Columns() == alpha.Columns()));
+        assert(0 <= beginColumn && beginColumn <= endColumn && endColumn <= J + 1);
 
+        float scoreDiff = this->bandingOptions_.ScoreDiff;
         int hintBeginRow = 0, hintEndRow = 0;
+        if (beginColumn > 0)
+        {
+            detail::AlphaResumeHints(beginColumn - 1, alpha, this->bandingOptions_.ScoreDiff,
+                                     &hintBeginRow, &hintEndRow);
+            scoreDiff = this->NextScoreDiff(alpha, beginColumn - 1);
+        }
 
-        for (int j = 0; j <= J; ++j)
+        for (int j = beginColumn; j < endColumn; ++j)
         {
-            this->RangeGuide(j, guide, alpha, &hintBeginRow, &hintEndRow);
+            int bandEndRow = I + 1;
+            if (!this->RangeGuide(j, guide, alpha, &hintBeginRow, &hintEndRow))
+            {
+                this->DiagonalBand(j, I, J, &hintBeginRow, &hintEndRow, &bandEndRow);
+            }
 
             int requiredEndRow = min(I + 1, hintEndRow);
 
@@ -86,7 +107,7 @@ namespace ConsensusCore {
 
             int beginRow = hintBeginRow, endRow;
             for (i = beginRow;
-                 i < I + 1 && (score >= thresholdScore || i < requiredEndRow);
+                 i < bandEndRow && (score >= thresholdScore || i < requiredEndRow);
                  ++i)
             {
                 float thisMoveScore;
@@ -132,7 +153,7 @@ namespace ConsensusCore {
                 if (score > maxScore)
                 {
                     maxScore = score;
-                    thresholdScore = maxScore - this->bandingOptions_.ScoreDiff;
+                    thresholdScore = maxScore - scoreDiff;
                 }
             }
 
@@ -144,6 +165,8 @@ namespace ConsensusCore {
             hintEndRow = endRow;
             for (i = beginRow; i < endRow && alpha(i, j) < thresholdScore; ++i);
             hintBeginRow = i;
+
+            scoreDiff = this->NextScoreDiff(alpha, j);
         }
     }
 
@@ -151,6 +174,15 @@ namespace ConsensusCore {
     template<typename M, typename E, typename C>
     void
     SimpleRecursor<M, E, C>::FillBeta(const E& e, const M& guide, M& beta) const
+    {
+        FillBeta(e, guide, beta, 0, e.TemplateLength() + 1);
+    }
+
+
+    template<typename M, typename E, typename C>
+    void
+    SimpleRecursor<M, E, C>::FillBeta(const E& e, const M& guide, M& beta,
+                                      int beginColumn, int endColumn) const
     {
         int I = e.ReadLength();
         int J = e.TemplateLength();
@@ -158,10 +190,18 @@ namespace ConsensusCore {
         assert(beta.Rows() == I + 1 && beta.Columns() == J + 1);
         assert(guide.IsNull() ||
                (guide.Rows() == beta.Rows() && guide.Columns() == beta.Columns()));
+        assert(0 <= beginColumn && beginColumn <= endColumn && endColumn <= J + 1);
 
+        float scoreDiff = this->bandingOptions_.ScoreDiff;
         int hintBeginRow = I + 1, hintEndRow = I + 1;
+        if (endColumn <= J)
+        {
+            detail::BetaResumeHints(endColumn, beta, this->bandingOptions_.ScoreDiff,
+                                    &hintBeginRow, &hintEndRow);
+            scoreDiff = this->NextScoreDiff(beta, endColumn);
+        }
 
-        for (int j = J; j >= 0; --j)
+        for (int j = endColumn - 1; j >= beginColumn; --j)
         {
             this->RangeGuide(j, guide, beta, &hintBeginRow, &hintEndRow);
 
@@ -222,7 +262,7 @@ namespace ConsensusCore {
                 if (score > maxScore)
                 {
                     maxScore = score;
-                    thresholdScore = maxScore - this->bandingOptions_.ScoreDiff;
+                    thresholdScore = maxScore - scoreDiff;
                 }
             }
 
@@ -236,6 +276,8 @@ namespace ConsensusCore {
                  i > beginRow && beta(i - 1, j) < thresholdScore;
                  --i);
             hintEndRow = i;
+
+            scoreDiff = this->NextScoreDiff(beta, j);
         }
     }
 
@@ -45,11 +45,13 @@
 #include <ConsensusCore/Quiver/detail/Combiner.hpp>
 #include <ConsensusCore/Quiver/QvEvaluator.hpp>
 #include <ConsensusCore/Quiver/SimpleRecursor.hpp>
+#include <ConsensusCore/Quiver/detail/WideKernels.hpp>
 
 #include <algorithm>
 #include <boost/tuple/tuple.hpp>
 #include <climits>
 #include <numeric>
+#include <string>
 #include <utility>
 
 
@@ -74,18 +76,65 @@ namespace ConsensusCore {
     void
     SseRecursor<M, E, C>::FillAlpha(const E& e, const M& guide, M& alpha) const
     {
-        int I = e.ReadLength();
-        int J = e.TemplateLength();
+        FillAlpha(e, guide, alpha, 0, e.TemplateLength() + 1);
+    }
+
 
-        assert(alpha.Rows() == I + 1 && alpha.Columns() == J + 1);
+    template<typename M, typename E, typename C>
+    void
+    SseRecursor<M, E, C>::FillAlpha(const E& e, const M& guide, M& alpha,
+                                    int beginColumn, int endColumn) const
+    {
+        assert(alpha.Rows() == e.ReadLength() + 1 && alpha.Columns() == e.TemplateLength() + 1);
         assert(guide.IsNull() ||
                (guide.Rows() == alpha.Rows() && guide.Columns() == alpha.Columns()));
+        assert(0 <= beginColumn && beginColumn <= endColumn && endColumn <= e.TemplateLength() + 1);
+
+        // Wider kernels, where there are any for this recursor type
+        if ((target_ == AVX512_TARGET &&
+             detail::FillAlphaAvx512(*this, e, guide, alpha, beginColumn, endColumn)) ||
+            (target_ >= AVX2_TARGET &&
+             detail::FillAlphaAvx2(*this, e, guide, alpha, beginColumn, endColumn)))
+        {
+            return;
+        }
+
+        if (this->movesAvailable_ & MERGE)
+        {
+            FillAlphaImpl<true>(e, guide, alpha, beginColumn, endColumn);
+        }
+        else
+        {
+            FillAlphaImpl<false>(e, guide, alpha, beginColumn, endColumn);
+        }
+    }
+
 
+    template<typename M, typename E, typename C>
+    template<bool MergeMoves>
+    INLINE_CALLEES void
+    SseRecursor<M, E, C>::FillAlphaImpl(const E& e, const M& guide, M& alpha,
+                                        int beginColumn, int endColumn) const
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+
+        float scoreDiff = this->bandingOptions_.ScoreDiff;
         int hintBeginRow = 0, hintEndRow = 0;
+        if (beginColumn > 0)
+        {
+            detail::AlphaResumeHints(beginColumn - 1, alpha, this->bandingOptions_.ScoreDiff,
+                                     &hintBeginRow, &hintEndRow);
+            scoreDiff = this->NextScoreDiff(alpha, beginColumn - 1);
+        }
 
-        for (int j = 0; j <= J; ++j)
+        for (int j = beginColumn; j < endColumn; ++j)
         {
-            this->RangeGuide(j, guide, alpha, &hintBeginRow, &hintEndRow);
+            int bandEndRow = I + 1;
+            if (!this->RangeGuide(j, guide, alpha, &hintBeginRow, &hintEndRow))
+            {
+                this->DiagonalBand(j, I, J, &hintBeginRow, &hintEndRow, &bandEndRow);
+            }
 
             int requiredEndRow = min(I + 1, hintEndRow);
 
@@ -124,7 +173,7 @@ namespace ConsensusCore {
                     score = C::Combine(score, alpha(i - 1, j - 1) + e.Inc(i - 1, j - 1));
                 }
                 // Merge
-                if ((this->movesAvailable_ & MERGE) && (i > 0 && j > 1))
+                if (MergeMoves && (i > 0 && j > 1))
                 {
                     score = C::Combine(score, alpha(i - 1, j - 2) + e.Merge(i - 1, j - 2));
                 }
@@ -143,7 +192,7 @@ namespace ConsensusCore {
                 if (score > maxScore)
                 {
                     maxScore = score;
-                    thresholdScore = maxScore - this->bandingOptions_.ScoreDiff;
+                    thresholdScore = maxScore - scoreDiff;
                 }
             }
             //
@@ -151,7 +200,7 @@ namespace ConsensusCore {
             //
             assert(i > 0);
             for (;
-                 i <= I && (score >= thresholdScore || i < requiredEndRow);
+                 i < bandEndRow && (score >= thresholdScore || i < requiredEndRow);
                  i += 4)
             {
                 __m128 score4 = NEG_INF_4;
@@ -161,7 +210,7 @@ namespace ConsensusCore {
                     score4 = C::Combine4(score4, alpha.Get4(i - 1, j - 1) + e.Inc4(i - 1, j - 1));
                 }
                 // Merge
-                if ((this->movesAvailable_ & MERGE) && j >= 2)
+                if (MergeMoves && j >= 2)
                 {
                     score4 = C::Combine4(score4, alpha.Get4(i - 1, j - 2) + e.Merge4(i - 1, j - 2));
                 }
@@ -171,33 +220,19 @@ namespace ConsensusCore {
                     score4 = C::Combine4(score4, alpha.Get4(i, j - 1) + e.Del4(i, j - 1));
                 }
 
-                //
-                // Extra (non-SSE cascade)
-                //
-                float insScores4_[4], score5_[5];
-
-                __m128 insScores4 = e.Extra4(i - 1, j);
-                _mm_storeu_ps(insScores4_, insScores4);
-
-                score5_[0] = alpha.Get(i - 1, j);
-                _mm_storeu_ps(&score5_[1], score4);
-
-                for (int ii = 1; ii < 5; ii++)
-                {
-                    float v = C::Combine(score5_[ii], score5_[ii - 1] + insScores4_[ii - 1]);
-                    score5_[ii] = v;
-                }
-                score4 = _mm_loadu_ps(&score5_[1]);
+                // Extra
+                score4 = detail::CascadeDown4<C>(score4, e.Extra4(i - 1, j),
+                                                 alpha.Get(i - 1, j));
                 alpha.Set4(i, j, score4);
 
                 // Update score, potentialNewMax
-                float potentialNewMax = *std::max_element(score5_ + 1, score5_ + 5);
-                score = *std::min_element(score5_ + 1, score5_ + 5);
+                float potentialNewMax = detail::horizontalMax4(score4);
+                score = detail::horizontalMin4(score4);
 
                 if (potentialNewMax > maxScore)
                 {
                     maxScore = potentialNewMax;
-                    thresholdScore = maxScore - this->bandingOptions_.ScoreDiff;
+                    thresholdScore = maxScore - scoreDiff;
                 }
             }
 
@@ -209,6 +244,8 @@ namespace ConsensusCore {
             hintEndRow = endRow;
             for (i = beginRow; i < endRow && alpha(i, j) < thresholdScore; ++i);
             hintBeginRow = i;
+
+            scoreDiff = this->NextScoreDiff(alpha, j);
         }
     }
 
@@ -217,16 +254,59 @@ namespace ConsensusCore {
     void
     SseRecursor<M, E, C>::FillBeta(const E& e, const M& guide, M& beta) const
     {
-        int I = e.ReadLength();
-        int J = e.TemplateLength();
+        FillBeta(e, guide, beta, 0, e.TemplateLength() + 1);
+    }
+
 
-        assert(beta.Rows() == I + 1 && beta.Columns() == J + 1);
+    template<typename M, typename E, typename C>
+    void
+    SseRecursor<M, E, C>::FillBeta(const E& e, const M& guide, M& beta,
+                                   int beginColumn, int endColumn) const
+    {
+        assert(beta.Rows() == e.ReadLength() + 1 && beta.Columns() == e.TemplateLength() + 1);
         assert(guide.IsNull() ||
                (guide.Rows() == beta.Rows() && guide.Columns() == beta.Columns()));
+        assert(0 <= beginColumn && beginColumn <= endColumn &&
+               endColumn <= e.TemplateLength() + 1);
+
+        if ((target_ == AVX512_TARGET &&
+             detail::FillBetaAvx512(*this, e, guide, beta, beginColumn, endColumn)) ||
+            (target_ >= AVX2_TARGET &&
+             detail::FillBetaAvx2(*this, e, guide, beta, beginColumn, endColumn)))
+        {
+            return;
+        }
+
+        if (this->movesAvailable_ & MERGE)
+        {
+            FillBetaImpl<true>(e, guide, beta, beginColumn, endColumn);
+        }
+        else
+        {
+            FillBetaImpl<false>(e, guide, beta, beginColumn, endColumn);
+        }
+    }
+
 
+    template<typename M, typename E, typename C>
+    template<bool MergeMoves>
+    INLINE_CALLEES void
+    SseRecursor<M, E, C>::FillBetaImpl(const E& e, const M& guide, M& beta,
+                                       int beginColumn, int endColumn) const
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+
+        float scoreDiff = this->bandingOptions_.ScoreDiff;
         int hintBeginRow = I + 1, hintEndRow = I + 1;
+        if (endColumn <= J)
+        {
+            detail::BetaResumeHints(endColumn, beta, this->bandingOptions_.ScoreDiff,
+                                    &hintBeginRow, &hintEndRow);
+            scoreDiff = this->NextScoreDiff(beta, endColumn);
+        }
 
-        for (int j = J; j >= 0; --j)
+        for (int j = endColumn - 1; j >= beginColumn; --j)
         {
             this->RangeGuide(j, guide, beta, &hintBeginRow, &hintEndRow);
 
@@ -260,7 +340,7 @@ namespace ConsensusCore {
                     score = C::Combine(score, beta(i + 1, j + 1) + e.Inc(i, j));
                 }
                 // Merge
-                if ((this->movesAvailable_ & MERGE) && j < J - 1 && i < I)
+                if (MergeMoves && j < J - 1 && i < I)
                 {
                     score = C::Combine(score, beta(i + 1, j + 2) + e.Merge(i, j));
                 }
@@ -280,7 +360,7 @@ namespace ConsensusCore {
                 if (score > maxScore)
                 {
                     maxScore = score;
-                    thresholdScore = maxScore - this->bandingOptions_.ScoreDiff;
+                    thresholdScore = maxScore - scoreDiff;
                 }
             }
             //
@@ -299,7 +379,7 @@ namespace ConsensusCore {
                     score4 = C::Combine4(score4, beta.Get4(i + 1, j + 1) + e.Inc4(i, j));
                 }
                 // Merge
-                if ((this->movesAvailable_ & MERGE) && j < J - 1 && i < I)
+                if (MergeMoves && j < J - 1 && i < I)
                 {
                     score4 = C::Combine4(score4, beta.Get4(i + 1, j + 2) + e.Merge4(i, j));
                 }
@@ -309,33 +389,18 @@ namespace ConsensusCore {
                     score4 = C::Combine4(score4, beta.Get4(i, j + 1) + e.Del4(i, j));
                 }
 
-                //
-                // Extra (non-SSE cascade)
-                //
-                float insScores4_[4], score5_[5];
-
-                __m128 insScores4 = e.Extra4(i, j);
-                _mm_storeu_ps(insScores4_, insScores4);
-
-                score5_[4] = beta.Get(i + 4, j);
-                _mm_storeu_ps(score5_, score4);
-
-                for (int ii = 3; ii >= 0; ii--)
-                {
-                    float v = C::Combine(score5_[ii], score5_[ii + 1] + insScores4_[ii]);
-                    score5_[ii] = v;
-                }
-                score4 = _mm_loadu_ps(score5_);
+                // Extra
+                score4 = detail::CascadeUp4<C>(score4, e.Extra4(i, j), beta.Get(i + 4, j));
                 beta.Set4(i, j, score4);
 
                 // Update score, potentialNewMax
-                float potentialNewMax = *std::max_element(score5_, score5_ + 4);
-                score = *std::min_element(score5_, score5_ + 4);
+                float potentialNewMax = detail::horizontalMax4(score4);
+                score = detail::horizontalMin4(score4);
 
                 if (potentialNewMax > maxScore)
                 {
                     maxScore = potentialNewMax;
-                    thresholdScore = maxScore - this->bandingOptions_.ScoreDiff;
+                    thresholdScore = maxScore - scoreDiff;
                 }
             }
 
@@ -349,15 +414,31 @@ namespace ConsensusCore {
                  i > beginRow && beta(i - 1, j) < thresholdScore;
                  i--);
             hintEndRow = i;
+
+            scoreDiff = this->NextScoreDiff(beta, j);
         }
     }
 
     template<typename M, typename E, typename C>
-    INLINE_CALLEES float
+    float
     SseRecursor<M, E, C>::LinkAlphaBeta(const E& e,
                                         const M& alpha, int alphaColumn,
                                         const M& beta, int betaColumn,
                                         int absoluteColumn) const
+    {
+        return (this->movesAvailable_ & MERGE) ?
+            LinkAlphaBetaImpl<true>(e, alpha, alphaColumn, beta, betaColumn, absoluteColumn) :
+            LinkAlphaBetaImpl<false>(e, alpha, alphaColumn, beta, betaColumn, absoluteColumn);
+    }
+
+
+    template<typename M, typename E, typename C>
+    template<bool MergeMoves>
+    INLINE_CALLEES float
+    SseRecursor<M, E, C>::LinkAlphaBetaImpl(const E& e,
+                                            const M& alpha, int alphaColumn,
+                                            const M& beta, int betaColumn,
+                                            int absoluteColumn) const
     {
         const int I = e.ReadLength();
 
@@ -383,7 +464,7 @@ namespace ConsensusCore {
                                  e.Inc4(i, absoluteColumn - 1) +
                                  beta.Get4(i + 1, betaColumn));
             // Merge (2 possible ways):
-            if (this->movesAvailable_ & MERGE)
+            if (MergeMoves)
             {
                 v4 = C::Combine4(v4, alpha.Get4(i, alphaColumn - 2) +
                                      e.Merge4(i, absoluteColumn - 2) +
@@ -407,7 +488,7 @@ namespace ConsensusCore {
                                   e.Inc(i, absoluteColumn - 1) +
                                   beta(i + 1, betaColumn));
                 // Merge (2 possible ways):
-                if (this->movesAvailable_ & MERGE)
+                if (MergeMoves)
                 {
                     v = C::Combine(v, alpha(i, alphaColumn - 2) +
                                       e.Merge(i, absoluteColumn - 2) +
@@ -431,10 +512,28 @@ namespace ConsensusCore {
     }
 
     template<typename M, typename E, typename C>
-    INLINE_CALLEES void
+    void
     SseRecursor<M, E, C>::ExtendAlpha(const E& e,
                                       const M& alpha, int beginColumn,
                                       M& ext, int numExtColumns) const
+    {
+        if (this->movesAvailable_ & MERGE)
+        {
+            ExtendAlphaImpl<true>(e, alpha, beginColumn, ext, numExtColumns);
+        }
+        else
+        {
+            ExtendAlphaImpl<false>(e, alpha, beginColumn, ext, numExtColumns);
+        }
+    }
+
+
+    template<typename M, typename E, typename C>
+    template<bool MergeMoves>
+    INLINE_CALLEES void
+    SseRecursor<M, E, C>::ExtendAlphaImpl(const E& e,
+                                          const M& alpha, int beginColumn,
+                                          M& ext, int numExtColumns) const
     {
         assert(numExtColumns >= 2);
         assert(alpha.Rows() == e.ReadLength() + 1 &&
@@ -491,7 +590,7 @@ namespace ConsensusCore {
                     score = C::Combine(score, prev + e.Extra(i - 1, j));
 
                     // Merge
-                    if (this->movesAvailable_ & MERGE)
+                    if (MergeMoves)
                     {
                         prev = alpha(i - 1, j - 2);
                         score = C::Combine(score, prev + e.Merge(i - 1, j - 2));
@@ -515,7 +614,7 @@ namespace ConsensusCore {
                 score4 = C::Combine4(score4, prev4 + e.Inc4(i - 1, j - 1));
 
                 // Merge
-                if ((this->movesAvailable_ & MERGE) && j >= 2)
+                if (MergeMoves && j >= 2)
                 {
                     prev4 = alpha.Get4(i - 1, j - 2);
                     score4 = C::Combine4(score4, prev4 + e.Merge4(i - 1, j - 2));
@@ -528,20 +627,8 @@ namespace ConsensusCore {
                 score4 = C::Combine4(score4, prev4 + e.Del4(i, j - 1));
 
                 // Extras:
-                float insScores4_[4], score5_[5];
-
-                __m128 insScores4 = e.Extra4(i - 1, j);
-                _mm_storeu_ps(insScores4_, insScores4);
-
-                score5_[0] = ext.Get(i - 1, extCol);
-                _mm_storeu_ps(&score5_[1], score4);
-
-                for (int ii = 1; ii < 5; ii++)
-                {
-                    float v = C::Combine(score5_[ii], score5_[ii - 1] + insScores4_[ii - 1]);
-                    score5_[ii] = v;
-                }
-                score4 = _mm_loadu_ps(&score5_[1]);
+                score4 = detail::CascadeDown4<C>(score4, e.Extra4(i - 1, j),
+                                                 ext.Get(i - 1, extCol));
                 ext.Set4(i, extCol, score4);
             }
             assert (i == endRow);
@@ -566,9 +653,29 @@ namespace ConsensusCore {
     template<typename M, typename E, typename C>
     SseRecursor<M, E, C>::SseRecursor(int movesAvailable, const BandingOptions& banding)
         : detail::RecursorBase<M, E, C>(movesAvailable, banding),
-          simpleRecursor_(movesAvailable, banding)
+          simpleRecursor_(movesAvailable, banding),
+          target_(BestSimdTarget())
     {}
 
+    template<typename M, typename E, typename C>
+    SimdTarget
+    SseRecursor<M, E, C>::Target() const
+    {
+        return target_;
+    }
+
+    template<typename M, typename E, typename C>
+    void
+    SseRecursor<M, E, C>::Target(SimdTarget target)
+    {
+        if (!IsSimdTargetSupported(target))
+        {
+            throw UnsupportedFeatureError(std::string(SimdTargetName(target)) +
+                                          " is not supported on this processor");
+        }
+        target_ = target;
+    }
+
     template class SseRecursor<DenseMatrix,  QvEvaluator, detail::ViterbiCombiner>;
     template class SseRecursor<SparseMatrix, QvEvaluator, detail::ViterbiCombiner>;
     template class SseRecursor<SparseMatrix, QvEvaluator, detail::SumProductCombiner>;
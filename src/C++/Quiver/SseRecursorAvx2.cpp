@@ -0,0 +1,171 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// AVX2 kernels for SseRecursor; see detail/WideKernels.hpp.  All
+// headers are included before the target pragma, so that only the
+// code below---and not any inline or template code shared with the
+// rest of the library---is compiled for AVX2.
+//
+
+#include <ConsensusCore/Matrix/DenseMatrix.hpp>
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
+#include <ConsensusCore/Quiver/detail/Combiner.hpp>
+#include <ConsensusCore/Quiver/detail/RecursorBase.hpp>
+#include <ConsensusCore/Quiver/detail/WideKernels.hpp>
+
+#include <cfloat>
+#include <immintrin.h>
+
+#if CONSENSUSCORE_WIDE_KERNELS
+
+// No fused multiply-adds: the kernels must round exactly as SSE3's do,
+// else the banding cutoffs, and so the cells filled, could differ.
+#if defined(__clang__)
+#  pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#  pragma STDC FP_CONTRACT OFF
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx2")
+#  pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace ConsensusCore {
+namespace detail {
+
+namespace {
+    // Vector traits for WideKernels-inl.hpp: 8 floats
+    struct Avx2
+    {
+        typedef __m256 Vec;
+        static const int W = 8;
+
+        static Vec Set1(float x)                { return _mm256_set1_ps(x); }
+        static Vec LoadU(const float* p)        { return _mm256_loadu_ps(p); }
+        static void StoreU(float* p, Vec v)     { _mm256_storeu_ps(p, v); }
+        static Vec Add(Vec a, Vec b)            { return _mm256_add_ps(a, b); }
+        static Vec Sub(Vec a, Vec b)            { return _mm256_sub_ps(a, b); }
+        static Vec Mul(Vec a, Vec b)            { return _mm256_mul_ps(a, b); }
+        static Vec Max(Vec a, Vec b)            { return _mm256_max_ps(a, b); }
+        static Vec Min(Vec a, Vec b)            { return _mm256_min_ps(a, b); }
+
+        static Vec Round(Vec a)
+        {
+            return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+
+        static Vec SelectEq(Vec a, Vec b, Vec ifEq, Vec ifNe)
+        {
+            return _mm256_blendv_ps(ifNe, ifEq, _mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+        }
+
+        static Vec SelectLt(Vec a, Vec b, Vec ifLt, Vec ifGe)
+        {
+            return _mm256_blendv_ps(ifGe, ifLt, _mm256_cmp_ps(a, b, _CMP_LT_OQ));
+        }
+
+        static Vec Gather(const float* base, Vec n)
+        {
+            return _mm256_i32gather_ps(base, _mm256_cvttps_epi32(n), 4);
+        }
+
+        template<typename M>
+        static Vec Get(const M& m, int i, int j)
+        {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(m.Get4(i, j)),
+                                        m.Get4(i + 4, j), 1);
+        }
+    };
+}
+
+}}
+
+#include <ConsensusCore/Quiver/detail/WideKernels-inl.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+#define DEFINE_WIDE_KERNELS(M, C)                                       \
+    WIDE_KERNEL_SPECIALIZATION(FillAlphaAvx2, M, C)                    \
+    {                                                                   \
+        if (recursor.MovesAvailable() & MERGE)                          \
+            WideFillAlpha<Avx2, true>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        else                                                            \
+            WideFillAlpha<Avx2, false>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        return true;                                                    \
+    }                                                                   \
+    WIDE_KERNEL_SPECIALIZATION(FillBetaAvx2, M, C)                     \
+    {                                                                   \
+        if (recursor.MovesAvailable() & MERGE)                          \
+            WideFillBeta<Avx2, true>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        else                                                            \
+            WideFillBeta<Avx2, false>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        return true;                                                    \
+    }
+
+    DEFINE_WIDE_KERNELS(DenseMatrix,  ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, SumProductCombiner)
+
+#undef DEFINE_WIDE_KERNELS
+}}
+
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+
+#else  // !CONSENSUSCORE_WIDE_KERNELS
+
+namespace ConsensusCore {
+namespace detail {
+
+#define DEFINE_WIDE_KERNELS(M, C)                                       \
+    WIDE_KERNEL_SPECIALIZATION(FillAlphaAvx2, M, C) { return false; }  \
+    WIDE_KERNEL_SPECIALIZATION(FillBetaAvx2, M, C)  { return false; }
+
+    DEFINE_WIDE_KERNELS(DenseMatrix,  ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, SumProductCombiner)
+
+#undef DEFINE_WIDE_KERNELS
+}}
+
+#endif  // CONSENSUSCORE_WIDE_KERNELS
@@ -0,0 +1,180 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+//
+// AVX-512 kernels for SseRecursor; see detail/WideKernels.hpp.  All
+// headers are included before the target pragma, so that only the
+// code below---and not any inline or template code shared with the
+// rest of the library---is compiled for AVX-512.
+//
+
+// GCC's AVX-512 intrinsics trip this on their own _mm512_undefined_*
+// placeholders.
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <ConsensusCore/Matrix/DenseMatrix.hpp>
+#include <ConsensusCore/Matrix/SparseMatrix.hpp>
+#include <ConsensusCore/Quiver/QvEvaluator.hpp>
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
+#include <ConsensusCore/Quiver/detail/Combiner.hpp>
+#include <ConsensusCore/Quiver/detail/RecursorBase.hpp>
+#include <ConsensusCore/Quiver/detail/WideKernels.hpp>
+
+#include <cfloat>
+#include <immintrin.h>
+
+#if CONSENSUSCORE_WIDE_KERNELS
+
+// No fused multiply-adds: the kernels must round exactly as SSE3's do,
+// else the banding cutoffs, and so the cells filled, could differ.
+#if defined(__clang__)
+#  pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#  pragma STDC FP_CONTRACT OFF
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx512f")
+#  pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace ConsensusCore {
+namespace detail {
+
+namespace {
+    // Vector traits for WideKernels-inl.hpp: 16 floats
+    struct Avx512
+    {
+        typedef __m512 Vec;
+        static const int W = 16;
+
+        static Vec Set1(float x)                { return _mm512_set1_ps(x); }
+        static Vec LoadU(const float* p)        { return _mm512_loadu_ps(p); }
+        static void StoreU(float* p, Vec v)     { _mm512_storeu_ps(p, v); }
+        static Vec Add(Vec a, Vec b)            { return _mm512_add_ps(a, b); }
+        static Vec Sub(Vec a, Vec b)            { return _mm512_sub_ps(a, b); }
+        static Vec Mul(Vec a, Vec b)            { return _mm512_mul_ps(a, b); }
+        static Vec Max(Vec a, Vec b)            { return _mm512_max_ps(a, b); }
+        static Vec Min(Vec a, Vec b)            { return _mm512_min_ps(a, b); }
+
+        static Vec Round(Vec a)
+        {
+            return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+
+        static Vec SelectEq(Vec a, Vec b, Vec ifEq, Vec ifNe)
+        {
+            return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ), ifNe, ifEq);
+        }
+
+        static Vec SelectLt(Vec a, Vec b, Vec ifLt, Vec ifGe)
+        {
+            return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), ifGe, ifLt);
+        }
+
+        static Vec Gather(const float* base, Vec n)
+        {
+            return _mm512_i32gather_ps(_mm512_cvttps_epi32(n), base, 4);
+        }
+
+        template<typename M>
+        static Vec Get(const M& m, int i, int j)
+        {
+            Vec v = _mm512_castps128_ps512(m.Get4(i, j));
+            v = _mm512_insertf32x4(v, m.Get4(i + 4,  j), 1);
+            v = _mm512_insertf32x4(v, m.Get4(i + 8,  j), 2);
+            return _mm512_insertf32x4(v, m.Get4(i + 12, j), 3);
+        }
+
+    };
+}
+
+}}
+
+#include <ConsensusCore/Quiver/detail/WideKernels-inl.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+#define DEFINE_WIDE_KERNELS(M, C)                                       \
+    WIDE_KERNEL_SPECIALIZATION(FillAlphaAvx512, M, C)                    \
+    {                                                                   \
+        if (recursor.MovesAvailable() & MERGE)                          \
+            WideFillAlpha<Avx512, true>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        else                                                            \
+            WideFillAlpha<Avx512, false>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        return true;                                                    \
+    }                                                                   \
+    WIDE_KERNEL_SPECIALIZATION(FillBetaAvx512, M, C)                     \
+    {                                                                   \
+        if (recursor.MovesAvailable() & MERGE)                          \
+            WideFillBeta<Avx512, true>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        else                                                            \
+            WideFillBeta<Avx512, false>(recursor, e, guide, matrix, beginColumn, endColumn); \
+        return true;                                                    \
+    }
+
+    DEFINE_WIDE_KERNELS(DenseMatrix,  ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, SumProductCombiner)
+
+#undef DEFINE_WIDE_KERNELS
+}}
+
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+
+#else  // !CONSENSUSCORE_WIDE_KERNELS
+
+namespace ConsensusCore {
+namespace detail {
+
+#define DEFINE_WIDE_KERNELS(M, C)                                       \
+    WIDE_KERNEL_SPECIALIZATION(FillAlphaAvx512, M, C) { return false; }  \
+    WIDE_KERNEL_SPECIALIZATION(FillBetaAvx512, M, C)  { return false; }
+
+    DEFINE_WIDE_KERNELS(DenseMatrix,  ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, ViterbiCombiner)
+    DEFINE_WIDE_KERNELS(SparseMatrix, SumProductCombiner)
+
+#undef DEFINE_WIDE_KERNELS
+}}
+
+#endif  // CONSENSUSCORE_WIDE_KERNELS
@@ -0,0 +1,93 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/Quiver/detail/QvMoveTables.hpp>
+
+#include <cfloat>
+
+namespace ConsensusCore {
+namespace detail {
+
+    // The scores are computed exactly as QvEvaluator computes them
+    // (same float operations), so either path gives identical results.
+    QvMoveTables::QvMoveTables(const QvSequenceFeatures& features,
+                               const QvModelParams& params,
+                               bool pinStart,
+                               bool pinEnd)
+        : stride_((features.Length() + 1 + 3) & ~3),
+          scores_(NUM_SLOTS * NUM_MOVES * stride_, 0.0f)
+    {
+        static const char bases[NUM_SLOTS] = { 'A', 'C', 'G', 'T' };
+
+        int I = features.Length();
+        for (int slot = 0; slot < NUM_SLOTS; slot++)
+        {
+            float tplBase = bases[slot];
+            float* inc   = &scores_[(slot * NUM_MOVES + INC)   * stride_];
+            float* del   = &scores_[(slot * NUM_MOVES + DEL)   * stride_];
+            float* extra = &scores_[(slot * NUM_MOVES + EXTRA) * stride_];
+            float* merge = &scores_[(slot * NUM_MOVES + MERGE) * stride_];
+
+            for (int i = 0; i < I; i++)
+            {
+                bool isMatch = (features.SequenceAsFloat[i] == tplBase);
+                inc[i] = isMatch ?
+                    params.Match :
+                    params.Mismatch + params.MismatchS * features.SubsQv[i];
+                extra[i] = isMatch ?
+                    params.Branch + params.BranchS * features.InsQv[i] :
+                    params.Nce + params.NceS * features.InsQv[i];
+                merge[i] = isMatch ?
+                    params.Merge[slot] + params.MergeS[slot] * features.MergeQv[i] :
+                    -FLT_MAX;
+            }
+            for (int i = 0; i <= I; i++)
+            {
+                if ((!pinStart && i == 0) || (!pinEnd && i == I))
+                {
+                    del[i] = 0.0f;
+                }
+                else
+                {
+                    del[i] = (i < I && tplBase == features.DelTag[i]) ?
+                        params.DeletionWithTag + params.DeletionWithTagS * features.DelQv[i] :
+                        params.DeletionN;
+                }
+            }
+        }
+    }
+}}
@@ -59,6 +59,10 @@
 #define MAX_FLIP_FLOPS                  5
 #define ALPHA_BETA_MISMATCH_TOLERANCE   0.2
 #define REBANDING_THRESHOLD             0.04
+#define REFILL_CONVERGENCE_TOLERANCE    0.001
+#define GUIDE_BAND_HALF_WIDTH           4
+#define ESCALATION_INITIAL_PADDING      8
+#define MAX_ESCALATIONS                 4
 
 using std::max;
 using std::min;
@@ -67,6 +71,22 @@ using std::min;
 namespace ConsensusCore {
 namespace detail {
 
+    //
+    // Make column j of guide a flat band over rows [beginRow, endRow):
+    // RangeGuide keeps every row of a flat column, so a fill guided by
+    // it covers at least those rows.
+    //
+    template<typename M>
+    static void SetGuideColumn(M& guide, int j, int beginRow, int endRow)
+    {
+        guide.StartEditingColumn(j, beginRow, endRow);
+        for (int i = beginRow; i < endRow; i++)
+        {
+            guide.Set(i, j, 0.0f);
+        }
+        guide.FinishEditingColumn(j, beginRow, endRow);
+    }
+
     template<typename M, typename E, typename C>
     int
     RecursorBase<M, E, C>::FillAlphaBeta(const E& e, M& a, M& b) const
@@ -74,7 +94,37 @@ namespace detail {
     {
         FillAlpha(e, M::Null(), a);
         FillBeta(e, a, b);
+        return FinishFillAlphaBeta(e, a, b);
+    }
 
+    template<typename M, typename E, typename C>
+    int
+    RecursorBase<M, E, C>::FillAlphaBeta(const E& e, const std::vector<int>& guidePath,
+                                         M& a, M& b) const
+        throw(AlphaBetaMismatchException)
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+        assert(static_cast<int>(guidePath.size()) == J + 1);
+
+        M guide(I + 1, J + 1);
+        for (int j = 0; j <= J; j++)
+        {
+            int i = min(max(guidePath[j], 0), I);
+            SetGuideColumn(guide, j,
+                           max(0, i - GUIDE_BAND_HALF_WIDTH),
+                           min(I + 1, i + GUIDE_BAND_HALF_WIDTH + 1));
+        }
+        FillAlpha(e, guide, a);
+        FillBeta(e, a, b);
+        return FinishFillAlphaBeta(e, a, b);
+    }
+
+    template<typename M, typename E, typename C>
+    int
+    RecursorBase<M, E, C>::FinishFillAlphaBeta(const E& e, M& a, M& b) const
+        throw(AlphaBetaMismatchException)
+    {
         int I = e.ReadLength();
         int J = e.TemplateLength();
         int flipflops = 0;
@@ -105,6 +155,28 @@ namespace detail {
             flipflops++;
         }
 
+        //
+        // Still no agreement: rather than give up on the read, widen
+        // the band---to the rows either matrix used, padded by a
+        // margin that doubles each round---and fill both again.
+        //
+        for (int k = 0, padding = ESCALATION_INITIAL_PADDING;
+             fabs(a(I, J) - b(0, 0)) > ALPHA_BETA_MISMATCH_TOLERANCE && k < MAX_ESCALATIONS;
+             k++, padding *= 2)
+        {
+            M guide(I + 1, J + 1);
+            for (int j = 0; j <= J; j++)
+            {
+                Interval used = RangeUnion(a.UsedRowRange(j), b.UsedRowRange(j));
+                SetGuideColumn(guide, j,
+                               max(0, used.Begin - padding),
+                               min(I + 1, used.End + padding));
+            }
+            FillAlpha(e, guide, a);
+            FillBeta(e, guide, b);
+            flipflops += 2;
+        }
+
         if (fabs(a(I, J) - b(0, 0)) > ALPHA_BETA_MISMATCH_TOLERANCE)
         {
             LDEBUG << "Could not mate alpha, beta.  Read: "
@@ -115,6 +187,92 @@ namespace detail {
         return flipflops;
     }
 
+    template<typename M, typename E, typename C>
+    int
+    RecursorBase<M, E, C>::RefillAlphaBeta(const E& e,
+                                           const M& oldAlpha, const M& oldBeta,
+                                           int editBegin, int editEnd,
+                                           M& a, M& b) const
+        throw(AlphaBetaMismatchException)
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+        int oldJ = oldAlpha.Columns() - 1;
+        int lengthDiff = J - oldJ;
+
+        assert(a.Rows() == I + 1 && a.Columns() == J + 1);
+        assert(oldAlpha.Rows() == I + 1 && oldBeta.Columns() == oldJ + 1);
+        assert(0 <= editBegin && editBegin <= editEnd && editEnd <= oldJ);
+
+        //
+        // Alpha column j depends on template positions j-2..j, so
+        // columns left of editBegin are unchanged.  Right of the edit,
+        // once two successive recomputed columns match the old
+        // (shifted) ones up to a common log-space offset, the
+        // remainder is the old matrix plus that offset.
+        //
+        float offset = 0.0f, prevOffset = 0.0f;
+        bool prevAgrees = false;
+        for (int j = 0; j < editBegin; j++)
+        {
+            CopyColumn(oldAlpha, j, a, j);
+        }
+        int j;
+        for (j = editBegin; j <= J; j++)
+        {
+            FillAlpha(e, M::Null(), a, j, j + 1);
+            bool agrees = (j - lengthDiff > editEnd &&
+                           ColumnsAgree(a, j, oldAlpha, j - lengthDiff,
+                                        REFILL_CONVERGENCE_TOLERANCE, &offset));
+            if (agrees && prevAgrees &&
+                fabs(offset - prevOffset) <= REFILL_CONVERGENCE_TOLERANCE)
+            {
+                break;
+            }
+            prevAgrees = agrees;
+            prevOffset = offset;
+        }
+        for (int jj = j + 1; jj <= J; jj++)
+        {
+            CopyColumn(oldAlpha, jj - lengthDiff, a, jj, offset);
+        }
+
+        //
+        // Beta column j depends on template positions j, j+1: the
+        // mirror image of the above.
+        //
+        for (j = J; j >= editEnd + lengthDiff; j--)
+        {
+            CopyColumn(oldBeta, j - lengthDiff, b, j);
+        }
+        prevAgrees = false;
+        for (; j >= 0; j--)
+        {
+            FillBeta(e, a, b, j, j + 1);
+            bool agrees = (j + 1 < editBegin &&
+                           ColumnsAgree(b, j, oldBeta, j,
+                                        REFILL_CONVERGENCE_TOLERANCE, &offset));
+            if (agrees && prevAgrees &&
+                fabs(offset - prevOffset) <= REFILL_CONVERGENCE_TOLERANCE)
+            {
+                break;
+            }
+            prevAgrees = agrees;
+            prevOffset = offset;
+        }
+        for (int jj = j - 1; jj >= 0; jj--)
+        {
+            CopyColumn(oldBeta, jj, b, jj, offset);
+        }
+
+        if (fabs(a(I, J) - b(0, 0)) > ALPHA_BETA_MISMATCH_TOLERANCE)
+        {
+            // Start over from scratch, with flip-flops
+            return FillAlphaBeta(e, a, b);
+        }
+        return 0;
+    }
+
     struct MoveSpec {
         Move MoveType;
         int ReadDelta;
@@ -0,0 +1,313 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/Quiver/detail/SseMath.hpp>
+
+namespace ConsensusCore {
+namespace detail {
+
+    //
+    // Taylor coefficients of f(d) = log(1 + exp(-d)) at d = k/16,
+    // k = 0..256:  { f, f', f''/2, f'''/6 }.  With s = 1/(1 + exp(d)),
+    //
+    //    f'   = -s
+    //    f''  =  s (1 - s)
+    //    f''' = -s (1 - s) (1 - 2s)
+    //
+    // (computed in double precision and rounded to float).
+    //
+    ALIGN16_BEG const float LOG_ADD_TABLE[LOG_ADD_TABLE_SIZE][4] ALIGN16_END =
+    {
+        { 0.693147181f, -0.5f, 0.125f, 0.0f },  // 0
+        { 0.662385382f, -0.484380084f, 0.124878009f, -0.00130038932f },  // 0.0625
+        { 0.632599035f, -0.468790627f, 0.124512988f, -0.00259064821f },  // 0.125
+        { 0.60378529f, -0.453261848f, 0.123907773f, -0.00386081354f },  // 0.1875
+        { 0.57593942f, -0.437823499f, 0.123067041f, -0.005101252f },  // 0.25
+        { 0.549054862f, -0.422504635f, 0.121997234f, -0.00630281348f },  // 0.3125
+        { 0.523123264f, -0.4073334f, 0.120706451f, -0.00745697091f },  // 0.375
+        { 0.498134548f, -0.39233683f, 0.119204321f, -0.00855594337f },  // 0.4375
+        { 0.474076984f, -0.377540669f, 0.117501856f, -0.00959279914f },  // 0.5
+        { 0.450937282f, -0.362969206f, 0.115611281f, -0.0105615371f },  // 0.5625
+        { 0.428700678f, -0.348645135f, 0.113545852f, -0.0114571448f },  // 0.625
+        { 0.407351047f, -0.334589441f, 0.111319674f, -0.0122756329f },  // 0.6875
+        { 0.386871006f, -0.320821301f, 0.108947497f, -0.0130140472f },  // 0.75
+        { 0.367242032f, -0.307358017f, 0.106444533f, -0.0136704573f },  // 0.8125
+        { 0.348444581f, -0.294214972f, 0.103826261f, -0.0142439267f },  // 0.875
+        { 0.330458208f, -0.281405607f, 0.101108246f, -0.0147344637f },  // 0.9375
+        { 0.313261688f, -0.268941421f, 0.0983059666f, -0.0151429579f },  // 1
+        { 0.296833138f, -0.256831991f, 0.0954346598f, -0.0154711041f },  // 1.0625
+        { 0.281150136f, -0.245085013f, 0.0925091747f, -0.0157213167f },  // 1.125
+        { 0.266189837f, -0.233706357f, 0.0895438478f, -0.0158966383f },  // 1.1875
+        { 0.251929081f, -0.222700139f, 0.0865523935f, -0.0160006445f },  // 1.25
+        { 0.238344508f, -0.212068804f, 0.0835478133f, -0.0160373478f },  // 1.3125
+        { 0.225412652f, -0.201813222f, 0.0805423228f, -0.0160111038f },  // 1.375
+        { 0.213110039f, -0.191932786f, 0.077547296f, -0.0159265196f },  // 1.4375
+        { 0.201413278f, -0.182425524f, 0.074573226f, -0.0157883688f },  // 1.5
+        { 0.19029914f, -0.173288206f, 0.0716297018f, -0.0156015123f },  // 1.5625
+        { 0.179744635f, -0.164516463f, 0.0687253982f, -0.0153708264f },  // 1.625
+        { 0.169727078f, -0.156104897f, 0.0658680792f, -0.0151011399f },  // 1.6875
+        { 0.16022415f, -0.148047198f, 0.0630646126f, -0.0147971781f },  // 1.75
+        { 0.151213954f, -0.140336249f, 0.0603209933f, -0.0144635165f },  // 1.8125
+        { 0.142675058f, -0.13296424f, 0.0576423755f, -0.0141045421f },  // 1.875
+        { 0.134586537f, -0.125922765f, 0.0550331111f, -0.0137244227f },  // 1.9375
+        { 0.126928011f, -0.119202922f, 0.0524967927f, -0.0133270835f },  // 2
+        { 0.119679665f, -0.112795406f, 0.0500363013f, -0.0129161905f },  // 2.0625
+        { 0.112822279f, -0.106690594f, 0.0476538556f, -0.0124951397f },  // 2.125
+        { 0.10633724f, -0.100878623f, 0.0453510631f, -0.0120670525f },  // 2.1875
+        { 0.100206559f, -0.0953494649f, 0.0431289722f, -0.0116347745f },  // 2.25
+        { 0.0944128759f, -0.090092994f, 0.0409881232f, -0.0112008792f },  // 2.3125
+        { 0.0889394655f, -0.085099045f, 0.0389285988f, -0.0107676752f },  // 2.375
+        { 0.0837702375f, -0.0803574688f, 0.036950073f, -0.0103372148f },  // 2.4375
+        { 0.0788897343f, -0.07585818f, 0.0350518583f, -0.00991130597f },  // 2.5
+        { 0.0742831254f, -0.0715911994f, 0.0332329498f, -0.00949152544f },  // 2.5625
+        { 0.0699361996f, -0.0675466911f, 0.0314920678f, -0.00907923262f },  // 2.625
+        { 0.0658353555f, -0.0637149943f, 0.0298276969f, -0.0086755846f },  // 2.6875
+        { 0.061967589f, -0.0600866502f, 0.0282381223f, -0.00828155132f },  // 2.75
+        { 0.0583204803f, -0.0566524253f, 0.026721464f, -0.00789793084f },  // 2.8125
+        { 0.0548821792f, -0.0534033298f, 0.0252757071f, -0.00752536441f },  // 2.875
+        { 0.0516413893f, -0.0503306326f, 0.02389873f, -0.0071643512f },  // 2.9375
+        { 0.0485873516f, -0.0474258732f, 0.0225883299f, -0.00681526244f },  // 3
+        { 0.0457098271f, -0.0446808703f, 0.0213422451f, -0.00647835496f },  // 3.0625
+        { 0.0429990792f, -0.0420877279f, 0.0201581755f, -0.00615378397f },  // 3.125
+        { 0.040445856f, -0.0396388391f, 0.0190338008f, -0.00584161508f },  // 3.1875
+        { 0.0380413717f, -0.0373268873f, 0.0179667954f, -0.00554183544f },  // 3.25
+        { 0.0357772888f, -0.0351448464f, 0.0169548431f, -0.00525436412f },  // 3.3125
+        { 0.0336457f, -0.0330859784f, 0.0159956482f, -0.00497906162f },  // 3.375
+        { 0.03163911f, -0.0311438305f, 0.0150869462f, -0.00471573853f },  // 3.4375
+        { 0.0297504183f, -0.0293122308f, 0.0142265119f, -0.00446416345f },  // 3.5
+        { 0.0279729011f, -0.0275852822f, 0.0134121672f, -0.00422407013f },  // 3.5625
+        { 0.0263001952f, -0.0259573572f, 0.0126417864f, -0.00399516389f },  // 3.625
+        { 0.0247262805f, -0.0244230901f, 0.0119133014f, -0.00377712737f },  // 3.6875
+        { 0.0232454644f, -0.0229773699f, 0.0112247052f, -0.00356962559f },  // 3.75
+        { 0.021852366f, -0.0216153328f, 0.0105740551f, -0.00337231055f },  // 3.8125
+        { 0.0205419009f, -0.0203323533f, 0.00995947438f, -0.00318482509f },  // 3.875
+        { 0.0193092665f, -0.0191240368f, 0.00937915398f, -0.00300680647f },  // 3.9375
+        { 0.0181499279f, -0.01798621f, 0.00883135311f, -0.00283788932f },  // 4
+        { 0.0170596044f, -0.0169149133f, 0.00831439949f, -0.00267770827f },  // 4.0625
+        { 0.0160342561f, -0.0159063917f, 0.00782668921f, -0.00252590015f },  // 4.125
+        { 0.0150700718f, -0.0149570866f, 0.00736668608f, -0.00238210592f },  // 4.1875
+        { 0.0141634569f, -0.014063627f, 0.00693292072f, -0.00224597223f },  // 4.25
+        { 0.0133110216f, -0.0132228218f, 0.00652398937f, -0.00211715276f },  // 4.3125
+        { 0.0125095703f, -0.0124316509f, 0.00613855246f, -0.00199530926f },  // 4.375
+        { 0.0117560908f, -0.011687258f, 0.005775333f, -0.00188011246f },  // 4.4375
+        { 0.0110477448f, -0.0109869426f, 0.00543311486f, -0.00177124274f },  // 4.5
+        { 0.010381858f, -0.0103281525f, 0.00511074089f, -0.00166839062f },  // 4.5625
+        { 0.009755911f, -0.00970847648f, 0.00480711098f, -0.00157125718f },  // 4.625
+        { 0.00916753108f, -0.00912563739f, 0.00452118007f, -0.00147955426f },  // 4.6875
+        { 0.00861448376f, -0.00857748541f, 0.00425195608f, -0.00139300463f },  // 4.75
+        { 0.00809466511f, -0.00806199153f, 0.00399849791f, -0.00131134207f },  // 4.8125
+        { 0.0076060944f, -0.00757724127f, 0.00375991334f, -0.00123431127f },  // 4.875
+        { 0.00714690715f, -0.00712142875f, 0.003535357f, -0.0011616678f },  // 4.9375
+        { 0.00671534849f, -0.00669285092f, 0.00332402834f, -0.00109317796f },  // 5
+        { 0.00630976691f, -0.00628990214f, 0.00312516963f, -0.00102861854f },  // 5.0625
+        { 0.00592860838f, -0.00591106886f, 0.00293806406f, -0.000967776621f },  // 5.125
+        { 0.00557041067f, -0.0055549247f, 0.00276203376f, -0.000910449326f },  // 5.1875
+        { 0.00523379815f, -0.00522012569f, 0.00259643799f, -0.000856443508f },  // 5.25
+        { 0.0049174767f, -0.00490540571f, 0.00244067135f, -0.000805575461f },  // 5.3125
+        { 0.00462022902f, -0.00460957218f, 0.00229416201f, -0.0007576706f },  // 5.375
+        { 0.00434091015f, -0.00433150202f, 0.00215637006f, -0.000712563138f },  // 5.4375
+        { 0.00407844327f, -0.00407013772f, 0.00202678585f, -0.000670095751f },  // 5.5
+        { 0.00383181568f, -0.00382448364f, 0.00190492848f, -0.00063011925f },  // 5.5625
+        { 0.00360007508f, -0.00359360258f, 0.0017903443f, -0.000592492243f },  // 5.625
+        { 0.003382326f, -0.00337661238f, 0.00168260544f, -0.000557080808f },  // 5.6875
+        { 0.00317772647f, -0.00317268284f, 0.00158130846f, -0.000523758161f },  // 5.75
+        { 0.00298548486f, -0.00298103273f, 0.00148607309f, -0.000492404341f },  // 5.8125
+        { 0.0028048569f, -0.00280092697f, 0.00139654089f, -0.00046290589f },  // 5.875
+        { 0.00263514292f, -0.00263167397f, 0.00131237413f, -0.000435155551f },  // 5.9375
+        { 0.00247568514f, -0.00247262316f, 0.00123325465f, -0.000409051966f },  // 6
+        { 0.00232586525f, -0.00232316252f, 0.00115888272f, -0.000384499391f },  // 6.0625
+        { 0.00218510204f, -0.00218271645f, 0.0010889761f, -0.000361407415f },  // 6.125
+        { 0.00205284919f, -0.00205074354f, 0.001023269f, -0.00033969069f },  // 6.1875
+        { 0.0019285932f, -0.00192673466f, 0.000961511178f, -0.000319268675f },  // 6.25
+        { 0.00181185144f, -0.00181021103f, 0.000903467081f, -0.000300065383f },  // 6.3125
+        { 0.00170217028f, -0.00170072241f, 0.000848914977f, -0.000282009147f },  // 6.375
+        { 0.00159912341f, -0.00159784549f, 0.000797646192f, -0.000265032387f },  // 6.4375
+        { 0.00150231016f, -0.00150118226f, 0.000749464354f, -0.000249071396f },  // 6.5
+        { 0.00141135399f, -0.0014103585f, 0.000704184693f, -0.000234066129f },  // 6.5625
+        { 0.00132590104f, -0.00132502242f, 0.000661633366f, -0.000219960003f },  // 6.625
+        { 0.00124561876f, -0.0012448433f, 0.000621646834f, -0.000206699709f },  // 6.6875
+        { 0.00117019468f, -0.00116951027f, 0.000584071255f, -0.000194235034f },  // 6.75
+        { 0.00109933512f, -0.00109873107f, 0.000548761931f, -0.000182518683f },  // 6.8125
+        { 0.00103276415f, -0.00103223104f, 0.000515582768f, -0.000171506122f },  // 6.875
+        { 0.000970222481f, -0.000969751968f, 0.000484405774f, -0.000161155423f },  // 6.9375
+        { 0.000911466454f, -0.000911051194f, 0.00045511059f, -0.000151427111f },  // 7
+        { 0.000856267129f, -0.000855900637f, 0.000427584035f, -0.000142284032f },  // 7.0625
+        { 0.000804409386f, -0.000804085936f, 0.000401719691f, -0.000133691219f },  // 7.125
+        { 0.000755691095f, -0.000755405633f, 0.000377417498f, -0.000125615764f },  // 7.1875
+        { 0.000709922334f, -0.000709670399f, 0.000354583384f, -0.000118026703f },  // 7.25
+        { 0.000666924654f, -0.000666702309f, 0.000333128909f, -0.000110894904f },  // 7.3125
+        { 0.000626530387f, -0.000626334158f, 0.000312970932f, -0.000104192961f },  // 7.375
+        { 0.000588581999f, -0.000588408819f, 0.000294031297f, -9.78950919e-05f },  // 7.4375
+        { 0.000552931475f, -0.000552778637f, 0.000276236536f, -9.1977047e-05f },  // 7.5
+        { 0.00051943975f, -0.000519304864f, 0.000259517593f, -8.64160187e-05f },  // 7.5625
+        { 0.000487976164f, -0.000487857123f, 0.000243809559f, -8.11905569e-05f },  // 7.625
+        { 0.000458417958f, -0.000458312901f, 0.000229051425f, -7.62804902e-05f },  // 7.6875
+        { 0.000430649798f, -0.000430557081f, 0.000215185851f, -7.16668505e-05f },  // 7.75
+        { 0.000404563323f, -0.000404481498f, 0.000202158946f, -6.73318024e-05f },  // 7.8125
+        { 0.000380056727f, -0.000379984515f, 0.000189920063f, -6.32585766e-05f },  // 7.875
+        { 0.000357034364f, -0.000356970635f, 0.000178421604f, -5.9431407e-05f },  // 7.9375
+        { 0.000335406373f, -0.00033535013f, 0.000167618835f, -5.58354711e-05f },  // 8
+        { 0.000315088329f, -0.000315038694f, 0.000157469722f, -5.24568347e-05f },  // 8.0625
+        { 0.000296000917f, -0.000295957114f, 0.000147934761f, -4.92823989e-05f },  // 8.125
+        { 0.000278069622f, -0.000278030964f, 0.000138976831f, -4.62998505e-05f },  // 8.1875
+        { 0.000261224435f, -0.000261190319f, 0.000130561049f, -4.34976156e-05f },  // 8.25
+        { 0.000245399589f, -0.000245369481f, 0.000122654637f, -4.08648153e-05f },  // 8.3125
+        { 0.000230533293f, -0.000230506722f, 0.000115226794f, -3.83912244e-05f },  // 8.375
+        { 0.000216567499f, -0.00021654405f, 0.000108248579f, -3.60672327e-05f },  // 8.4375
+        { 0.000203447672f, -0.000203426978f, 0.000101692798f, -3.38838079e-05f },  // 8.5
+        { 0.000191122579f, -0.000191104316f, 9.55338975e-05f, -3.18324612e-05f },  // 8.5625
+        { 0.000179544086f, -0.000179527969f, 8.97478695e-05f, -2.9905215e-05f },  // 8.625
+        { 0.000168666977f, -0.000168652754f, 8.43121551e-05f, -2.80945721e-05f },  // 8.6875
+        { 0.000158448771f, -0.000158436219f, 7.92055585e-05f, -2.63934868e-05f },  // 8.75
+        { 0.00014884956f, -0.000148838483f, 7.44081648e-05f, -2.47953384e-05f },  // 8.8125
+        { 0.000139831852f, -0.000139822076f, 6.99012627e-05f, -2.32939051e-05f },  // 8.875
+        { 0.000131360424f, -0.000131351797f, 6.56672719e-05f, -2.18833403e-05f },  // 8.9375
+        { 0.00012340219f, -0.000123394576f, 6.16896749e-05f, -2.05581502e-05f },  // 9
+        { 0.000115926062f, -0.000115919343f, 5.79529529e-05f, -1.93131724e-05f },  // 9.0625
+        { 0.00010890284f, -0.00010889691f, 5.44425257e-05f, -1.81435562e-05f },  // 9.125
+        { 0.000102305088f, -0.000102299855f, 5.11446947e-05f, -1.70447435e-05f },  // 9.1875
+        { 9.61070336e-05f, -9.61024155e-05f, 4.80465899e-05f, -1.60124517e-05f },  // 9.25
+        { 9.02844657e-05f, -9.02803902e-05f, 4.51361198e-05f, -1.50426567e-05f },  // 9.3125
+        { 8.48146384e-05f, -8.48110417e-05f, 4.24019244e-05f, -1.41315774e-05f },  // 9.375
+        { 7.96761839e-05f, -7.96730099e-05f, 3.9833331e-05f, -1.32756613e-05f },  // 9.4375
+        { 7.48490286e-05f, -7.48462275e-05f, 3.74203128e-05f, -1.24715704e-05f },  // 9.5
+        { 7.03143147e-05f, -7.03118427e-05f, 3.51534495e-05f, -1.17161687e-05f },  // 9.5625
+        { 6.60543264e-05f, -6.60521449e-05f, 3.3023891e-05f, -1.10065095e-05f },  // 9.625
+        { 6.20524212e-05f, -6.2050496e-05f, 3.10233229e-05f, -1.03398243e-05f },  // 9.6875
+        { 5.82929647e-05f, -5.82912657e-05f, 2.91439339e-05f, -9.71351207e-06f },  // 9.75
+        { 5.47612692e-05f, -5.47597698e-05f, 2.73783856e-05f, -9.12512904e-06f },  // 9.8125
+        { 5.14435369e-05f, -5.14422137e-05f, 2.57197837e-05f, -8.57237919e-06f },  // 9.875
+        { 4.83268059e-05f, -4.83256382e-05f, 2.41616514e-05f, -8.05310539e-06f },  // 9.9375
+        { 4.53988992e-05f, -4.53978687e-05f, 2.26979039e-05f, -7.565281e-06f },  // 10
+        { 4.26483776e-05f, -4.26474682e-05f, 2.13228247e-05f, -7.10700199e-06f },  // 10.0625
+        { 4.00644948e-05f, -4.00636922e-05f, 2.00310436e-05f, -6.67647951e-06f },  // 10.125
+        { 3.76371554e-05f, -3.76364472e-05f, 1.88175153e-05f, -6.27203296e-06f },  // 10.1875
+        { 3.53568758e-05f, -3.53562507e-05f, 1.76775003e-05f, -5.89208344e-06f },  // 10.25
+        { 3.32147466e-05f, -3.32141949e-05f, 1.66065459e-05f, -5.53514758e-06f },  // 10.3125
+        { 3.12023982e-05f, -3.12019114e-05f, 1.56004689e-05f, -5.1998318e-06f },  // 10.375
+        { 2.93119682e-05f, -2.93115386e-05f, 1.46553397e-05f, -4.88482685e-06f },  // 10.4375
+        { 2.75360702e-05f, -2.75356911e-05f, 1.37674665e-05f, -4.58890275e-06f },  // 10.5
+        { 2.58677656e-05f, -2.58674311e-05f, 1.2933381e-05f, -4.31090396e-06f },  // 10.5625
+        { 2.4300536e-05f, -2.43002407e-05f, 1.21498251e-05f, -4.04974488e-06f },  // 10.625
+        { 2.28282578e-05f, -2.28279972e-05f, 1.1413738e-05f, -3.80440564e-06f },  // 10.6875
+        { 2.14451784e-05f, -2.14449484e-05f, 1.07222443e-05f, -3.57392813e-06f },  // 10.75
+        { 2.01458938e-05f, -2.01456909e-05f, 1.00726425e-05f, -3.35741222e-06f },  // 10.8125
+        { 1.89253273e-05f, -1.89251482e-05f, 9.46239504e-06f, -3.1540123e-06f },  // 10.875
+        { 1.77787099e-05f, -1.77785519e-05f, 8.88911789e-06f, -2.96293394e-06f },  // 10.9375
+        { 1.67015613e-05f, -1.67014218e-05f, 8.35057146e-06f, -2.78343084e-06f },  // 11
+        { 1.56896728e-05f, -1.56895497e-05f, 7.84465178e-06f, -2.61480187e-06f },  // 11.0625
+        { 1.47390906e-05f, -1.4738982e-05f, 7.36938237e-06f, -2.45638838e-06f },  // 11.125
+        { 1.38461004e-05f, -1.38460046e-05f, 6.92290643e-06f, -2.30757157e-06f },  // 11.1875
+        { 1.30072131e-05f, -1.30071285e-05f, 6.50347964e-06f, -2.16777015e-06f },  // 11.25
+        { 1.22191507e-05f, -1.2219076e-05f, 6.10946336e-06f, -2.03643802e-06f },  // 11.3125
+        { 1.1478834e-05f, -1.14787681e-05f, 5.73931818e-06f, -1.91306214e-06f },  // 11.375
+        { 1.07833704e-05f, -1.07833122e-05f, 5.39159797e-06f, -1.79716056e-06f },  // 11.4375
+        { 1.01300423e-05f, -1.0129991e-05f, 5.06494418e-06f, -1.68828052e-06f },  // 11.5
+        { 9.51629697e-06f, -9.51625169e-06f, 4.75808057e-06f, -1.58599667e-06f },  // 11.5625
+        { 8.93973626e-06f, -8.9396963e-06f, 4.46980819e-06f, -1.48990943e-06f },  // 11.625
+        { 8.3981073e-06f, -8.39807203e-06f, 4.19900075e-06f, -1.39964341e-06f },  // 11.6875
+        { 7.88929371e-06f, -7.88926259e-06f, 3.94460017e-06f, -1.31484598e-06f },  // 11.75
+        { 7.41130734e-06f, -7.41127987e-06f, 3.70561247e-06f, -1.23518585e-06f },  // 11.8125
+        { 6.96228049e-06f, -6.96225625e-06f, 3.48110389e-06f, -1.16035181e-06f },  // 11.875
+        { 6.54045862e-06f, -6.54043723e-06f, 3.27019722e-06f, -1.09005148e-06f },  // 11.9375
+        { 6.14419348e-06f, -6.1441746e-06f, 3.07206843e-06f, -1.02401023e-06f },  // 12
+        { 5.77193669e-06f, -5.77192003e-06f, 2.88594336e-06f, -9.61970014e-07f },  // 12.0625
+        { 5.42223367e-06f, -5.42221897e-06f, 2.71109478e-06f, -9.03688461e-07f },  // 12.125
+        { 5.09371798e-06f, -5.093705e-06f, 2.54683953e-06f, -8.48937861e-07f },  // 12.1875
+        { 4.78510594e-06f, -4.78509449e-06f, 2.3925358e-06f, -7.97504301e-07f },  // 12.25
+        { 4.49519168e-06f, -4.49518158e-06f, 2.24758069e-06f, -7.49186826e-07f },  // 12.3125
+        { 4.22284236e-06f, -4.22283344e-06f, 2.11140781e-06f, -7.03796658e-07f },  // 12.375
+        { 3.96699378e-06f, -3.96698591e-06f, 1.98348509e-06f, -6.61156451e-07f },  // 12.4375
+        { 3.72664623e-06f, -3.72663928e-06f, 1.8633127e-06f, -6.21099603e-07f },  // 12.5
+        { 3.50086054e-06f, -3.50085441e-06f, 1.75042108e-06f, -5.83469608e-07f },  // 12.5625
+        { 3.28875447e-06f, -3.28874907e-06f, 1.64436912e-06f, -5.48119436e-07f },  // 12.625
+        { 3.08949922e-06f, -3.08949445e-06f, 1.54474245e-06f, -5.14910969e-07f },  // 12.6875
+        { 2.9023162e-06f, -2.90231199e-06f, 1.45115178e-06f, -4.83714453e-07f },  // 12.75
+        { 2.72647399e-06f, -2.72647027e-06f, 1.36323142e-06f, -4.54407995e-07f },  // 12.8125
+        { 2.56128549e-06f, -2.56128221e-06f, 1.28063783e-06f, -4.26877088e-07f },  // 12.875
+        { 2.40610523e-06f, -2.40610234e-06f, 1.20304828e-06f, -4.01014162e-07f },  // 12.9375
+        { 2.26032685e-06f, -2.2603243e-06f, 1.13015959e-06f, -3.76718162e-07f },  // 13
+        { 2.12338072e-06f, -2.12337846e-06f, 1.06168698e-06f, -3.53894156e-07f },  // 13.0625
+        { 1.99473171e-06f, -1.99472972e-06f, 9.97362871e-07f, -3.32452964e-07f },  // 13.125
+        { 1.87387714e-06f, -1.87387538e-06f, 9.36935936e-07f, -3.12310808e-07f },  // 13.1875
+        { 1.76034476e-06f, -1.76034321e-06f, 8.80170057e-07f, -2.93388986e-07f },  // 13.25
+        { 1.65369095e-06f, -1.65368959e-06f, 8.26843426e-07f, -2.75613564e-07f },  // 13.3125
+        { 1.55349896e-06f, -1.55349775e-06f, 7.76747671e-07f, -2.58915086e-07f },  // 13.375
+        { 1.45937729e-06f, -1.45937622e-06f, 7.29687046e-07f, -2.43228305e-07f },  // 13.4375
+        { 1.37095815e-06f, -1.37095721e-06f, 6.85477664e-07f, -2.28491928e-07f },  // 13.5
+        { 1.28789604e-06f, -1.28789522e-06f, 6.43946778e-07f, -2.14648373e-07f },  // 13.5625
+        { 1.20986642e-06f, -1.20986568e-06f, 6.0493211e-07f, -2.01643549e-07f },  // 13.625
+        { 1.13656436e-06f, -1.13656371e-06f, 5.68281209e-07f, -1.89426639e-07f },  // 13.6875
+        { 1.06770344e-06f, -1.06770287e-06f, 5.33850865e-07f, -1.77949908e-07f },  // 13.75
+        { 1.00301459e-06f, -1.00301409e-06f, 5.01506541e-07f, -1.67168512e-07f },  // 13.8125
+        { 9.42245038e-07f, -9.42244594e-07f, 4.71121853e-07f, -1.57040322e-07f },  // 13.875
+        { 8.85157322e-07f, -8.8515693e-07f, 4.42578073e-07f, -1.47525763e-07f },  // 13.9375
+        { 8.31528373e-07f, -8.31528028e-07f, 4.15763668e-07f, -1.38587659e-07f },  // 14
+        { 7.81148636e-07f, -7.81148331e-07f, 3.9057386e-07f, -1.30191083e-07f },  // 14.0625
+        { 7.3382125e-07f, -7.33820981e-07f, 3.66910221e-07f, -1.22303228e-07f },  // 14.125
+        { 6.89361283e-07f, -6.89361046e-07f, 3.44680285e-07f, -1.1489327e-07f },  // 14.1875
+        { 6.47595008e-07f, -6.47594798e-07f, 3.23797189e-07f, -1.07932257e-07f },  // 14.25
+        { 6.08359222e-07f, -6.08359037e-07f, 3.04179333e-07f, -1.01392988e-07f },  // 14.3125
+        { 5.7150061e-07f, -5.71500447e-07f, 2.8575006e-07f, -9.52499112e-08f },  // 14.375
+        { 5.36875148e-07f, -5.36875004e-07f, 2.68437358e-07f, -8.94790232e-08f },  // 14.4375
+        { 5.04347535e-07f, -5.04347408e-07f, 2.52173577e-07f, -8.40577742e-08f },  // 14.5
+        { 4.7379067e-07f, -4.73790558e-07f, 2.36895167e-07f, -7.89649808e-08f },  // 14.5625
+        { 4.45085151e-07f, -4.45085052e-07f, 2.22542427e-07f, -7.41807429e-08f },  // 14.625
+        { 4.18118811e-07f, -4.18118723e-07f, 2.09059274e-07f, -6.96863664e-08f },  // 14.6875
+        { 3.92786277e-07f, -3.927862e-07f, 1.96393023e-07f, -6.54642896e-08f },  // 14.75
+        { 3.68988564e-07f, -3.68988496e-07f, 1.8449418e-07f, -6.14980146e-08f },  // 14.8125
+        { 3.46632681e-07f, -3.46632621e-07f, 1.7331625e-07f, -5.77720434e-08f },  // 14.875
+        { 3.25631272e-07f, -3.25631219e-07f, 1.62815557e-07f, -5.42718168e-08f },  // 14.9375
+        { 3.05902274e-07f, -3.05902227e-07f, 1.52951067e-07f, -5.09836577e-08f },  // 15
+        { 2.87368595e-07f, -2.87368553e-07f, 1.43684235e-07f, -4.78947176e-08f },  // 15.0625
+        { 2.69957814e-07f, -2.69957777e-07f, 1.34978852e-07f, -4.49929265e-08f },  // 15.125
+        { 2.53601899e-07f, -2.53601867e-07f, 1.26800901e-07f, -4.22669456e-08f },  // 15.1875
+        { 2.38236938e-07f, -2.3823691e-07f, 1.19118427e-07f, -3.97061233e-08f },  // 15.25
+        { 2.23802894e-07f, -2.23802869e-07f, 1.11901409e-07f, -3.7300453e-08f },  // 15.3125
+        { 2.10243363e-07f, -2.10243341e-07f, 1.05121648e-07f, -3.50405347e-08f },  // 15.375
+        { 1.97505363e-07f, -1.97505343e-07f, 9.87526522e-08f, -3.29175377e-08f },  // 15.4375
+        { 1.85539119e-07f, -1.85539102e-07f, 9.27695337e-08f, -3.09231664e-08f },  // 15.5
+        { 1.74297873e-07f, -1.74297858e-07f, 8.71489138e-08f, -2.90496278e-08f },  // 15.5625
+        { 1.637377e-07f, -1.63737686e-07f, 8.18688297e-08f, -2.7289601e-08f },  // 15.625
+        { 1.53817335e-07f, -1.53817323e-07f, 7.69086496e-08f, -2.56362086e-08f },  // 15.6875
+        { 1.44498014e-07f, -1.44498004e-07f, 7.22489914e-08f, -2.40829902e-08f },  // 15.75
+        { 1.35743323e-07f, -1.35743313e-07f, 6.78716475e-08f, -2.26238764e-08f },  // 15.8125
+        { 1.27519051e-07f, -1.27519043e-07f, 6.37595133e-08f, -2.12531657e-08f },  // 15.875
+        { 1.19793063e-07f, -1.19793056e-07f, 5.98965206e-08f, -1.99655021e-08f },  // 15.9375
+        { 1.12535168e-07f, -1.12535162e-07f, 5.62675747e-08f, -1.8755854e-08f }   // 16
+    };
+}}
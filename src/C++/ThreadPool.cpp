@@ -0,0 +1,221 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <ConsensusCore/ThreadPool.hpp>
+
+#include <ConsensusCore/Types.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ConsensusCore {
+namespace detail {
+
+    ThreadPool::ThreadPool(int numThreads)
+        : numThreads_(std::max(1, numThreads)),
+          workers_(),
+          workerArgs_(),
+          task_(NULL),
+          n_(0),
+          generation_(0),
+          pendingWorkers_(0),
+          failed_(false),
+          shutdown_(false)
+    {
+        pthread_mutex_init(&mutex_, NULL);
+        pthread_cond_init(&workReady_, NULL);
+        pthread_cond_init(&workDone_, NULL);
+
+        // The calling thread runs chunk 0, so we only need T-1 workers.
+        // Arguments must be in place before any thread starts.
+        workerArgs_.resize(numThreads_ - 1);
+        workers_.resize(numThreads_ - 1);
+        for (int k = 0; k < numThreads_ - 1; k++)
+        {
+            workerArgs_[k].Pool  = this;
+            workerArgs_[k].Index = k + 1;
+        }
+        for (int k = 0; k < numThreads_ - 1; k++)
+        {
+            if (pthread_create(&workers_[k], NULL, &ThreadPool::WorkerEntry, &workerArgs_[k]) != 0)
+            {
+                // The destructor will not run, so the workers already
+                // started must be stopped here, before this goes away
+                StopWorkers(k);
+                pthread_cond_destroy(&workDone_);
+                pthread_cond_destroy(&workReady_);
+                pthread_mutex_destroy(&mutex_);
+                throw InternalError("Unable to start ThreadPool worker thread");
+            }
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        StopWorkers(workers_.size());
+
+        pthread_cond_destroy(&workDone_);
+        pthread_cond_destroy(&workReady_);
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    void
+    ThreadPool::StopWorkers(size_t numStarted)
+    {
+        pthread_mutex_lock(&mutex_);
+        shutdown_ = true;
+        pthread_cond_broadcast(&workReady_);
+        pthread_mutex_unlock(&mutex_);
+
+        for (size_t k = 0; k < numStarted; k++)
+        {
+            pthread_join(workers_[k], NULL);
+        }
+    }
+
+    int
+    ThreadPool::NumThreads() const
+    {
+        return numThreads_;
+    }
+
+    void
+    ThreadPool::RunChunk(int chunk)
+    {
+        // The first (n % T) chunks get one extra index
+        int q = n_ / numThreads_;
+        int r = n_ % numThreads_;
+        int begin = chunk * q + std::min(chunk, r);
+        int end   = begin + q + (chunk < r ? 1 : 0);
+        if (begin < end)
+        {
+            task_->Run(begin, end);
+        }
+    }
+
+    void
+    ThreadPool::ParallelFor(int n, ParallelTask& task)
+    {
+        if (n <= 0) return;
+
+        if (numThreads_ == 1)
+        {
+            task.Run(0, n);
+            return;
+        }
+
+        pthread_mutex_lock(&mutex_);
+        task_ = &task;
+        n_ = n;
+        failed_ = false;
+        pendingWorkers_ = numThreads_ - 1;
+        generation_++;
+        pthread_cond_broadcast(&workReady_);
+        pthread_mutex_unlock(&mutex_);
+
+        bool failedHere = false;
+        try
+        {
+            RunChunk(0);
+        }
+        catch (...)
+        {
+            failedHere = true;
+        }
+
+        pthread_mutex_lock(&mutex_);
+        while (pendingWorkers_ > 0)
+        {
+            pthread_cond_wait(&workDone_, &mutex_);
+        }
+        bool failed = failed_ || failedHere;
+        task_ = NULL;
+        pthread_mutex_unlock(&mutex_);
+
+        if (failed)
+        {
+            throw InternalError("Uncaught exception in ThreadPool task");
+        }
+    }
+
+    void*
+    ThreadPool::WorkerEntry(void* arg)
+    {
+        WorkerArg* workerArg = static_cast<WorkerArg*>(arg);
+        workerArg->Pool->WorkerLoop(workerArg->Index);
+        return NULL;
+    }
+
+    void
+    ThreadPool::WorkerLoop(int workerIndex)
+    {
+        unsigned long seenGeneration = 0;  // NOLINT
+        while (true)
+        {
+            pthread_mutex_lock(&mutex_);
+            while (!shutdown_ && generation_ == seenGeneration)
+            {
+                pthread_cond_wait(&workReady_, &mutex_);
+            }
+            if (shutdown_)
+            {
+                pthread_mutex_unlock(&mutex_);
+                return;
+            }
+            seenGeneration = generation_;
+            pthread_mutex_unlock(&mutex_);
+
+            bool failed = false;
+            try
+            {
+                RunChunk(workerIndex);
+            }
+            catch (...)
+            {
+                failed = true;
+            }
+
+            pthread_mutex_lock(&mutex_);
+            failed_ = failed_ || failed;
+            if (--pendingWorkers_ == 0)
+            {
+                pthread_cond_signal(&workDone_);
+            }
+            pthread_mutex_unlock(&mutex_);
+        }
+    }
+}}
@@ -3,10 +3,13 @@
 #include <ConsensusCore/Sequence.hpp>
 #include <ConsensusCore/Mutation.hpp>
 #include <ConsensusCore/Read.hpp>
+#include <ConsensusCore/Quiver/MatrixBudget.hpp>
+#include <ConsensusCore/Quiver/MutationScoreCache.hpp>
 #include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
 #include <ConsensusCore/Quiver/MutationScorer.hpp>
 #include <ConsensusCore/Quiver/QuiverConfig.hpp>
 #include <ConsensusCore/Quiver/SimpleRecursor.hpp>
+#include <ConsensusCore/Quiver/SimdTarget.hpp>
 #include <ConsensusCore/Quiver/SseRecursor.hpp>
 #include <ConsensusCore/Quiver/ReadScorer.hpp>
 #include <ConsensusCore/Quiver/Diploid.hpp>
@@ -23,6 +26,11 @@ using namespace ConsensusCore;
 %apply (float* IN_ARRAY2, int DIM1, int DIM2)
        { (const float *siteScores, int dim1, int dim2) }
 
+// ScoreMutations hands back a malloc'ed reads x mutations matrix;
+// numpy takes ownership of it.
+%apply (float** ARGOUTVIEWM_ARRAY2, int* DIM1, int* DIM2)
+       { (float** readScores, int* numReads, int* numMutations) }
+
 #endif // SWIGPYTHON
 
  // SWIG now seems to be incorrectly deciding that MultiReadMutationScorer
@@ -39,10 +47,13 @@ using namespace ConsensusCore;
 %include <ConsensusCore/Read.hpp>
 %include <ConsensusCore/Quiver/detail/Combiner.hpp>
 %include <ConsensusCore/Quiver/detail/RecursorBase.hpp>
+%include <ConsensusCore/Quiver/MatrixBudget.hpp>
+%include <ConsensusCore/Quiver/MutationScoreCache.hpp>
 %include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
 %include <ConsensusCore/Quiver/MutationScorer.hpp>
 %include <ConsensusCore/Quiver/QuiverConfig.hpp>
 %include <ConsensusCore/Quiver/SimpleRecursor.hpp>
+%include <ConsensusCore/Quiver/SimdTarget.hpp>
 %include <ConsensusCore/Quiver/SseRecursor.hpp>
 %include <ConsensusCore/Quiver/ReadScorer.hpp>
 %include <ConsensusCore/Quiver/Diploid.hpp>
@@ -118,7 +118,7 @@ RandomBernoulliDraw(RNG& rng, float p)
 
 template<typename RNG>
 QvEvaluator
-RandomQvEvaluator(RNG& rng, int length)
+RandomQvEvaluator(RNG& rng, int length, bool moveTables = false)
 {
     std::string tpl = RandomSequence(rng, length);
 
@@ -142,7 +142,7 @@ RandomQvEvaluator(RNG& rng, int length)
 
     bool pinStart = RandomBernoulliDraw(rng, 0.5);
     bool pinEnd = RandomBernoulliDraw(rng, 0.5);
-    return QvEvaluator(read, tpl, TestingParams(), pinStart, pinEnd);
+    return QvEvaluator(read, tpl, TestingParams(), pinStart, pinEnd, moveTables);
 }
 
 template<typename RNG>
@@ -0,0 +1,99 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <ConsensusCore/IntervalIndex.hpp>
+
+using ConsensusCore::Interval;
+using ConsensusCore::detail::IntervalIndex;
+
+static std::vector<int> BruteForceOverlapping(const std::vector<Interval>& intervals,
+                                              int begin, int end)
+{
+    std::vector<int> ids;
+    for (int i = 0; i < static_cast<int>(intervals.size()); i++)
+    {
+        if (intervals[i].Begin < end && begin < intervals[i].End) ids.push_back(i);
+    }
+    return ids;
+}
+
+TEST(IntervalIndexTest, Empty)
+{
+    IntervalIndex index;
+    std::vector<int> ids;
+    index.FindOverlapping(0, 100, &ids);
+    EXPECT_TRUE(ids.empty());
+    index.Build(std::vector<Interval>());
+    index.FindOverlapping(0, 100, &ids);
+    EXPECT_TRUE(ids.empty());
+}
+
+TEST(IntervalIndexTest, MatchesBruteForce)
+{
+    srand(42);
+    // Sizes around powers of two exercise the incomplete subtrees
+    const int sizes[] = { 1, 2, 3, 7, 8, 9, 31, 32, 33, 100, 1000, 1025 };
+    for (int s = 0; s < 12; s++)
+    {
+        int n = sizes[s];
+        std::vector<Interval> intervals;
+        for (int i = 0; i < n; i++)
+        {
+            // mostly short intervals, with the occasional long one
+            int begin = rand() % 10000;
+            int length = (rand() % 20 == 0) ? rand() % 10000 : rand() % 200;
+            intervals.push_back(Interval(begin, begin + length));
+        }
+        IntervalIndex index;
+        index.Build(intervals);
+        ASSERT_EQ(n, index.Size());
+        for (int q = 0; q < 200; q++)
+        {
+            int begin = rand() % 11000 - 500;
+            int end = begin + rand() % 300;
+            std::vector<int> ids;
+            index.FindOverlapping(begin, end, &ids);
+            ASSERT_EQ(BruteForceOverlapping(intervals, begin, end), ids)
+                << "n=" << n << " query=[" << begin << ", " << end << ")";
+        }
+    }
+}
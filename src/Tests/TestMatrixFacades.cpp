@@ -220,7 +220,40 @@ TYPED_TEST(MatrixTest, ToHostArray)
 
 
 TYPED_TEST(MatrixTest, NonSequentialAccess)
-{}
+{
+    // Edit columns out of order, then revisit an early column with a
+    // wider range than it was first given; contents of the other
+    // columns must survive.
+    TypeParam m(100, 10);
+    for (int j = 8; j >= 0; j -= 2)
+    {
+        m.StartEditingColumn(j, j, j + 1);
+        m.Set(j, j, j);
+        m.FinishEditingColumn(j, j, j + 1);
+    }
+    m.StartEditingColumn(1, 0, 0);
+    for (int i = 0; i < 100; i++)
+    {
+        m.Set(i, 1, -i);
+    }
+    m.FinishEditingColumn(1, 0, 100);
+    m.StartEditingColumn(3, 50, 60);
+    m.Set(99, 3, 7);
+    m.Set(0, 3, 8);
+    m.FinishEditingColumn(3, 0, 100);
+
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(-i, m(i, 1));
+    }
+    for (int j = 8; j >= 0; j -= 2)
+    {
+        EXPECT_EQ(j, m(j, j));
+    }
+    EXPECT_EQ(7, m(99, 3));
+    EXPECT_EQ(8, m(0, 3));
+    EXPECT_EQ(lfloat(), m(55, 3));
+}
 
 
 TYPED_TEST(MatrixTest, Holes)
@@ -257,6 +290,32 @@ TYPED_TEST(MatrixTest, BigIrregularBandedMatrix)
 }
 
 
+TYPED_TEST(MatrixTest, Reset)
+{
+    TypeParam m(10, 10);
+    for (int j = 0; j < 10; j++)
+    {
+        m.StartEditingColumn(j, 0, 10);
+        m.Set(j, j, 1);
+        m.FinishEditingColumn(j, j, j + 1);
+    }
+    m.Reset(20, 5);
+    EXPECT_EQ(20, m.Rows());
+    EXPECT_EQ(5, m.Columns());
+    EXPECT_EQ(0, m.UsedEntries());
+    for (int j = 0; j < 5; j++)
+    {
+        for (int i = 0; i < 20; i++)
+        {
+            EXPECT_EQ(lfloat(), m(i, j));
+        }
+    }
+    m.StartEditingColumn(4, 16, 20);
+    m.Set(19, 4, 2);
+    m.FinishEditingColumn(4, 19, 20);
+    EXPECT_EQ(2, m(19, 4));
+}
+
 TYPED_TEST(MatrixTest, CopyTest)
 {
     TypeParam m(4, 4);
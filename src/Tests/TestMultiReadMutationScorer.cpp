@@ -37,15 +37,19 @@
 
 #include <gtest/gtest.h>
 #include <boost/assign.hpp>
+#include <cstdlib>
 #include <string>
 #include <vector>
 
 #include <ConsensusCore/Quiver/MultiReadMutationScorer.hpp>
+#include <ConsensusCore/Quiver/MutationEnumerator.hpp>
 #include <ConsensusCore/Quiver/QuiverConfig.hpp>
+#include <ConsensusCore/Quiver/QuiverConsensus.hpp>
 #include <ConsensusCore/Quiver/ReadScorer.hpp>
 #include <ConsensusCore/Quiver/SimpleRecursor.hpp>
 #include <ConsensusCore/Quiver/SseRecursor.hpp>
 #include <ConsensusCore/Sequence.hpp>
+#include <ConsensusCore/Utils.hpp>
 
 #include "ParameterSettings.hpp"
 
@@ -593,3 +597,472 @@ TYPED_TEST(MultiReadMutationScorerTest, MultiBaseIndelsAtBounds)
     EXPECT_EQ(params.Nce                 ,  mScorer.Score(Mutation(DELETION, 19, 21, "")));
     EXPECT_EQ(0                          ,  mScorer.Score(Mutation(DELETION, 20, 22, "")));
 }
+
+
+TYPED_TEST(MultiReadMutationScorerTest, ThreadedScoringMatchesSerial)
+{
+    //                 0123456789012345678901
+    std::string tpl = "AATGTAATCAATTGATTACATT";
+    MMS serialScorer(this->testingConfigs_, tpl);
+    MMS threadedScorer(this->testingConfigs_, tpl);
+    threadedScorer.NumThreads(3);
+    EXPECT_EQ(1, serialScorer.NumThreads());
+    EXPECT_EQ(3, threadedScorer.NumThreads());
+
+    const char* reads[] = { "AATGTAATCAATTGATTACATT", "AATGTATCAATTGATTACATT",
+                            "AATGTAATCAATTGATTAC",    "TGTAATCAAATTGATTACATT",
+                            "AATGTAATCAATTGATTACATT" };
+    for (int i = 0; i < 5; i++)
+    {
+        MappedRead mr = AnonymousMappedRead(reads[i], (i % 2 ? REVERSE_STRAND : FORWARD_STRAND),
+                                            0, tpl.length());
+        serialScorer.AddRead(mr);
+        threadedScorer.AddRead(mr);
+    }
+    serialScorer.AddRead(AnonymousMappedRead("TTGATTACATT", FORWARD_STRAND, 11, 22));
+    threadedScorer.AddRead(AnonymousMappedRead("TTGATTACATT", FORWARD_STRAND, 11, 22));
+
+    std::vector<Mutation> muts;
+    for (int pos = 0; pos <= (int)tpl.length(); pos++)
+    {
+        if (pos < (int)tpl.length())
+        {
+            muts += Mutation(SUBSTITUTION, pos, 'G'), Mutation(DELETION, pos, '-');
+        }
+        muts += Mutation(INSERTION, pos, 'C');
+    }
+
+    foreach (const Mutation& m, muts)
+    {
+        EXPECT_EQ(serialScorer.Score(m), threadedScorer.Score(m));
+        EXPECT_EQ(serialScorer.FastScore(m), threadedScorer.FastScore(m));
+        EXPECT_EQ(serialScorer.Scores(m, -1), threadedScorer.Scores(m, -1));
+        EXPECT_EQ(serialScorer.IsFavorable(m), threadedScorer.IsFavorable(m));
+        EXPECT_EQ(serialScorer.FastIsFavorable(m), threadedScorer.FastIsFavorable(m));
+    }
+
+    std::vector<Mutation> applied;
+    applied += Mutation(INSERTION, 5, 'A'), Mutation(DELETION, 17, '-');
+    serialScorer.ApplyMutations(applied);
+    threadedScorer.ApplyMutations(applied);
+    EXPECT_EQ(serialScorer.Template(), threadedScorer.Template());
+    EXPECT_EQ(serialScorer.BaselineScores(), threadedScorer.BaselineScores());
+    for (int i = 0; i < serialScorer.NumReads(); i++)
+    {
+        EXPECT_EQ(serialScorer.Read(i) == NULL, threadedScorer.Read(i) == NULL);
+    }
+}
+
+
+TYPED_TEST(MultiReadMutationScorerTest, ScoreMutationsMatchesScore)
+{
+    // read1:                     >>>>>>>>>>>
+    // read2:          <<<<<<<<<<<
+    // read3:          >>>>>>>>>>>>>>>>>>>>>>
+    //                 0123456789012345678901
+    std::string tpl = "AATGTAATCAATTGATTACATT";
+
+    std::vector<Mutation> muts;
+    for (int pos = 0; pos < (int)tpl.length(); pos++)
+    {
+        muts += Mutation(SUBSTITUTION, pos, 'C'), Mutation(DELETION, pos, '-'),
+                Mutation(INSERTION, pos, 'G');
+    }
+
+    for (int numThreads = 1; numThreads <= 2; numThreads++)
+    {
+        MMS mScorer(this->testingConfigs_, tpl);
+        mScorer.NumThreads(numThreads);
+        mScorer.AddRead(AnonymousMappedRead("TTGATTACATT", FORWARD_STRAND, 11, 22));
+        mScorer.AddRead(AnonymousMappedRead("TTGATTACATT", REVERSE_STRAND,  0, 11));
+        mScorer.AddRead(AnonymousMappedRead("AATGTAATCATTGATTACATT", FORWARD_STRAND, 0, 22));
+
+        std::vector<float> totals = mScorer.ScoreMutations(muts);
+        ASSERT_EQ(muts.size(), totals.size());
+
+        float* readScores;
+        int numReads, numMutations;
+        std::vector<float> totals2 = mScorer.ScoreMutations(muts, -1.0f, &readScores,
+                                                            &numReads, &numMutations);
+        ASSERT_EQ(3, numReads);
+        ASSERT_EQ((int)muts.size(), numMutations);
+        EXPECT_EQ(totals, totals2);
+
+        for (int j = 0; j < numMutations; j++)
+        {
+            EXPECT_EQ(mScorer.Score(muts[j]), totals[j]);
+            std::vector<float> scores = mScorer.Scores(muts[j], -1.0f);
+            for (int i = 0; i < numReads; i++)
+            {
+                EXPECT_EQ(scores[i], readScores[i * numMutations + j]);
+            }
+        }
+        free(readScores);
+    }
+}
+
+
+TYPED_TEST(MultiReadMutationScorerTest, NonSpanningReadsAcrossApplyMutations)
+{
+    // Many short reads tiling the template, so that each mutation is
+    // scored by only a few of them; the per-mutation entry points
+    // must agree with the batch scorer, which tests every read,
+    // before and after the read coordinates are remapped.
+    std::string tpl;
+    for (int i = 0; i < 200; i++)
+    {
+        tpl += "ACGT"[(i * 7 + i / 3) % 4];
+    }
+    MMS mScorer(this->testingConfigs_, tpl);
+    for (int start = 0; start + 30 <= (int)tpl.length(); start += 7)
+    {
+        std::string seq = tpl.substr(start, 30);
+        StrandEnum strand = (start % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        mScorer.AddRead(AnonymousMappedRead(strand == FORWARD_STRAND ? seq : ReverseComplement(seq),
+                                            strand, start, start + 30));
+    }
+
+    for (int round = 0; round < 2; round++)
+    {
+        std::vector<Mutation> muts;
+        for (int pos = 0; pos < mScorer.TemplateLength(); pos += 3)
+        {
+            muts += Mutation(SUBSTITUTION, pos, 'C'), Mutation(DELETION, pos, '-'),
+                    Mutation(INSERTION, pos, 'G');
+        }
+        std::vector<float> totals = mScorer.ScoreMutations(muts);
+        for (int j = 0; j < (int)muts.size(); j++)
+        {
+            EXPECT_EQ(totals[j], mScorer.Score(muts[j]));
+            std::vector<float> scores = mScorer.Scores(muts[j], 0.0f);
+            int numScored = 0;
+            for (int i = 0; i < mScorer.NumReads(); i++)
+            {
+                if (mScorer.Read(i) != NULL && ReadScoresMutation(*mScorer.Read(i), muts[j]))
+                {
+                    numScored++;
+                }
+                else
+                {
+                    EXPECT_EQ(0.0f, scores[i]);
+                }
+            }
+            EXPECT_LT(numScored, mScorer.NumReads());
+        }
+
+        std::vector<Mutation> applied;
+        applied += Mutation(INSERTION, 50, 'A'), Mutation(DELETION, 120, '-'),
+                   Mutation(INSERTION, 121, 'T');
+        mScorer.ApplyMutations(applied);
+    }
+}
+
+
+TYPED_TEST(MultiReadMutationScorerTest, FavorableMutationsThreadedMatchesSerial)
+{
+    // The consensus is missing a base and has a substitution, so
+    // there is something favorable to find; refinement must take the
+    // same path however many threads screen the candidates.
+    //                  0123456789012345678901
+    std::string truth = "AATGTAATCAATTGATTACATT";
+    std::string tpl   = "AATGTATCAATTGATTCCATT";
+
+    MMS serialScorer(this->testingConfigs_, tpl);
+    MMS threadedScorer(this->testingConfigs_, tpl);
+    for (int i = 0; i < 6; i++)
+    {
+        StrandEnum strand = (i % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        MappedRead mr = AnonymousMappedRead(strand == FORWARD_STRAND ? truth
+                                                                     : ReverseComplement(truth),
+                                            strand, 0, tpl.length());
+        serialScorer.AddRead(mr);
+        threadedScorer.AddRead(mr);
+    }
+
+    std::vector<Mutation> muts;
+    for (int pos = 0; pos <= (int)tpl.length(); pos++)
+    {
+        for (int b = 0; b < 4; b++)
+        {
+            if (pos < (int)tpl.length())
+            {
+                muts += Mutation(SUBSTITUTION, pos, "ACGT"[b]);
+            }
+            muts += Mutation(INSERTION, pos, "ACGT"[b]);
+        }
+        if (pos < (int)tpl.length())
+        {
+            muts += Mutation(DELETION, pos, '-');
+        }
+    }
+
+    std::vector<ScoredMutation> serial = serialScorer.FavorableMutations(muts);
+    EXPECT_FALSE(serial.empty());
+    for (int numThreads = 2; numThreads <= 4; numThreads++)
+    {
+        std::vector<ScoredMutation> threaded =
+            threadedScorer.FavorableMutations(muts, numThreads);
+        ASSERT_EQ(serial.size(), threaded.size());
+        for (int k = 0; k < (int)serial.size(); k++)
+        {
+            EXPECT_EQ(serial[k], threaded[k]);
+            EXPECT_EQ(serial[k].Score(), threaded[k].Score());
+            EXPECT_EQ(serialScorer.Score(serial[k]), serial[k].Score());
+        }
+    }
+
+    RefineOptions opts = DefaultRefineOptions;
+    opts.NumThreads = 3;
+    bool serialConverged = RefineConsensus(serialScorer);
+    bool threadedConverged = RefineConsensus(threadedScorer, opts);
+    EXPECT_EQ(serialConverged, threadedConverged);
+    EXPECT_EQ(truth, serialScorer.Template());
+    EXPECT_EQ(serialScorer.Template(), threadedScorer.Template());
+}
+
+
+TYPED_TEST(MultiReadMutationScorerTest, FastScoreMutationsMatchesFastScore)
+{
+    // Overlapping reads with errors, both strands, so that blocks see
+    // partial coverage and sums get cut short
+    std::string tpl;
+    for (int i = 0; i < 300; i++)
+    {
+        tpl += "ACGT"[(i * 7 + i / 3) % 4];
+    }
+    MMS mScorer(this->testingConfigs_, tpl);
+    for (int start = 0; start + 60 <= (int)tpl.length(); start += 13)
+    {
+        std::string seq = tpl.substr(start, 60);
+        seq.erase(17 + start % 11, 1);
+        seq[40] = (seq[40] == 'A' ? 'C' : 'A');
+        StrandEnum strand = (start % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        mScorer.AddRead(AnonymousMappedRead(strand == FORWARD_STRAND ? seq : ReverseComplement(seq),
+                                            strand, start, start + 60));
+    }
+
+    UniqueSingleBaseMutationEnumerator enumerator(tpl);
+    std::vector<Mutation> muts = enumerator.Mutations();
+    for (int numThreads = 1; numThreads <= 3; numThreads += 2)
+    {
+        std::vector<float> scores = mScorer.FastScoreMutations(muts, numThreads);
+        ASSERT_EQ(muts.size(), scores.size());
+        for (int k = 0; k < (int)muts.size(); k++)
+        {
+            EXPECT_EQ(mScorer.FastScore(muts[k]), scores[k]) << muts[k];
+        }
+    }
+
+    std::vector<int> QVs = ConsensusQVs(mScorer);
+    EXPECT_EQ(tpl.length(), QVs.size());
+    EXPECT_EQ(QVs, ConsensusQVs(mScorer, 3));
+}
+
+TYPED_TEST(MultiReadMutationScorerTest, RefineConsensusWithScoreCache)
+{
+    //                  0123456789012345678901
+    std::string truth = "AATGTAATCAATTGATTACATT";
+    std::string tpl   = "AATGTATCAATTGATTCCATT";
+
+    MMS mScorer(this->testingConfigs_, tpl);
+    for (int i = 0; i < 6; i++)
+    {
+        StrandEnum strand = (i % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        mScorer.AddRead(AnonymousMappedRead(strand == FORWARD_STRAND ? truth
+                                                                     : ReverseComplement(truth),
+                                            strand, 0, tpl.length()));
+    }
+
+    // Freshly cached scores are the FastScores
+    MutationScoreCache cache(4);
+    UniqueSingleBaseMutationEnumerator enumerator(tpl);
+    std::vector<Mutation> muts = enumerator.Mutations();
+    std::vector<float> scores = mScorer.FastScoreMutations(muts, 1, &cache);
+    EXPECT_EQ(0, cache.Hits());
+    EXPECT_EQ((int)muts.size(), cache.Size());
+    EXPECT_EQ(scores, mScorer.FastScoreMutations(muts));
+    EXPECT_EQ(scores, mScorer.FastScoreMutations(muts, 1, &cache));
+    EXPECT_EQ((int)muts.size(), cache.Hits());
+
+    std::vector<ScoredMutation> favorable = mScorer.FavorableMutations(muts);
+    std::vector<ScoredMutation> cachedFavorable = mScorer.FavorableMutations(muts, 1, &cache);
+    ASSERT_EQ(favorable.size(), cachedFavorable.size());
+    for (int k = 0; k < (int)favorable.size(); k++)
+    {
+        EXPECT_EQ(favorable[k], cachedFavorable[k]);
+        EXPECT_EQ(favorable[k].Score(), cachedFavorable[k].Score());
+    }
+
+    cache.Clear();
+    EXPECT_TRUE(RefineConsensus(mScorer, DefaultRefineOptions, &cache));
+    EXPECT_EQ(truth, mScorer.Template());
+    int hits = cache.Hits();
+    std::vector<int> QVs = ConsensusQVs(mScorer, 1, &cache);
+    EXPECT_EQ(truth.length(), QVs.size());
+    EXPECT_LT(hits, cache.Hits());
+}
+
+TYPED_TEST(MultiReadMutationScorerTest, AddReadsMatchesAddRead)
+{
+    std::string tpl;
+    for (int i = 0; i < 200; i++)
+    {
+        tpl += "ACGT"[(i * 5 + i / 7) % 4];
+    }
+    std::vector<MappedRead> mrs;
+    for (int start = 0; start + 50 <= (int)tpl.length(); start += 15)
+    {
+        std::string seq = tpl.substr(start, 50);
+        seq.erase(20 + start % 7, 1);
+        StrandEnum strand = (start % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        mrs.push_back(AnonymousMappedRead(strand == FORWARD_STRAND ? seq : ReverseComplement(seq),
+                                          strand, start, start + 50));
+    }
+
+    MMS serialScorer(this->testingConfigs_, tpl);
+    foreach (const MappedRead& mr, mrs)
+    {
+        serialScorer.AddRead(mr);
+    }
+    MMS bulkScorer(this->testingConfigs_, tpl);
+    bulkScorer.NumThreads(3);
+    EXPECT_EQ((int)mrs.size(), bulkScorer.AddReads(mrs));
+
+    // A lazy scorer builds its reads on first use, against the
+    // template as it is then
+    std::vector<Mutation> muts;
+    muts += Mutation(SUBSTITUTION, 60, 'T'), Mutation(DELETION, 130, '-');
+    MMS lazyScorer(this->testingConfigs_, tpl);
+    lazyScorer.LazyAlphaBeta(true);
+    EXPECT_EQ((int)mrs.size(), lazyScorer.AddReads(mrs));
+    EXPECT_TRUE(lazyScorer.AddRead(mrs[0], 0.0f));
+    std::vector<float> times = lazyScorer.ConstructionTimes();
+    EXPECT_EQ(std::vector<float>(mrs.size() + 1, 0.0f), times);
+    lazyScorer.ApplyMutations(muts);
+    serialScorer.ApplyMutations(muts);
+    bulkScorer.ApplyMutations(muts);
+
+    EXPECT_EQ(serialScorer.BaselineScores(), bulkScorer.BaselineScores());
+    EXPECT_EQ(serialScorer.BaselineScores(), lazyScorer.BaselineScores());
+    for (int i = 0; i < (int)mrs.size(); i++)
+    {
+        EXPECT_TRUE(lazyScorer.Read(i) != NULL);
+        EXPECT_LE(0.0f, lazyScorer.ConstructionTimes()[i]);
+    }
+
+    // The read added with threshold 0 is rejected, holding nothing
+    EXPECT_TRUE(lazyScorer.Read(mrs.size()) == NULL);
+    EXPECT_TRUE(lazyScorer.AlphaMatrix(mrs.size()) == NULL);
+    EXPECT_EQ(0, lazyScorer.AllocatedMatrixEntries()[mrs.size()]);
+    EXPECT_EQ(serialScorer.Score(Mutation(INSERTION, 100, 'G')),
+              lazyScorer.Score(Mutation(INSERTION, 100, 'G')));
+}
+
+TYPED_TEST(MultiReadMutationScorerTest, MatrixMemoryBudget)
+{
+    std::string tpl;
+    for (int i = 0; i < 240; i++)
+    {
+        tpl += "ACGT"[(i * 7 + i / 5) % 4];
+    }
+    std::vector<MappedRead> mrs;
+    for (int k = 0; k < 12; k++)
+    {
+        int start = 10 * k;
+        int span = 40 + 7 * (k % 5);
+        std::string seq = tpl.substr(start, span);
+        seq.erase(span / 2, 1);
+        StrandEnum strand = (k % 2 ? REVERSE_STRAND : FORWARD_STRAND);
+        mrs.push_back(AnonymousMappedRead(strand == FORWARD_STRAND ? seq : ReverseComplement(seq),
+                                          strand, start, start + span));
+    }
+
+    MMS unbounded(this->testingConfigs_, tpl);
+    unbounded.AddReads(mrs);
+    std::vector<int> entries = unbounded.AllocatedMatrixEntries();
+    size_t totalEntries = 0;
+    foreach (int n, entries) totalEntries += n;
+    EXPECT_EQ(totalEntries, unbounded.PeakAllocatedMatrixEntries());
+    size_t budget = totalEntries / 2 * sizeof(float);
+
+    // Deactivating: the reads spanning the least template go first
+    MMS deactivating(this->testingConfigs_, tpl);
+    deactivating.MatrixMemoryBudget(budget);
+    deactivating.AddReads(mrs);
+    size_t heldEntries = 0;
+    int minActiveSpan = tpl.length(), maxInactiveSpan = 0;
+    for (int i = 0; i < (int)mrs.size(); i++)
+    {
+        int span = mrs[i].TemplateEnd - mrs[i].TemplateStart;
+        heldEntries += deactivating.AllocatedMatrixEntries()[i];
+        if (deactivating.Read(i) != NULL) minActiveSpan = std::min(minActiveSpan, span);
+        else maxInactiveSpan = std::max(maxInactiveSpan, span);
+    }
+    EXPECT_LE(heldEntries * sizeof(float), budget);
+    EXPECT_LE(maxInactiveSpan, minActiveSpan);
+    EXPECT_LT(0, maxInactiveSpan);
+    EXPECT_EQ(totalEntries, deactivating.PeakAllocatedMatrixEntries());
+
+    // Recomputing: every read stays, and the scores are unchanged
+    RecomputeLeastRecentlyUsed recompute;
+    MMS recomputing(this->testingConfigs_, tpl);
+    recomputing.MatrixMemoryBudget(budget, recompute);
+    recomputing.AddReads(mrs);
+    for (int i = 0; i < (int)mrs.size(); i++)
+    {
+        EXPECT_TRUE(recomputing.Read(i) != NULL);
+    }
+    EXPECT_EQ(unbounded.BaselineScores(), recomputing.BaselineScores());
+
+    UniqueSingleBaseMutationEnumerator enumerator(tpl);
+    std::vector<Mutation> muts = enumerator.Mutations();
+    EXPECT_EQ(unbounded.FastScoreMutations(muts), recomputing.FastScoreMutations(muts));
+    std::vector<ScoredMutation> favorable = unbounded.FavorableMutations(muts);
+    std::vector<ScoredMutation> recomputedFavorable = recomputing.FavorableMutations(muts, 2);
+    ASSERT_EQ(favorable.size(), recomputedFavorable.size());
+    for (int k = 0; k < (int)favorable.size(); k++)
+    {
+        EXPECT_EQ(favorable[k], recomputedFavorable[k]);
+        EXPECT_EQ(favorable[k].Score(), recomputedFavorable[k].Score());
+    }
+    EXPECT_EQ(unbounded.Score(muts[500]), recomputing.Score(muts[500]));
+
+    std::vector<Mutation> applied;
+    applied += Mutation(INSERTION, 60, 'T'), Mutation(SUBSTITUTION, 150, 'A');
+    unbounded.ApplyMutations(applied);
+    recomputing.ApplyMutations(applied);
+
+    // Scoring can overshoot the budget, with the reads in use spared,
+    // but ApplyMutations spares none
+    heldEntries = 0;
+    foreach (int n, recomputing.AllocatedMatrixEntries()) heldEntries += n;
+    EXPECT_LE(heldEntries * sizeof(float), budget);
+    EXPECT_LT(heldEntries, recomputing.PeakAllocatedMatrixEntries());
+
+    EXPECT_EQ(unbounded.BaselineScores(), recomputing.BaselineScores());
+    EXPECT_EQ(unbounded.Score(muts[700]), recomputing.Score(muts[700]));
+}
+
+TYPED_TEST(MultiReadMutationScorerTest, NumFlipFlopsOfReadDroppedWhenAdded)
+{
+    std::string tpl = "GATTACAGATTACAGATTACAGATTACAGATTACA";
+    MMS mScorer(this->testingConfigs_, tpl);
+    EXPECT_TRUE(mScorer.AddRead(AnonymousMappedRead(tpl, FORWARD_STRAND, 0, tpl.length())));
+
+    // Quality values this extreme push the scores out of float's
+    // precision, so alpha and beta are never mated
+    std::string seq = "TTTTGGGGCCCCAAAATTTTGGGGCCCCAAAATTTTGGGGCCCCAAAATTTTGGGG";
+    std::vector<float> qv(seq.length()), tag(seq.length(), 'N');
+    for (int i = 0; i < (int)seq.length(); i++)
+    {
+        qv[i] = 1e7f * (1 + (i * 7) % 13) / 7;
+    }
+    Read extreme(QvSequenceFeatures(seq, &qv[0], &qv[0], &qv[0], &tag[0], &qv[0]),
+                 "extreme", "unknown");
+    EXPECT_FALSE(mScorer.AddRead(MappedRead(extreme, FORWARD_STRAND, 0, tpl.length())));
+
+    std::vector<int> numFlipFlops = mScorer.NumFlipFlops();
+    ASSERT_EQ(2, (int)numFlipFlops.size());
+    EXPECT_LE(0, numFlipFlops[0]);
+    EXPECT_EQ(-1, numFlipFlops[1]);
+}
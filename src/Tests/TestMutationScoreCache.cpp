@@ -0,0 +1,96 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <ConsensusCore/Mutation.hpp>
+#include <ConsensusCore/Quiver/MutationScoreCache.hpp>
+#include <ConsensusCore/Types.hpp>
+
+using namespace ConsensusCore;  // NOLINT
+
+TEST(MutationScoreCacheTest, FindCountsHitsAndMisses)
+{
+    MutationScoreCache cache(5);
+    Mutation m(SUBSTITUTION, 3, 'G');
+    float score = 0;
+    EXPECT_FALSE(cache.Find(m, &score));
+    cache.Insert(m, 1.5f);
+    EXPECT_TRUE(cache.Find(m, &score));
+    EXPECT_EQ(1.5f, score);
+    EXPECT_FALSE(cache.Find(Mutation(INSERTION, 3, 'G'), &score));
+    EXPECT_EQ(1, cache.Size());
+    EXPECT_EQ(1, cache.Hits());
+    EXPECT_EQ(2, cache.Misses());
+
+    cache.Clear();
+    EXPECT_EQ(0, cache.Size());
+    EXPECT_THROW(MutationScoreCache(0), InvalidInputError);
+}
+
+TEST(MutationScoreCacheTest, ApplyMutationsInvalidatesNearbyAndRemapsTheRest)
+{
+    //                 0         1         2         3
+    //                 0123456789012345678901234567890123456789
+    std::string tpl = "ACGTACGTACGTACGTACGTACGTACGTACGTACGTACGT";
+    MutationScoreCache cache(3);
+    cache.Insert(Mutation(SUBSTITUTION, 2, 'A'), 1.0f);   // kept, unmoved
+    cache.Insert(Mutation(INSERTION, 7, 'T'), 2.0f);      // within 3 of the deletion
+    cache.Insert(Mutation(DELETION, 12, '-'), 3.0f);      // within 3 of the deletion
+    cache.Insert(Mutation(SUBSTITUTION, 15, 'C'), 4.0f);  // kept, moves left
+    cache.Insert(Mutation(INSERTION, 26, 'A'), 5.0f);     // within 3 of the insertion
+    cache.Insert(Mutation(INSERTION, 33, 'A'), 6.0f);     // kept, moves left then right
+
+    std::vector<Mutation> applied;
+    applied.push_back(Mutation(DELETION, 10, '-'));
+    applied.push_back(Mutation(DELETION, 11, '-'));
+    applied.push_back(Mutation(INSERTION, 29, 'G'));
+    cache.ApplyMutations(applied, tpl);
+
+    EXPECT_EQ(3, cache.Size());
+    float score = 0;
+    EXPECT_TRUE(cache.Find(Mutation(SUBSTITUTION, 2, 'A'), &score));
+    EXPECT_EQ(1.0f, score);
+    EXPECT_TRUE(cache.Find(Mutation(SUBSTITUTION, 13, 'C'), &score));
+    EXPECT_EQ(4.0f, score);
+    EXPECT_TRUE(cache.Find(Mutation(INSERTION, 32, 'A'), &score));
+    EXPECT_EQ(6.0f, score);
+    EXPECT_FALSE(cache.Find(Mutation(SUBSTITUTION, 15, 'C'), &score));
+}
@@ -50,6 +50,7 @@
 #include <ConsensusCore/Quiver/ReadScorer.hpp>
 #include <ConsensusCore/Quiver/SimpleRecursor.hpp>
 #include <ConsensusCore/Quiver/SseRecursor.hpp>
+#include <ConsensusCore/Utils.hpp>
 
 #include "ParameterSettings.hpp"
 
@@ -222,6 +223,44 @@ TYPED_TEST(MutationScorerTest, TemplateMutationWorkflow)
 }
 
 
+TYPED_TEST(MutationScorerTest, IncrementalTemplateRefill)
+{
+    // Local edits to a long template are refilled incrementally;
+    // results should agree with scoring the new template from scratch.
+    std::string tpl = "GATTACAGATTACACCGGTAGATACAGGATTTACAGTACCAGATTACACATTAGGCATGCA";
+    Read read = AnonymousRead("GATTACAGATTACACCGTAGATACAGGATTTACAGTACCAGATTTACACATTAGGCATGCA");
+    TypeParam narrowRecursor(ALL_MOVES, BandingOptions(4, 15));
+    E ev(read, tpl, params, true, true);
+    MS ms(ev, narrowRecursor);
+
+    std::vector<Mutation> muts;
+    muts += Mutation(SUBSTITUTION, 30, 'C'),
+            Mutation(INSERTION, 17, 'G'),
+            Mutation(DELETION, 44, '-'),
+            Mutation(SUBSTITUTION, 10, 12, "GG"),
+            Mutation(DELETION, 52, 54, ""),
+            Mutation(INSERTION, 5, 5, "TT");
+
+    foreach (const Mutation& m, muts)
+    {
+        tpl = ApplyMutation(m, tpl);
+        ms.Template(tpl);
+        ASSERT_EQ(tpl, ms.Template());
+
+        E freshEv(read, tpl, params, true, true);
+        MS freshMs(freshEv, narrowRecursor);
+        EXPECT_NEAR(freshMs.Score(), ms.Score(), 0.01);
+        EXPECT_NEAR(ms.Alpha()->Get(read.Length(), tpl.length()), ms.Score(), 0.2);
+
+        for (int pos = 5; pos < (int)tpl.length() - 5; pos += 7)
+        {
+            Mutation probe(SUBSTITUTION, pos, 'A');
+            EXPECT_NEAR(freshMs.ScoreMutation(probe), ms.ScoreMutation(probe), 0.01);
+        }
+    }
+}
+
+
 
 
 TYPED_TEST(MutationScorerTest, DinucleotideInsertionTest)
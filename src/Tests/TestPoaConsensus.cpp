@@ -50,6 +50,7 @@
 
 #include <ConsensusCore/Align/AlignConfig.hpp>
 #include <ConsensusCore/Poa/PoaConsensus.hpp>
+#include <ConsensusCore/Poa/RangeFinder.hpp>
 #include <ConsensusCore/Utils.hpp>
 #include <ConsensusCore/Mutation.hpp>
 
@@ -465,6 +466,289 @@ TEST(PoaConsensus, TestVerboseGraphVizOutput)
     delete pc;
 }
 
+TEST(PoaGraph, CopiedGraphAcceptsMoreReads)
+{
+    AlignConfig config = DefaultPoaConfig(GLOBAL);
+    PoaGraph pg;
+    pg.AddRead("GGG", config);
+    pg.AddRead("TGGG", config);
+
+    PoaGraph copy(pg);
+    EXPECT_EQ(pg.ToGraphViz(), copy.ToGraphViz());
+
+    vector<PoaGraph::Vertex> path, copyPath;
+    pg.AddRead("GTGG", config, NULL, &path);
+    copy.AddRead("GTGG", config, NULL, &copyPath);
+    EXPECT_EQ(path, copyPath);
+    EXPECT_EQ(pg.ToGraphViz(), copy.ToGraphViz());
+    EXPECT_EQ(3, copy.NumReads());
+}
+
+TEST(PoaGraph, ReusedAlignmentMatchesFreshOne)
+{
+    // AddRead reuses one alignment from read to read, whereas each
+    // TryAddRead makes a fresh one; the reads grow and shrink, and a
+    // FindConsensus midway releases the reused one
+    vector<std::string> reads;
+    reads += "GATTACAGATTACAGATTACACCGT",
+             "GATTACAGATACAGATTTACACCGTGATTACAGATTACAGATTACACCGT",
+             "TTGATTACAGATTACAGATTACACC",
+             "GATTACAGGATTACAGATTACACCGTAATGATTACAGATTACA",
+             "CAGATTACAGATTACACCGTTT";
+
+    AlignMode modes[] = { GLOBAL, SEMIGLOBAL, LOCAL };
+    for (int m = 0; m < 3; m++)
+    {
+        AlignConfig config = DefaultPoaConfig(modes[m]);
+        PoaGraph reused, fresh;
+        foreach (const std::string& read, reads)
+        {
+            vector<PoaGraph::Vertex> path, freshPath;
+            reused.AddRead(read, config, NULL, &path);
+            if (fresh.NumReads() == 0)
+            {
+                fresh.AddFirstRead(read, &freshPath);
+            }
+            else
+            {
+                PoaAlignmentMatrix* mat = fresh.TryAddRead(read, config);
+                fresh.CommitAdd(mat, &freshPath);
+                delete mat;
+            }
+            EXPECT_EQ(freshPath, path);
+            if (reused.NumReads() == 3)
+            {
+                delete reused.FindConsensus(config);
+            }
+        }
+        EXPECT_EQ(fresh.ToGraphViz(), reused.ToGraphViz());
+    }
+}
+
+TEST(PoaGraph, VectorizedAlignmentMatchesScalar)
+{
+    vector<std::string> reads;
+    reads += "GATTACAGATTACAGATTACACCGT",
+             "GATTACAGATACAGATTTACACCGT",
+             "TTGATTACAGATTACAGATTACACC",
+             "GATTACAGGATTACAGATTACACCGTAAT",
+             "GATTCCAGATTACAGATTACAC",
+             "CAGATTACAGATTACACCGTTT";
+
+    AlignMode modes[] = { GLOBAL, SEMIGLOBAL, LOCAL };
+    for (int m = 0; m < 3; m++)
+    {
+        AlignConfig config = DefaultPoaConfig(modes[m]);
+        PoaGraph vectorized, scalar;
+        scalar.VectorizedAlignment(false);
+        EXPECT_TRUE(vectorized.VectorizedAlignment());
+        foreach (const std::string& read, reads)
+        {
+            vector<PoaGraph::Vertex> path, scalarPath;
+            vectorized.AddRead(read, config, NULL, &path);
+            scalar.AddRead(read, config, NULL, &scalarPath);
+            EXPECT_EQ(scalarPath, path);
+        }
+        EXPECT_EQ(scalar.ToGraphViz(PoaGraph::VERBOSE_NODES),
+                  vectorized.ToGraphViz(PoaGraph::VERBOSE_NODES));
+    }
+}
+
+namespace {
+    // Anchors every consensus position on the diagonal, with ranges
+    // covering the whole read
+    class WholeReadRangeFinder : public detail::DiagonalRangeFinder
+    {
+    protected:
+        int AnchorRangeWidth(int readLength) const { return readLength; }
+    };
+
+    // Finds no anchors at all, so no vertex is banded
+    class NoAnchorsRangeFinder : public detail::SdpRangeFinder
+    {
+    protected:
+        detail::SdpAnchorVector FindAnchors(const std::string&, const std::string&)
+        {
+            return detail::SdpAnchorVector();
+        }
+    };
+
+    // Anchors only the first base, so the ranges stop short of the
+    // end of any read much longer than the consensus
+    class FirstBaseRangeFinder : public detail::SdpRangeFinder
+    {
+    protected:
+        detail::SdpAnchorVector FindAnchors(const std::string&, const std::string&)
+        {
+            return detail::SdpAnchorVector(1, detail::SdpAnchor(0, 0));
+        }
+    };
+
+    class TestKmerRangeFinder : public detail::KmerRangeFinder
+    {
+    public:
+        explicit TestKmerRangeFinder(int kmerSize) : detail::KmerRangeFinder(kmerSize) {}
+        using detail::KmerRangeFinder::FindAnchors;
+    };
+
+    std::string RandomSequence(int length, unsigned int seed)
+    {
+        std::string seq;
+        for (int i = 0; i < length; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            seq += "ACGT"[(seed >> 16) & 3];
+        }
+        return seq;
+    }
+
+    std::string NoisyRead(const std::string& tpl, int seed)
+    {
+        // a deletion, an insertion and a substitution, placed by seed
+        std::string read = tpl;
+        read.erase(11 + 7 * seed, 1);
+        read.insert(40 + 5 * seed, "T");
+        read[70 + 3 * seed] = (read[70 + 3 * seed] == 'A' ? 'C' : 'A');
+        return read;
+    }
+}
+
+TEST(PoaGraph, DefaultBandMatchesWholeReadAlignment)
+{
+    std::string tpl;
+    for (int k = 0; k < 12; k++)
+    {
+        tpl += "GATTACACGTTGCA" + std::string(k % 3 + 1, 'C');
+    }
+    AlignConfig config = DefaultPoaConfig(GLOBAL);
+    PoaGraph banded, whole;
+    WholeReadRangeFinder wholeReadRangeFinder;
+    for (int r = 0; r < 6; r++)
+    {
+        vector<PoaGraph::Vertex> path, wholePath;
+        banded.AddRead(NoisyRead(tpl, r), config, NULL, &path);
+        whole.AddRead(NoisyRead(tpl, r), config, &wholeReadRangeFinder, &wholePath);
+        EXPECT_EQ(wholePath, path);
+    }
+    EXPECT_EQ(whole.ToGraphViz(PoaGraph::VERBOSE_NODES),
+              banded.ToGraphViz(PoaGraph::VERBOSE_NODES));
+}
+
+TEST(PoaGraph, NoAnchorsMeansNoBanding)
+{
+    vector<std::string> reads;
+    reads += "GATTACAGATTACAGATTACACCGT",
+             "GATTACAGATACAGATTTACACCGT",
+             "TTGATTACAGATTACAGATTACACC",
+             "CAGATTACAGATTACACCGTTT";
+
+    AlignMode modes[] = { GLOBAL, SEMIGLOBAL, LOCAL };
+    for (int m = 0; m < 3; m++)
+    {
+        AlignConfig config = DefaultPoaConfig(modes[m]);
+        PoaGraph unanchored, reference;
+        NoAnchorsRangeFinder noAnchorsRangeFinder;
+        WholeReadRangeFinder wholeReadRangeFinder;
+        foreach (const std::string& read, reads)
+        {
+            vector<PoaGraph::Vertex> path, referencePath;
+            unanchored.AddRead(read, config, &noAnchorsRangeFinder, &path);
+            reference.AddRead(read, config, &wholeReadRangeFinder, &referencePath);
+            EXPECT_EQ(referencePath, path);
+        }
+        // (consensus finding sets the vertex scores shown)
+        const PoaConsensus* pc = unanchored.FindConsensus(config);
+        const PoaConsensus* referencePc = reference.FindConsensus(config);
+        EXPECT_EQ(referencePc->Sequence, pc->Sequence);
+        EXPECT_EQ(reference.ToGraphViz(PoaGraph::VERBOSE_NODES),
+                  unanchored.ToGraphViz(PoaGraph::VERBOSE_NODES));
+        delete pc;
+        delete referencePc;
+    }
+}
+
+TEST(PoaGraph, ShortBandsFallBackToWholeReadAlignment)
+{
+    // (each read runs 60 bases past the consensus before it)
+    const std::string tail = RandomSequence(180, 7);
+    vector<std::string> reads;
+    reads += "GATTACAGATTACAGATTACACCGT",
+             "GATTACAGATACAGATTTACACCGT" + tail.substr(0, 60),
+             "TTGATTACAGATTACAGATTACACC" + tail.substr(0, 120),
+             "CAGATTACAGATTACACCGTTT" + tail;
+
+    // (under LOCAL alignment, a short band only shortens the
+    // alignment, which is not a reason to fall back)
+    AlignMode modes[] = { GLOBAL, SEMIGLOBAL };
+    for (int m = 0; m < 2; m++)
+    {
+        AlignConfig config = DefaultPoaConfig(modes[m]);
+        PoaGraph banded, reference;
+        FirstBaseRangeFinder firstBaseRangeFinder;
+        WholeReadRangeFinder wholeReadRangeFinder;
+        foreach (const std::string& read, reads)
+        {
+            vector<PoaGraph::Vertex> path, referencePath;
+            banded.AddRead(read, config, &firstBaseRangeFinder, &path);
+            reference.AddRead(read, config, &wholeReadRangeFinder, &referencePath);
+            EXPECT_EQ(referencePath, path);
+        }
+        const PoaConsensus* pc = banded.FindConsensus(config);
+        const PoaConsensus* referencePc = reference.FindConsensus(config);
+        EXPECT_EQ(referencePc->Sequence, pc->Sequence);
+        EXPECT_EQ(reference.ToGraphViz(PoaGraph::VERBOSE_NODES),
+                  banded.ToGraphViz(PoaGraph::VERBOSE_NODES));
+        delete pc;
+        delete referencePc;
+    }
+}
+
+TEST(KmerRangeFinder, AnchorsFollowTheAlignment)
+{
+    // a 30-base deletion at 500 shifts the diagonal by 30
+    const std::string css = RandomSequence(1000, 1);
+    const std::string read = css.substr(0, 500) + css.substr(530);
+    TestKmerRangeFinder rangeFinder(12);
+    detail::SdpAnchorVector anchors = rangeFinder.FindAnchors(css, read);
+
+    ASSERT_LT(900, anchors.size());
+    for (size_t i = 0; i < anchors.size(); i++)
+    {
+        size_t cssPos = anchors[i].first, readPos = anchors[i].second;
+        if (i > 0)
+        {
+            EXPECT_LT(anchors[i - 1].first, cssPos);
+            EXPECT_LT(anchors[i - 1].second, readPos);
+        }
+        EXPECT_TRUE(cssPos + 12 <= 500 || cssPos >= 530);
+        EXPECT_EQ(cssPos < 500 ? cssPos : cssPos - 30, readPos);
+    }
+
+    // unrelated sequences share no convincing chain
+    EXPECT_TRUE(rangeFinder.FindAnchors(css, RandomSequence(1000, 2)).empty());
+    EXPECT_TRUE(rangeFinder.FindAnchors("", read).empty());
+    EXPECT_TRUE(rangeFinder.FindAnchors(css, "").empty());
+}
+
+TEST(PoaConsensus, KmerRangeFinderConsensus)
+{
+    const std::string tpl = RandomSequence(800, 3);
+    vector<std::string> reads;
+    for (int r = 0; r < 5; r++)
+    {
+        reads.push_back(NoisyRead(tpl, r));
+    }
+    AlignMode modes[] = { GLOBAL, SEMIGLOBAL, LOCAL };
+    for (int m = 0; m < 3; m++)
+    {
+        const PoaConsensus* pc = PoaConsensus::FindConsensus(reads, modes[m], -INT_MAX, true);
+        const PoaConsensus* referencePc = PoaConsensus::FindConsensus(reads, modes[m]);
+        EXPECT_EQ(referencePc->Sequence, pc->Sequence);
+        delete pc;
+        delete referencePc;
+    }
+}
+
 TEST(PoaConsensus, TestLocalStaggered)
 {
     // Adapted from Pat's C# test
@@ -488,6 +772,23 @@ TEST(PoaConsensus, TestLocalStaggered)
     delete pc;
 }
 
+TEST(PoaConsensus, TestLocalTrimmedReads)
+{
+    // Reads trimmed at both ends, with errors, of the template
+    // GTACGGACCGGAAGGCTTTCGGGAAATGTA.  When a read was counted as
+    // spanning every vertex between its ends in the topological
+    // order, other reads' branches included, the consensus began GTT.
+    vector<std::string> reads;
+    reads += "GGACCGGAAAGCTTTCGGGGAAAT",
+             "GTACGGACCGGAAGGCTTTCGGGAAAC",
+             "GTTCGGACCAGAAGGTCTTTCGGGA",
+             "GACCGAAGGCTTTCGGGA",
+             "GACGGAAGGCTTTCGGGAAATGTA";
+    const PoaConsensus* pc = PoaConsensus::FindConsensus(reads, LOCAL);
+    EXPECT_EQ("GTACGGACCGGAAGGCTTTCGGGAAATGTA", pc->Sequence);
+    delete pc;
+}
+
 TEST(PoaConsensus, TestLongInsert)
 {
     // Adapted from Pat's C# test
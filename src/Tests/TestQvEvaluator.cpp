@@ -134,6 +134,42 @@ TEST_F(QvEvaluatorTest, MergeVsMerge4)
 }
 
 
+TEST_F(QvEvaluatorTest, MoveTablesMatchComputedScores)
+{
+    Rng rng(42);
+    foreach (const QvEvaluator& e, this->fuzzEvaluators_)
+    {
+        QvEvaluator t = RandomQvEvaluator(rng, 20, true);
+        ASSERT_EQ(e.Basecalls(), t.Basecalls());
+        ASSERT_EQ(e.Template(), t.Template());
+        ASSERT_FALSE(e.HasMoveTables());
+        ASSERT_TRUE(t.HasMoveTables());
+        EXPECT_EQ(0, e.AllocatedMoveTableEntries());
+        EXPECT_LE(16 * (t.ReadLength() + 1), t.AllocatedMoveTableEntries());
+
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+        for (int j = 0; j <= J; j++)
+        {
+            for (int i = 0; i <= I; i++)
+            {
+                if (j < J)              EXPECT_EQ(e.Del(i, j), t.Del(i, j));
+                if (j < J && i < I)     EXPECT_EQ(e.Inc(i, j), t.Inc(i, j));
+                if (i < I)              EXPECT_EQ(e.Extra(i, j), t.Extra(i, j));
+                if (j < J - 1 && i < I) EXPECT_EQ(e.Merge(i, j), t.Merge(i, j));
+            }
+            for (int i = 0; i <= I - 4; i++)
+            {
+                if (j < J)      COMPARE4(t.Inc4, e.Inc, i, j);
+                if (j < J)      COMPARE4(t.Del4, e.Del, i, j);
+                                COMPARE4(t.Extra4, e.Extra, i, j);
+                if (j < J - 1)  COMPARE4(t.Merge4, e.Merge, i, j);
+            }
+        }
+    }
+}
+
+
 TEST_F(QvEvaluatorTest, BadTagTest)
 {
     Rng rng(42);
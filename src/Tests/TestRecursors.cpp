@@ -38,6 +38,10 @@
 #include <gtest/gtest.h>
 
 #include <boost/format.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -49,6 +53,7 @@
 #include <ConsensusCore/Quiver/QuiverConfig.hpp>
 #include <ConsensusCore/Quiver/SimpleRecursor.hpp>
 #include <ConsensusCore/Quiver/SseRecursor.hpp>
+#include <ConsensusCore/Quiver/detail/Combiner.hpp>
 #include <ConsensusCore/Features.hpp>
 
 #include "MatrixPrinting.hpp"
@@ -342,6 +347,89 @@ TYPED_TEST(RecursorFuzzTest, AlphaBetaConcordance)
 }
 
 
+TYPED_TEST(RecursorFuzzTest, DiagonalBandAndDynamicScoreDiff)
+{
+    R recursor(BASIC_MOVES | MERGE, this->banding_);
+    R narrowRecursor(BASIC_MOVES | MERGE, BandingOptions(1, 200, 0.5, 10));
+
+    foreach (const QvEvaluator& e, this->fuzzEvaluators_)
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+        int halfWidth = static_cast<int>(ceil(sqrt(static_cast<float>(std::max(I, J)))));
+
+        // The unguided alpha fill keeps to the diagonal band (give or
+        // take the SSE recursors' blocks of four rows)
+        M alpha(I + 1, J + 1);
+        narrowRecursor.FillAlpha(e, NULL_MATRIX, alpha);
+        for (int j = 0; j <= J; j++)
+        {
+            int diagonalRow = j * I / J;
+            EXPECT_LE(alpha.UsedRowRange(j).End, diagonalRow + halfWidth + 4) << j;
+        }
+
+        // ... and the guided fills recover the same score
+        M beta(I + 1, J + 1), wideAlpha(I + 1, J + 1), wideBeta(I + 1, J + 1);
+        narrowRecursor.FillAlphaBeta(e, alpha, beta);
+        recursor.FillAlphaBeta(e, wideAlpha, wideBeta);
+        EXPECT_FLOAT_EQ(alpha(I, J), beta(0, 0));
+        EXPECT_FLOAT_EQ(wideAlpha(I, J), alpha(I, J));
+        EXPECT_LE(alpha.UsedEntries(), wideAlpha.UsedEntries());
+    }
+}
+
+
+TYPED_TEST(RecursorFuzzTest, GuidedFillAlphaBeta)
+{
+    R recursor(BASIC_MOVES | MERGE, this->banding_);
+
+    foreach (const QvEvaluator& e, this->fuzzEvaluators_)
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+
+        M alpha(I + 1, J + 1), beta(I + 1, J + 1);
+        int flipFlops = recursor.FillAlphaBeta(e, alpha, beta);
+        const PairwiseAlignment* alignment = recursor.Alignment(e, alpha);
+        std::vector<int> guidePath = TargetToQueryPositions(*alignment);
+        delete alignment;
+
+        M guidedAlpha(I + 1, J + 1), guidedBeta(I + 1, J + 1);
+        EXPECT_LE(recursor.FillAlphaBeta(e, guidePath, guidedAlpha, guidedBeta), flipFlops);
+        EXPECT_FLOAT_EQ(alpha(I, J), guidedAlpha(I, J));
+        EXPECT_FLOAT_EQ(guidedAlpha(I, J), guidedBeta(0, 0));
+    }
+}
+
+
+TYPED_TEST(RecursorFuzzTest, BandWideningInsteadOfMismatch)
+{
+    // A band too narrow for alpha and beta to mate by flip-flops alone
+    R recursor(BASIC_MOVES | MERGE, this->banding_);
+    R narrowRecursor(BASIC_MOVES | MERGE, BandingOptions(0, 0.5));
+
+    int numWidened = 0;
+    foreach (const QvEvaluator& e, this->fuzzEvaluators_)
+    {
+        int I = e.ReadLength();
+        int J = e.TemplateLength();
+
+        M alpha(I + 1, J + 1), beta(I + 1, J + 1);
+        M narrowAlpha(I + 1, J + 1), narrowBeta(I + 1, J + 1);
+        recursor.FillAlphaBeta(e, alpha, beta);
+        int flipFlops = narrowRecursor.FillAlphaBeta(e, narrowAlpha, narrowBeta);
+        EXPECT_NEAR(narrowAlpha(I, J), narrowBeta(0, 0), 0.2);
+        if (flipFlops > 6)
+        {
+            // Widened far enough to find the best path
+            EXPECT_NEAR(alpha(I, J), narrowAlpha(I, J), 0.2);
+            numWidened++;
+        }
+    }
+    EXPECT_LT(0, numWidened);
+}
+
+
 TYPED_TEST(RecursorFuzzTest, Alignment)
 {
     R recursor(BASIC_MOVES | MERGE, this->banding_);
@@ -440,3 +528,136 @@ TYPED_TEST(RecursorFuzzTest, ExtendBeta)
         }
     }
 }
+
+
+// ----------------------------------------------------------------------------
+// The in-register insertion cascade must agree with the row-by-row one,
+// including where cells are unreachable (-FLT_MAX).
+// ----------------------------------------------------------------------------
+
+template <typename C>
+static void
+CheckScanCascadeMatchesRowByRow()
+{
+    Rng rng(42);
+    boost::random::uniform_int_distribution<> scoreDist(-3000, 0);
+    for (int n = 0; n < 1000; n++)
+    {
+        float x[4], ins[4];
+        for (int k = 0; k < 4; k++)
+        {
+            x[k]   = (n % 5 == k) ? -FLT_MAX : scoreDist(rng) / 100.0f;
+            ins[k] = scoreDist(rng) / 300.0f;
+        }
+        float boundary = (n % 7 == 0) ? -FLT_MAX : scoreDist(rng) / 100.0f;
+        __m128 x4 = _mm_loadu_ps(x), ins4 = _mm_loadu_ps(ins);
+
+        float rowByRow[4], scan[4];
+        _mm_storeu_ps(rowByRow, detail::ScalarCascadeDown4<C>(x4, ins4, boundary));
+        _mm_storeu_ps(scan, detail::ScanCascadeDown4<C>(x4, ins4, boundary));
+        for (int k = 0; k < 4; k++)
+        {
+            ASSERT_NEAR(rowByRow[k], scan[k], 1e-4) << "down " << n << " " << k;
+        }
+
+        _mm_storeu_ps(rowByRow, detail::ScalarCascadeUp4<C>(x4, ins4, boundary));
+        _mm_storeu_ps(scan, detail::ScanCascadeUp4<C>(x4, ins4, boundary));
+        for (int k = 0; k < 4; k++)
+        {
+            ASSERT_NEAR(rowByRow[k], scan[k], 1e-4) << "up " << n << " " << k;
+        }
+    }
+}
+
+TEST(ExtraCascadeTest, ScanMatchesRowByRow)
+{
+    CheckScanCascadeMatchesRowByRow<detail::ViterbiCombiner>();
+    CheckScanCascadeMatchesRowByRow<detail::SumProductCombiner>();
+}
+
+
+// ----------------------------------------------------------------------------
+// The AVX2/AVX-512 kernels must fill exactly the cells SSE3 does, with the
+// same scores, under both a tight band and an unrestrictive one, with and
+// without merge moves.
+// ----------------------------------------------------------------------------
+
+template <typename SR>
+static void
+CheckSimdTargetsAgree(int movesAvailable, const BandingOptions& banding)
+{
+    typedef typename SR::MatrixType M_;
+
+    Rng rng(42);
+    std::vector<QvEvaluator> evaluators;
+    for (int n = 0; n < 60; n++)
+    {
+        evaluators.push_back(RandomQvEvaluator(rng, 5 + (11 * n) % 80));
+    }
+
+    SR sse(movesAvailable, banding);
+    sse.Target(SSE3_TARGET);
+
+    SimdTarget targets[] = { AVX2_TARGET, AVX512_TARGET };
+    foreach (SimdTarget target, targets)
+    {
+        if (!IsSimdTargetSupported(target)) continue;
+
+        SR simd(movesAvailable, banding);
+        simd.Target(target);
+
+        foreach (const QvEvaluator& e, evaluators)
+        {
+            int I = e.ReadLength(), J = e.TemplateLength();
+            M_ alpha(I + 1, J + 1), beta(I + 1, J + 1);
+            M_ simdAlpha(I + 1, J + 1), simdBeta(I + 1, J + 1);
+
+            sse.FillAlpha(e, M_::Null(), alpha);
+            sse.FillBeta(e, alpha, beta);
+            simd.FillAlpha(e, M_::Null(), simdAlpha);
+            simd.FillBeta(e, simdAlpha, simdBeta);
+            for (int j = 0; j <= J; j++)
+            {
+                ASSERT_TRUE(alpha.UsedRowRange(j) == simdAlpha.UsedRowRange(j))
+                    << SimdTargetName(target) << " " << j;
+                ASSERT_TRUE(beta.UsedRowRange(j) == simdBeta.UsedRowRange(j))
+                    << SimdTargetName(target) << " " << j;
+                for (int i = 0; i <= I; i++)
+                {
+                    ASSERT_NEAR(alpha(i, j), simdAlpha(i, j), 1e-3)
+                        << SimdTargetName(target) << " " << i << " " << j;
+                    ASSERT_NEAR(beta(i, j), simdBeta(i, j), 1e-3)
+                        << SimdTargetName(target) << " " << i << " " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST(SimdTargetTest, AllTargetsAgree)
+{
+    BandingOptions bandings[] = { BandingOptions(4, 12), BandingOptions(4, 1e5),
+                                  BandingOptions(1, 12, 0.5, 4) };
+    int moveSets[] = { BASIC_MOVES, BASIC_MOVES | MERGE };
+    foreach (const BandingOptions& banding, bandings)
+    {
+        foreach (int moves, moveSets)
+        {
+            CheckSimdTargetsAgree<SseQvRecursor>(moves, banding);
+            CheckSimdTargetsAgree<SparseSseQvRecursor>(moves, banding);
+            CheckSimdTargetsAgree<SparseSseQvSumProductRecursor>(moves, banding);
+        }
+    }
+}
+
+TEST(SimdTargetTest, UnsupportedTargetThrows)
+{
+    SparseSseQvRecursor recursor(BASIC_MOVES, BandingOptions(4, 12));
+    EXPECT_EQ(BestSimdTarget(), recursor.Target());
+    recursor.Target(SSE3_TARGET);
+    EXPECT_EQ(SSE3_TARGET, recursor.Target());
+    if (!IsSimdTargetSupported(AVX512_TARGET))
+    {
+        EXPECT_THROW(recursor.Target(AVX512_TARGET), UnsupportedFeatureError);
+    }
+}
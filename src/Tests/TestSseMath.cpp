@@ -0,0 +1,94 @@
+// Copyright (c) 2011-2015, Pacific Biosciences of California, Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted (subject to the limitations in the
+// disclaimer below) provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//  * Neither the name of Pacific Biosciences nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE
+// GRANTED BY THIS LICENSE. THIS SOFTWARE IS PROVIDED BY PACIFIC
+// BIOSCIENCES AND ITS CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL PACIFIC BIOSCIENCES OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+// USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+// OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGE.
+
+// Author: David Alexander
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <ConsensusCore/Quiver/detail/SseMath.hpp>
+
+using namespace ConsensusCore::detail;  // NOLINT
+
+static double ReferenceLogAdd(double a, double b)
+{
+    double max = std::max(a, b), min = std::min(a, b);
+    return max + std::log(1.0 + std::exp(min - max));
+}
+
+TEST(SseMathTest, LogAddAccuracy)
+{
+    const float bases[] = { 0.0f, -3.7f, -250.0f, -12000.0f };
+    for (int b = 0; b < 4; b++)
+    {
+        for (int k = 0; k <= 25000; k++)
+        {
+            float x = bases[b];
+            float y = x - k * 0.001f;
+            double expected = ReferenceLogAdd(x, y);
+            // relative to the float spacing at the result
+            double tol = 2e-6 + 2 * FLT_EPSILON * std::fabs(expected);
+
+            float vector[4];
+            _mm_storeu_ps(vector, logAdd4(_mm_setr_ps(x, y, y, x),
+                                          _mm_setr_ps(y, x, x, y)));
+            for (int lane = 0; lane < 4; lane++)
+            {
+                ASSERT_NEAR(expected, vector[lane], tol) << x << " " << y;
+            }
+            // scalar and vector agree exactly
+            ASSERT_EQ(vector[0], logAdd(x, y)) << x << " " << y;
+            ASSERT_EQ(vector[1], logAdd(y, x)) << x << " " << y;
+        }
+    }
+}
+
+TEST(SseMathTest, LogAddOfUnreachable)
+{
+    EXPECT_EQ(-FLT_MAX, logAdd(-FLT_MAX, -FLT_MAX));
+    EXPECT_EQ(-2.5f, logAdd(-2.5f, -FLT_MAX));
+    EXPECT_EQ(-2.5f, logAdd(-FLT_MAX, -2.5f));
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, logAdd4(_mm_setr_ps(-FLT_MAX, -2.5f, -FLT_MAX, 0.0f),
+                                 _mm_setr_ps(-FLT_MAX, -FLT_MAX, -7.0f, -40.0f)));
+    EXPECT_EQ(-FLT_MAX, lanes[0]);
+    EXPECT_EQ(-2.5f, lanes[1]);
+    EXPECT_EQ(-7.0f, lanes[2]);
+    EXPECT_EQ(0.0f, lanes[3]);
+}